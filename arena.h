@@ -0,0 +1,98 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ==========================
+  = Scratch Arena (Layout) =  static RAM of the recorder slots and the categorizer buffers (cf. receiver.ino)
+  ==========================
+  (include radio_lib.h and categorizer.h first)
+
+  The layout follows from the memory profile (categorizer.h: MEMORY_PROFILE) and the number of slots (NS):
+  - recorder   : NS slots of NV_SLOT + 5 durations and WARM_UP + 1 strengths
+                 (LOG8_DURATIONS: 8-bit codes plus packed reliability bits, cf. durations.h)
+                 (COLLISION_SEPARATE: plus the packed transmitter tags of the HIGHs, cf. radio_lib.h)
+  - categorizer: uint16buf64, uint8buf32 and the packed trusted positions, used during categorizer() only
+  The static buffers of the categorizer (categories, single pass positions, category cache, protocol table) are kept
+  where they are, but counted by the budget check.
+  ARENA_BUDGET leaves 256 bytes of the 2 KB to the other globals, the serial buffers and the stack;
+  the sizes are printed by receiver.ino: setup (RAM report).
+*/
+
+// pipeline: recording and categorization of different slots
+#define NS                3              // number of recorded_signals slots (one is always recording, two hold a burst)
+#define NV_SLOT     (NV / NS)            // number of signal durations per slot
+
+#define DIM_R       ((NV_SLOT + 5 + 7) / 8)   // LOG8_DURATIONS: packed reliability bits per slot
+#define DIM_X       TRANSMITTER_DIM(NV_SLOT)  // COLLISION_SEPARATE: packed transmitter tags per slot
+
+typedef struct {
+  // recorder (first index = 1 = index of the first HIGH, position 0 is not used)
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  uint8_t  duration[NS][NV_SLOT + 5];   // 8-bit codes of the signal sequences (cf. durations.h)
+  uint8_t  reliability[NS][DIM_R];      // packed reliability bits of the signal sequences
+#else
+  uint16_t duration[NS][NV_SLOT + 5];   // signal sequences: [odd indices]: HIGH-durations, [even indices]: LOW-durations
+                                        // 2 records appended at the end plus 1 (unused position 0) gives 5
+#endif
+  byte     strength[NS][WARM_UP + 1];   // signal strengths of the first WARM_UP signals
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  uint8_t  transmitter[NS][DIM_X];      // transmitter tags of the HIGHs (cf. durations.h)
+#endif
+  // categorizer
+  uint16_t uint16buf64[DIM_64];         // uint16_t buffer
+  uint8_t  uint8buf32[DIM_32];          // uint8_t  buffer
+  uint8_t  trusted[DIM_T];              // packed trusted positions (1 bit per signal duration)
+} scratch_arena;
+
+// sizes [bytes] (ATmega328P: no padding)
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  #define ARENA_TAGS       (NS * DIM_X)
+#else
+  #define ARENA_TAGS       0
+#endif
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  #define ARENA_RECORDER   (NS * (NV_SLOT + 5 + DIM_R) + NS * (WARM_UP + 1) + ARENA_TAGS)
+#else
+  #define ARENA_RECORDER   (NS * (NV_SLOT + 5) * 2 + NS * (WARM_UP + 1) + ARENA_TAGS)
+#endif
+#define ARENA_CATEGORIZER  (DIM_64 * 2 + DIM_32 + DIM_T)
+#define ARENA_SIZE         (ARENA_RECORDER + ARENA_CATEGORIZER)
+// static buffers of the categorizer: duration_category[2], s_pos, category_cache, protocol_table
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+  #define CATEGORIES_SIZE  (8 + 12 * NC + 2 * NO + 2 * NA)
+#else
+  #define CATEGORIES_SIZE  (7 + 8 * NC + 2 * NO + 2 * NA)
+#endif
+#if (HISTOGRAM_MODE == SINGLE_PASS_HISTOGRAM)
+  #define S_POS_SIZE       (NV / 2)
+#else
+  #define S_POS_SIZE       0
+#endif
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  #define CACHE_SIZE       (NK * (7 + 12 * NC))
+#else
+  #define CACHE_SIZE       0
+#endif
+#if (CATEGORIZER_OUTPUT == BIT_OUTPUT)
+  #define PROTOCOL_SIZE    (NP * 12)
+#else
+  #define PROTOCOL_SIZE    0
+#endif
+#define CATEGORIZER_STATIC (2 * CATEGORIES_SIZE + S_POS_SIZE + CACHE_SIZE + PROTOCOL_SIZE)
+
+#define ARENA_BUDGET    1792    // arena plus static categorizer buffers [bytes]: check "RAM free" of the RAM report
+#if (ARENA_SIZE + CATEGORIZER_STATIC > ARENA_BUDGET)
+  #error "arena.h: the memory profile exceeds ARENA_BUDGET (choose a smaller MEMORY_PROFILE, or drop the single pass histogram / category cache)"
+#endif
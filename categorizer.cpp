@@ -1,6 +1,8 @@
 
 #include <Arduino.h>
 #include "categorizer.h"
+#include "profiler.h"
+#include "codec.h"
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 /*
@@ -16,6 +18,8 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
 
   ==================
   = 2. Categorizer =  categorization of "continuous" signal durations into discrete duration levels
@@ -24,6 +28,7 @@
   2.1 CLUSTERER: Histogram- & Post- Clustering
   2.1.1   Histogram-Clustering: based on histograms with adaptive bin sizes
   2.1.1.1 First Histogram Initialization
+          single pass: log-scaled bucket sort of the filtered values (HISTOGRAM_MODE)
   2.1.1.2 Histogram Loop
   2.1.1.2.1 Bin Filling: discard both untrusted values and border values
   2.1.1.2.2 Bin Clustering
@@ -33,6 +38,8 @@
   2.1.1.2.3 Outlier Sieving: collect the remaining values that could not be attributed to any cluster
   2.1.1.2.4 Next Histogram Initialization
   2.1.1.3 Test: Enumerate all Outliers
+  2.1.1'  Cached-Clustering: the clusters of a recent trace of the same channel replace the histograms (CATEGORY_CACHING)
+          classification of the trusted non-border values; few outliers are tolerated, otherwise histogram clustering
   2.1.2   Post-Clustering
   2.1.2.1 Border Processing: post-processing of the border values (discarded in histo-clustering)
   2.1.2.1.1 border values classification: if the classification fails, the value becomes an outlier
@@ -61,6 +68,37 @@
           triplets comprising macro spikes or macro drops are resorbed:
           3 consecutive values are reduced to 1 value, followed by 2 zero durations
 
+  2.3 STREAM CLASSIFIER: on the fly classification of continuously received values (cf. recorder streaming)
+          the categories learned from a first window are reused for every following value;
+          a re-clustering is requested when the outlier rate of a window rises (STREAM_OUTLIERS per STREAM_WINDOW)
+
+  2.4 FRAME MERGER: output of each distinct frame once with its repeat count (CATEGORIZER_OUTPUT == FRAME_OUTPUT)
+          the categorized sequence is split at the separator barrier (and FRAME_GAP) gaps; repeats (same length, at most
+          FRAME_TOLERANCE certain mismatches) are merged by a majority vote per position
+  2.4.1   frame_mismatches: compare two frames position by position
+  2.4.2   frame_vote: majority vote per position (correction of residual "?" and "!" marks)
+  2.4.3   frame_splitter: split the corrected sequence into frames (separator barrier and FRAME_GAP gaps)
+
+  2.5 PROTOCOL DECODER: bit payload of each frame (CATEGORIZER_OUTPUT == BIT_OUTPUT)
+          the encoding (PWM, PPM, Manchester) is recognized from the data levels; a table of NP learned
+          signatures decodes a recurring device by a lookup, an analysis is only done on a miss
+  2.5.1   protocol_analyzer: recognize the encoding and its data levels from the categories
+  2.5.2   protocol_level: data level of a value (short, long, none)
+  2.5.3   frame_bits: decode the next data run of a frame into packed bits (most significant bit first)
+
+  2.6 PRE-SCREEN: prediction of unclusterable traces (noise) before the trace is reported and categorized (PRESCREEN_MODE)
+          a coarse histogram per level (half octaves) and the unreliable ratio: a continuum of populated bins is noise
+
+  2.7 SEPARATOR: one sub-sequence per transmitter of a collided trace (radio_lib.h: COLLISION_SEPARATE)
+          the HIGHs are tagged by the recorder with their strength bucket; the pairs (HIGH, LOW) of each transmitter
+          are gathered, the LOWs extended up to the next HIGH of the same transmitter, then categorized separately
+  2.7.1   sequence_reverse: reverse a range of values in place (rotation of the pairs)
+  2.7.2   separator_shift: move the second sub-sequence to the front
+
+  2.8 CATEGORIZER PRINTER: optional consumer of a successful categorization (categorizer() itself prints nothing)
+          the printed output of CATEGORIZER_OUTPUT; RESULT_OUTPUT: none, the caller builds the structured result,
+          one code per position in place of the durations (categorizer_lib.cpp: 3.5.3 result_builder)
+
 Trace driven Categorizer of OOK-Signals
 =======================================
 given     : a pulse sequence "TRACE" of alternating signal-HIGH and signal-LOW durations
@@ -130,20 +168,76 @@ cluster robustness is enforced by the following measures:
 
 */
 
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+// category cache: clusters of the recent traces (repeated transmissions of the same devices)
+THREAD_LOCAL cache_entry category_cache[NK];
+THREAD_LOCAL cache_stats cache_counters;
+
+bool same_signature (   //     returns true, if the entry holds the same clusters (channel key, number of clusters, rounded centers)
+  cache_entry &e,       // I   cache entry
+  categories   z[],     // I   categories of the current trace
+  uint32_t     key      // I   channel key of the current trace
+) {
+  uint8_t level;        // HIGH / LOW
+  uint8_t c_ind;        // index of cluster
+
+  if (e.key != key) return (false);
+  for (level= LOW; level <= HIGH; level++) {
+    if (e.level[level].cluster_size != z[level].cluster_size) return (false);
+    for (c_ind= 0; c_ind < z[level].cluster_size; c_ind++) {
+      if ((e.level[level].cluster_center[c_ind] >> CACHE_ROUNDING) != (z[level].cluster_center[c_ind] >> CACHE_ROUNDING)) return (false);
+    }
+  }
+  return (true);
+}
+#endif
+
 int8_t categorizer (                  // return code
   categories z[],                     // O  categories of raw data values  ([1]: HIGH-durations categories, [0]: LOW-durations categories)
-  uint16_t   signal_duration[],       // IO signal sequence: [even indices]: HIGH-durations, [odd indices]: LOW-durations
+  duration_seq signal_duration,       // IO signal sequence: [even indices]: HIGH-durations, [odd indices]: LOW-durations
   uint16_t   sequence_length,         // I  total number of signal durations: number of HIGH- plus LOW-durations
   uint16_t   unreliable_count,        // I  number of received unreliable (flagged) values contained in the signal sequence
+  uint32_t   cache_key,               // I  channel key of the trace (CACHE_KEY; ignored without CATEGORY_CACHE)
+  const categorizer_parameters &cp,   // I  categorizer parameters (FIXED_PARAMETERS: not read, cf. CP)
   uint8_t    &return_code,            // O  return_code
   uint8_t    uint8buf32[],            // X uint8_t  buffer
-  uint16_t   uint16buf64[]            // X uint16_t buffer
+  uint16_t   uint16buf64[],           // X uint16_t buffer
+  uint8_t    trusted[]                // X packed trusted positions (DIM_T)
 ) {
 
   uint16_t sequence_start_ind;        // start index of signal_duration
   uint16_t sequence_stop_ind;         // stop  index of signal_duration
   bool     cluster_overlap;           // true, if at least one overlap between clusters has been detected
   cluster_overlap= false;
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  uint8_t  k_ind;                     // index of category_cache (NK: cache miss)
+  uint8_t  e_ind;                     // index of category_cache
+#endif
+
+  STAGE_MARK(STAGE_CLUSTERER);
+  // trusted positions: computed once, used by the clusterer (histograms, border processing) and the extractor
+  trusted_mask (signal_duration, sequence_length, trusted);
+
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  // category cache: classification against the clusters of recent traces of the same channel
+  // both levels must fit the clusters of the same entry, otherwise the histogram clustering follows
+  for (k_ind= 0; k_ind < NK; k_ind++) {
+    if (category_cache[k_ind].level[HIGH].cluster_size == 0) continue;
+    if (category_cache[k_ind].key != cache_key) continue;
+    clusterer (z[HIGH], signal_duration, 2 - HIGH, sequence_length - HIGH, &category_cache[k_ind].level[HIGH],
+               cp, cluster_overlap, return_code, uint8buf32, uint16buf64, trusted);
+    if (return_code != CRC_0) continue;
+    clusterer (z[LOW], signal_duration, 2 - LOW, sequence_length - LOW, &category_cache[k_ind].level[LOW],
+               cp, cluster_overlap, return_code, uint8buf32, uint16buf64, trusted);
+    if (return_code == CRC_0) break;
+  }
+  return_code= CRC_0;
+  if (k_ind < NK) {
+    cache_counters.hit_count++;
+    goto ERROR_CORRECTION;
+  }
+  cache_counters.miss_count++;
+#endif
 
 /*PP
   _psln(F(""));
@@ -159,10 +253,13 @@ int8_t categorizer (                  // return code
     signal_duration,     // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
     sequence_start_ind,  // I  start index of signal_duration
     sequence_stop_ind,   // I  stop  index of signal_duration
+    NULL,                // I  no cached clusters: histogram clustering
+    cp,                  // I  categorizer parameters
     cluster_overlap,     // O  true, if at least one overlap between clusters has been detected
     return_code,         // O  return_code  (CRC_0: no error)
     uint8buf32,
-    uint16buf64
+    uint16buf64,
+    trusted
   );
   if (return_code != CRC_0) return (return_code);
 /*PP
@@ -170,6 +267,7 @@ int8_t categorizer (                  // return code
   statistics (
     z[HIGH],             // I  signal_duration categories
     signal_duration,     // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+    trusted,             // I  packed trusted positions
     sequence_start_ind,  // I  start index of signal_duration
     sequence_stop_ind    // I  stop  index of signal_duration
   );
@@ -188,10 +286,13 @@ int8_t categorizer (                  // return code
     signal_duration,     // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
     sequence_start_ind,  // I  start index of signal_duration
     sequence_stop_ind,   // I  stop  index of signal_duration
+    NULL,                // I  no cached clusters: histogram clustering
+    cp,                  // I  categorizer parameters
     cluster_overlap,     // O  true, if at least one overlap between clusters has been detected
     return_code,         // O  return_code  (CRC_0: no error)
     uint8buf32,
-    uint16buf64
+    uint16buf64,
+    trusted
   );
   if (return_code != CRC_0) return (return_code);
 /*PP
@@ -199,10 +300,14 @@ int8_t categorizer (                  // return code
   statistics (
     z[LOW],              // I  signal_duration categories
     signal_duration,     // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+    trusted,             // I  packed trusted positions
     sequence_start_ind,  // I  start index of signal_duration
     sequence_stop_ind    // I  stop  index of signal_duration
   );
 */
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+ERROR_CORRECTION:
+#endif
 /*PP
   _psln(F(""));
   _psln(F("Error Correction"));
@@ -214,11 +319,39 @@ int8_t categorizer (                  // return code
       signal_duration,      // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
       sequence_length,      // I  number of signal durations: HIGH- plus LOW- durations without end markers
       unreliable_count,     // I  number of received unreliable (flagged) values contained in the signal sequence
+      cp,                   // I  categorizer parameters
       return_code,          // O  return_code  (CRC_0: no error)
-      uint16buf64
+      uint16buf64,
+      trusted               // I  packed trusted positions
     );
     if (return_code != CRC_0) return (return_code);
   }
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  // category cache update
+  // a hit renews its entry; a miss replaces the entry of the same signature, otherwise the oldest entry
+  for (e_ind= 0; e_ind < NK; e_ind++) {
+    if (category_cache[e_ind].age < 255) category_cache[e_ind].age++;
+  }
+  if (k_ind == NK) {
+    for (k_ind= 0; k_ind < NK; k_ind++) {
+      if (same_signature (category_cache[k_ind], z, cache_key)) break;
+    }
+    if (k_ind == NK) {
+      k_ind= 0;
+      for (e_ind= 1; e_ind < NK; e_ind++) {
+        if (category_cache[e_ind].age > category_cache[k_ind].age) k_ind= e_ind;
+      }
+    }
+    category_cache[k_ind].key= cache_key;
+    for (e_ind= LOW; e_ind <= HIGH; e_ind++) {
+      category_cache[k_ind].level[e_ind].cluster_size= z[e_ind].cluster_size;
+      memcpy(category_cache[k_ind].level[e_ind].cluster_ceil,   z[e_ind].cluster_ceil,   sizeof(z[e_ind].cluster_ceil));
+      memcpy(category_cache[k_ind].level[e_ind].cluster_center, z[e_ind].cluster_center, sizeof(z[e_ind].cluster_center));
+      memcpy(category_cache[k_ind].level[e_ind].cluster_floor,  z[e_ind].cluster_floor,  sizeof(z[e_ind].cluster_floor));
+    }
+  }
+  category_cache[k_ind].age= 0;
+#endif
 /*PP
   _psln(F(""));
   _psln(F("HIGH-Value Categories"));
@@ -229,11 +362,7 @@ int8_t categorizer (                  // return code
   _psln(F("===================="));
   category_printer (z[LOW], signal_duration);
 */
-  // duration_category
-  _psln(F(""));
-  _psln(F("Categorized Sequence"));
-  //P _psln(F("===================="));
-  sequence_printer (z, signal_duration, sequence_length);
+  // duration_category: no output, the consumers follow (categorizer_printer, result_builder)
   return (CRC_0);
 
 } // end categorizer
@@ -242,16 +371,43 @@ int8_t categorizer (                  // return code
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+#if (HISTOGRAM_MODE == SINGLE_PASS_HISTOGRAM)
+// filtered values of the current sequence level, sorted by log-scaled bucket (within a bucket: in sequence order)
+// position s_pos[s_ind] represents v[v_start_ind + 2 * s_pos[s_ind]]
+THREAD_LOCAL uint8_t s_pos[NV / 2];
+#define HIT_FREE   0xFFFF   // single pass: bin not yet hit by the current histogram (h_hit_ind[2 * b_ind])
+#define HIT_NONE   0        // single pass: no (further) first hit to record in the bin
+
+// log-scaled bucket of a value: 2log (octave) plus 2 mantissa bits (< NL), i.e. 4 * shifts + (v_val >> shifts),
+// where v_val >> shifts < 8 (the shifts are found by halving: 8, 4, 2, 1, 1)
+inline uint8_t s_bucket (uint16_t v_val) {
+  uint8_t l_ind= 0;
+  if (v_val >= (8 << 8)) {v_val>>= 8; l_ind= 32;}
+  if (v_val >= (8 << 4)) {v_val>>= 4; l_ind+= 16;}
+  if (v_val >= (8 << 2)) {v_val>>= 2; l_ind+= 8;}
+  if (v_val >= (8 << 1)) {v_val>>= 1; l_ind+= 4;}
+  if (v_val >= 8)        {v_val>>= 1; l_ind+= 4;}
+  return (l_ind + v_val);
+}
+// lowest value of a bucket (l_ind <= NL)
+inline uint32_t s_bucket_floor (uint8_t l_ind) {
+  return ((l_ind < 8) ? l_ind : (uint32_t)(4 + (l_ind & 3)) << ((l_ind >> 2) - 1));
+}
+#endif
+
 void clusterer (
   categories &z,          // O   result of clustering process (categories of either HIGH- (z[HIGH]) or LOW- durations (z[LOW]))
-  uint16_t v[],           // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  duration_seq v,         // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
   uint16_t v_start_ind,   // I   start index of v[] (included)
   uint16_t v_stop_ind,    // I   stop  index of v[] (included)
+  cluster_set *cached,    // I   clusters of a category cache entry (NULL: histogram clustering)
+  const categorizer_parameters &cp,  // I   categorizer parameters (CP)
   bool    &overlap_flag,  // O   true, if at least one overlap between clusters has been detected
   uint8_t &rc,            // O   return_code (0: no error)
   uint8_t  bin_count[],   // X   buffer: bin frequentation: number of values encountered in the range of the bin [b_ind] (0: empty; >0: occupied)
-  uint16_t h_hit_ind[]    // X   buffer: - indices of those values that are the first to hit an empty / sparsely populated bin (h_count)
+  uint16_t h_hit_ind[],   // X   buffer: - indices of those values that are the first to hit an empty / sparsely populated bin (h_count)
                           //             - with removed indices that are related to densely populated bins (h_count_2; -> outlier)
+  uint8_t  trusted[]      // I   packed trusted positions (cf. trusted_mask)
 ) {
 
   // ************* //
@@ -271,6 +427,7 @@ void clusterer (
   //           collect the remaining values that could not be attributed to any cluster
   // 2.1.1.2.4 Next Histogram Initialization
   // 2.1.1.3 Test: Enumerate all Outliers
+  // 2.1.1'  Cached-Clustering (cached != NULL): classification against the cached clusters replaces 2.1.1
 
   // 2.1.2   Post-Clustering
   // 2.1.2.1 Border Processing: post-processing of the border values (discarded in histo-clustering)
@@ -302,7 +459,7 @@ void clusterer (
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-{
+if (cached == NULL) {
   // +++++++++++++++++++++++++++ //
   // 2.1.1  Histogram-Clustering //  production of clusters & outliers
   // +++++++++++++++++++++++++++ //
@@ -348,10 +505,24 @@ void clusterer (
 
   bool outlier_presence_flag; // true, if the histogram contains at least one outlier
   bool ascending;             // used for overlap detection
+#if (HISTOGRAM_MODE == SINGLE_PASS_HISTOGRAM)
+  // single pass: bucket-sorted filtered values
+  uint16_t s_size;            // number of filtered values in s_pos[]
+  uint16_t s_ind;             // index of s_pos[]
+  uint16_t s_low;             // binary search
+  uint16_t s_high;
+  uint32_t s_bound;           // lowest value of a bucket
+  uint8_t  b_top;             // number of bins up to the highest bin hit (slots of h_hit_ind[] to reset / collect)
+  uint8_t  l_ind;             // index of log-scaled bucket
+  uint16_t v_max_ind;         // highest index of the values in the current histogram range
+#endif
 
   rc= CRC_0;
   // initialize cluster
   z.cluster_size=   0;
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+  z.lookup_size=    0;
+#endif
   z.aggreg_size_1=  0;
   z.aggreg_size_2=  0;
   z.outlier_size=   0;
@@ -361,7 +532,7 @@ void clusterer (
   // 2.1.1.1 First Histogram Initialization
   // **************************************
   // initialize first bottom value
-  h_next_floor= START_VAL;
+  h_next_floor= CP(cp, start_val);
   // initialize bin size of histogram: BOTH bin_width AND corresponding 2log
   bin_width_2log= 4;
   bin_width= 1 << bin_width_2log;
@@ -370,10 +541,41 @@ void clusterer (
     bin_count[b_ind]= 0;
   }
 
+#if (HISTOGRAM_MODE == SINGLE_PASS_HISTOGRAM)
+  // single pass: log-scaled bucket sort of the filtered values
+  // ===========
+  // bucket l_ind (s_bucket): 2log of the value (octave) plus 2 mantissa bits, i.e. bins proportional to the value
+  // all histograms are filled from s_pos[], the sequence is scanned once (twice for the bucket sort);
+  // the positions stay in sequence order within their bucket: no sort, a histogram folds its bins
+  // from the buckets covering its value range (cf. bin filling)
+  // h_hit_ind[] is used as bucket counter (the histogram loop has not yet started)
+  for (l_ind= 0; l_ind < NL; l_ind++) h_hit_ind[l_ind]= 0;
+  for (v_ind= v_start_ind + CP(cp, border_width); v_ind <= v_stop_ind - CP(cp, border_width); v_ind+= 2) {
+    // same filter as in the bin filling
+    if (!TRUSTED(trusted, v_ind)) continue;
+    h_hit_ind[s_bucket(v[v_ind])]++;
+  }
+  // bucket start positions
+  s_size= 0;
+  for (l_ind= 0; l_ind < NL; l_ind++) {
+    s_ind= h_hit_ind[l_ind];
+    h_hit_ind[l_ind]= s_size;
+    s_size+= s_ind;
+  }
+  // distribute the positions in sequence order
+  for (v_ind= v_start_ind + CP(cp, border_width); v_ind <= v_stop_ind - CP(cp, border_width); v_ind+= 2) {
+    if (!TRUSTED(trusted, v_ind)) continue;
+    s_pos[h_hit_ind[s_bucket(v[v_ind])]++]= (v_ind - v_start_ind) >> 1;
+  }
+  // the first histogram resets all slots of h_hit_ind[] (bucket counters)
+  b_top= NB;
+#endif
+
   // 2.1.1.2 Histogram Loop
   // **********************
   // begin histogram main loop
   while (true) {
+    STAGE_MARK(STAGE_HISTOGRAM);
     // presence of at least one outlier in this histogram
     outlier_presence_flag= false;
     // histogram bin width
@@ -407,24 +609,19 @@ void clusterer (
 
     // 2.1.1.2.1 Bin Filling: discard both untrusted values and border values
     // =====================
+#if (HISTOGRAM_MODE == MULTI_PASS_HISTOGRAM)
     // begin bin-filling (sequence scan, border values excluded)
     v_count= 0;
     // reset h_count: number of elements in h_hit_ind[]
     h_count= 0;
     // scan the trace between warm-up and cool-down
-    for (v_ind= v_start_ind + BORDER_WIDTH; v_ind <= v_stop_ind - BORDER_WIDTH; v_ind+= 2) {
+    for (v_ind= v_start_ind + CP(cp, border_width); v_ind <= v_stop_ind - CP(cp, border_width); v_ind+= 2) {
       // current value
       v_val= v[v_ind];
       // check range: floor value
       if (v_val <  h_floor_val) continue;
-      // begin filter: check immediate neighborhood for unreliable values
-        // - current element
-        if ((v[v_ind]     & LSB) == UNRELIABLE) continue;
-        // - element in front the current element
-        if ((v[v_ind + 1] & LSB) == UNRELIABLE) continue;
-        // - element at the back of the current element
-        if ((v[v_ind - 1] & LSB) == UNRELIABLE) continue;
-      // end filter
+      // filter: value and immediate neighborhood reliable (trusted position)
+      if (!TRUSTED(trusted, v_ind)) continue;
       // check range: ceil value
       // and determine floor of next round (after filter !!!)
       if (v_val >= h_ceil_val) {
@@ -446,7 +643,7 @@ void clusterer (
       bin_count[b_ind]++;
       // record the first FIRST_HITS (indices of those values that first hit the bin)
       if (h_count < NH) {
-        if (bin_count[b_ind] <= FIRST_HITS) h_hit_ind[h_count++]= v_ind;
+        if (bin_count[b_ind] <= CP(cp, first_hits)) h_hit_ind[h_count++]= v_ind;
       } else {
         // does not occur if NH >= 2*NB
         //E _ps(F("too many hits in histogram !!!"));_ps("\t");_pdln(h_count);
@@ -454,6 +651,87 @@ void clusterer (
         return;
       }
     }
+#else
+    // begin bin-filling (single pass: the buckets covering [h_floor_val, h_ceil_val), in sequence order per bucket)
+    // the first hits of a bin are the values with the smallest indices (sequence order of the multi-pass scan):
+    // h_hit_ind[2 * b_ind], h_hit_ind[2 * b_ind + 1] hold the two smallest indices of bin b_ind (NH = 2 * NB),
+    // HIT_FREE: not yet hit, HIT_NONE: not to record (population left by the previous histogram), CEIL_U: none yet
+    v_count= 0;
+    h_count= 0;
+    v_max_ind= 0;
+    // reset the slots of the bins up to the highest bin hit by the previous histogram (the hits are collected below it)
+    for (h_ind= 0; h_ind < 2 * b_top; h_ind++) h_hit_ind[h_ind]= HIT_FREE;
+    b_top= 0;
+    // first position of the bucket of h_floor_val (binary search: the buckets are in value order)
+    s_bound= s_bucket_floor(s_bucket(h_floor_val));
+    s_low= 0;
+    s_high= s_size;
+    while (s_low < s_high) {
+      s_ind= (s_low + s_high) >> 1;
+      if (v[v_start_ind + 2 * s_pos[s_ind]] < s_bound) s_low= s_ind + 1;
+      else s_high= s_ind;
+    }
+    // up to the last position of the bucket of h_ceil_val - 1
+    s_bound= s_bucket_floor(s_bucket(h_ceil_val - 1) + 1);
+    for (s_ind= s_low; s_ind < s_size; s_ind++) {
+      v_ind= v_start_ind + 2 * s_pos[s_ind];
+      v_val= v[v_ind];
+      if (v_val >= s_bound) break;
+      // check range: floor value
+      if (v_val < h_floor_val) continue;
+      // check range: ceil value
+      if (v_val >= h_ceil_val) {
+        // floor value of next histogram = lowest filtered value above the current ceil value
+        if (v_val < h_next_floor) h_next_floor= v_val;
+        continue;
+      }
+      v_count++;
+      if (v_ind > v_max_ind) v_max_ind= v_ind;
+      // map value to bin
+      b_ind= (v_val - h_floor_val) >> bin_width_2log;
+      if (b_ind >= NB) {
+        //E _psln(F("histogram bin range error (should never occur !!!)"));
+        rc= CRC_10;
+        return;
+      }
+      if (b_ind >= b_top) b_top= b_ind + 1;
+      // first hits (FIRST_HITS <= 2), counting the population left by the previous histogram
+      h_ind= 2 * b_ind;
+      if (h_hit_ind[h_ind] == HIT_FREE) {
+        h_hit_ind[h_ind]=     (bin_count[b_ind] + 1 <= CP(cp, first_hits)) ? CEIL_U : HIT_NONE;
+        h_hit_ind[h_ind + 1]= (bin_count[b_ind] + 2 <= CP(cp, first_hits)) ? CEIL_U : HIT_NONE;
+      }
+      if (v_ind < h_hit_ind[h_ind]) {
+        if (h_hit_ind[h_ind + 1] != HIT_NONE) h_hit_ind[h_ind + 1]= h_hit_ind[h_ind];
+        h_hit_ind[h_ind]= v_ind;
+      } else
+      if (v_ind < h_hit_ind[h_ind + 1]) h_hit_ind[h_ind + 1]= v_ind;
+      // maximum population per bin = 255 (size of byte)
+      if (bin_count[b_ind] >= 255) continue;
+      bin_count[b_ind]++;
+    }
+    if ((h_next_floor == CEIL_U) && (s_ind < s_size)) {
+      // the next floor is the lowest value of the next populated bucket
+      s_bound= s_bucket_floor(s_bucket(v[v_start_ind + 2 * s_pos[s_ind]]) + 1);
+      for (; s_ind < s_size; s_ind++) {
+        v_val= v[v_start_ind + 2 * s_pos[s_ind]];
+        if (v_val >= s_bound) break;
+        if (v_val < h_next_floor) h_next_floor= v_val;
+      }
+    }
+    // collect the first hits of the bins (in place: h_count <= h_ind), a hit is in [1, CEIL_U)
+    for (h_ind= 0; h_ind < 2 * b_top; h_ind++) {
+      if ((uint16_t)(h_hit_ind[h_ind] - 1) < CEIL_U - 1) h_hit_ind[h_count++]= h_hit_ind[h_ind];
+    }
+    // hits in sequence order
+    sort(h_hit_ind, h_count);
+    if ((h_count >= NH) && (v_max_ind > h_hit_ind[NH - 1])) {
+      // a value in range follows the last recordable hit (cf. multi-pass)
+      //E _ps(F("too many hits in histogram !!!"));_ps("\t");_pdln(h_count);
+      rc= CRC_6;
+      return;
+    }
+#endif
     // end bin-filling
     // ---------------
     // _ps(F("h_count="));_ps("\t");_pdln(h_count);
@@ -515,9 +793,9 @@ void clusterer (
           c_hole_count= 0;
         } else {
           // number of consecutive empty bins > MAX_HOLES ?
-          if (++c_hole_count > MAX_HOLES) {
+          if (++c_hole_count > CP(cp, max_holes)) {
             // set stop bin
-            bin_stop_ind= b_ind - MAX_HOLES;
+            bin_stop_ind= b_ind - CP(cp, max_holes);
             break;
           }
         }
@@ -606,7 +884,7 @@ void clusterer (
       }
 
       // check number of elements in cluster
-      if (c_count < MIN_SIZE) {
+      if (c_count < CP(cp, min_size)) {
         // low density clusters contain less than three elements
         // these bins are not emptied -> outlier
         //P _ps(F("low density cluster: "));_ps("\t");_pdln(c_count);
@@ -705,6 +983,7 @@ void clusterer (
   }
   // end histogram main loop
   // ***********************
+  STAGE_MARK(STAGE_CLUSTERER);
 
   // number of clusters
   z.cluster_size= c_ind;
@@ -713,22 +992,19 @@ void clusterer (
     rc= CRC_7;
     return;
   }
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+  // the clusters are final: value ranges of the cluster matches (border processing, corrector, printers)
+  lookup_builder (z, C_OPT_3);
+#endif
 
 /*
 // begin test  ------------------------------------------------------------------------------------------------------------------------------------------------------
   h_count= 0;  // number of outliers
-  for (v_ind= v_start_ind + BORDER_WIDTH; v_ind <= v_stop_ind - BORDER_WIDTH; v_ind+= 2) {
+  for (v_ind= v_start_ind + CP(cp, border_width); v_ind <= v_stop_ind - CP(cp, border_width); v_ind+= 2) {
     // current value
     v_val= v[v_ind];
-    // begin filter: check immediate neighborhood for unreliable values
-      // filter: check immediate neighborhood for unreliable values
-      // - element in front the current element
-      if ((v_ind < v_stop_ind) && ((v[v_ind + 1] & LSB) == UNRELIABLE)) continue;
-      // - current element
-      if (((v[v_ind  ] & LSB) == UNRELIABLE)) continue;
-      // - element at the back of the current element
-      if ((v_ind > v_start_ind) && ((v[v_ind - 1] & LSB) == UNRELIABLE)) continue;
-    // end filter: check immediate neighborhood for unreliable values
+    // filter: value and immediate neighborhood reliable (trusted position)
+    if (!TRUSTED(trusted, v_ind)) continue;
     // check whether the current value belongs to a cluster
     if (!classifier (z, v_val, c_ind, c_center, C_OPT_4)) {
       // _ps(F("TEST: "));_ps(_cT);_pd(v_ind);_ps(_cT);_pdln(v_val);
@@ -745,6 +1021,56 @@ void clusterer (
 // end test  --------------------------------------------------------------------------------------------------------------------------------------------------------
 */
 
+} else {
+  // ++++++++++++++++++++++++ //
+  // 2.1.1' Cached-Clustering //  clusters of a previous trace (category cache), production of outliers
+  // ++++++++++++++++++++++++ //
+  // the trusted, non-border values are classified against the cached clusters (same filter as the bin filling);
+  // the trace does not fit (rc= CRC_9), if it produces more than CACHE_OUTLIERS outliers
+  // or if a cached cluster would contain less than MIN_SIZE values
+
+  uint8_t  c_ind;             // index of cluster
+  uint16_t c_center;          // cluster mean value
+  uint16_t v_ind;             // index of current value
+
+  rc= CRC_0;
+  // initialize cluster
+  z.cluster_size=   cached->cluster_size;
+  z.aggreg_size_1=  0;
+  z.aggreg_size_2=  0;
+  z.outlier_size=   0;
+  z.inlier_count=   0;
+  for (c_ind= 0; c_ind < z.cluster_size; c_ind++) {
+    z.cluster_count[c_ind]=  0;
+    z.cluster_ceil[c_ind]=   cached->cluster_ceil[c_ind];
+    z.cluster_center[c_ind]= cached->cluster_center[c_ind];
+    z.cluster_floor[c_ind]=  cached->cluster_floor[c_ind];
+  }
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+  lookup_builder (z, C_OPT_3);
+#endif
+
+  for (v_ind= v_start_ind + CP(cp, border_width); v_ind <= v_stop_ind - CP(cp, border_width); v_ind+= 2) {
+    // filter: value and immediate neighborhood reliable (trusted position)
+    if (!TRUSTED(trusted, v_ind)) continue;
+    // !!! use the same C_OPT as in sequence printer !!!
+    if (classifier (z, v[v_ind], c_ind, c_center, C_OPT_3)) {
+      z.cluster_count[c_ind]++;
+    } else {
+      if (z.outlier_size >= CACHE_OUTLIERS) {
+        rc= CRC_9;
+        return;
+      }
+      z.outlier_ind[z.outlier_size++]= v_ind;
+    }
+  }
+  for (c_ind= 0; c_ind < z.cluster_size; c_ind++) {
+    if (z.cluster_count[c_ind] < CP(cp, min_size)) {
+      rc= CRC_9;
+      return;
+    }
+  }
+
 }
 // END Histogram-Clustering
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -792,18 +1118,12 @@ void clusterer (
   // (trusted values above the separator_barrier will also be included)
   for (v_ind= v_start_ind; v_ind <= v_stop_ind; v_ind+= 2) {
     // !!! => skip values between borders <=  !!!
-    if (v_ind == v_start_ind + BORDER_WIDTH) v_ind= v_stop_ind - BORDER_WIDTH + 2;
+    if (v_ind == v_start_ind + CP(cp, border_width)) v_ind= v_stop_ind - CP(cp, border_width) + 2;
 
     // current value
     v_val= v[v_ind];
-    // begin filter: check immediate neighborhood for unreliable values
-      // - current element
-      if (((v[v_ind] & LSB) == UNRELIABLE)) continue;
-      // - element in front the current element
-      if ((v_ind < v_stop_ind)  && ((v[v_ind + 1] & LSB) == UNRELIABLE)) continue;
-      // - element at the back of the current element
-      if ((v_ind > v_start_ind) && ((v[v_ind - 1] & LSB) == UNRELIABLE)) continue;
-    // end filter: check immediate neighborhood for unreliable values
+    // filter: value and immediate neighborhood reliable (trusted position, the sequence ends are without outer neighbor)
+    if (!TRUSTED(trusted, v_ind)) continue;
 
     // check whether the current value belongs to a cluster
     // !!! use the same C_OPT as in sequence printer !!!
@@ -845,7 +1165,7 @@ void clusterer (
   // L1 aggregs are clusters found after clustering because of the border zones
 
   // use same MIN_SIZE= 3 as in clustering
-  aggregator (z, v, MIN_SIZE, rc);   // (L1 aggreg)
+  aggregator (z, v, CP(cp, min_size), rc);   // (L1 aggreg)
   z.aggreg_size_1= z.aggreg_size_2;
   if (rc > CRC_0) return;
   // eliminate aggregated outliers
@@ -909,11 +1229,13 @@ void clusterer (
 
 void corrector (
   categories z[],             // IO   result of clustering process (categories of 1: HIGH- and 2: LOW- durations)
-  uint16_t v[],               // IO   flagged raw data value sequence: [odd indices]: HIGH-durations, [even indices]: LOW-durations
+  duration_seq v,             // IO   flagged raw data value sequence: [odd indices]: HIGH-durations, [even indices]: LOW-durations
   uint16_t v_length,          // I    number of signal durations: HIGH- plus LOW- durations (without end markers)
   uint16_t unreliable_count,  // I    number of unreliable values in the sequence
+  const categorizer_parameters &cp,  // I    categorizer parameters (CP)
   uint8_t &rc,                // O    return_code (0: no error)
-  uint16_t m_outlier_ind[]    // X    buffer: merged outliers (merged HIGH- and LOW- outliers)
+  uint16_t m_outlier_ind[],   // X    buffer: merged outliers (merged HIGH- and LOW- outliers)
+  uint8_t  trusted[]          // I    packed trusted positions (cf. trusted_mask): fast scan of the extractor
 ) {
 
   // ************* //
@@ -948,6 +1270,7 @@ void corrector (
   }
   v_start_ind= 1;
   v_stop_ind=  v_length;
+  STAGE_MARK(STAGE_OUTLIERS);
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -1037,18 +1360,18 @@ void corrector (
       // preceding value
       prev_v_ind= curr_v_ind - 1;
       if (prev_v_ind >= v_start_ind) {
-        flag= classifier (z[prev_v_ind & LSB], v[prev_v_ind], cat_ind, prev_center, C_OPT_2);
+        flag= classifier (z[prev_v_ind & LSB], v[prev_v_ind], cat_ind, prev_center, CP(cp, outlier_option));
         t_center_sum+= prev_center;
         v_sum+= v[prev_v_ind];
       }
       // following value
       next_v_ind= curr_v_ind + 1;
       if (next_v_ind <= v_stop_ind) {
-        flag= classifier (z[next_v_ind & LSB], v[next_v_ind], cat_ind, next_center, C_OPT_2) && flag;
+        flag= classifier (z[next_v_ind & LSB], v[next_v_ind], cat_ind, next_center, CP(cp, outlier_option)) && flag;
         t_center_sum+= next_center;
         v_sum+= v[next_v_ind];
       }
-      flag= classifier (z[curr_v_ind & LSB], v[curr_v_ind], cat_ind, curr_center, C_OPT_2) || flag;
+      flag= classifier (z[curr_v_ind & LSB], v[curr_v_ind], cat_ind, curr_center, CP(cp, outlier_option)) || flag;
       // flag is true,  if the current outlier is classifiable OR both neighbors are classifiable
 
       // resistant outlier:
@@ -1083,7 +1406,7 @@ void corrector (
       m_outlier_ind[m_ind]= 0;
 
       // check if the preceding value is also an outlier
-      if (m_outlier_ind[m_ind - 1] == prev_v_ind) {
+      if ((m_ind > 0) && (m_outlier_ind[m_ind - 1] == prev_v_ind)) {
         v[prev_v_ind]= prev_center;
         // adjacent: corrected outlier elimination
         // ---------------------------------------
@@ -1140,6 +1463,7 @@ void corrector (
   //         3 consecutive values are reduced to 1 value, followed by 2 zero durations
 
   // apart from untrusted top-outliers, there will be no new category
+  STAGE_MARK(STAGE_SUBSEQUENCES);
 
   if (rc > CRC_0) return;
   if (unreliable_count > 0) {
@@ -1161,12 +1485,12 @@ void corrector (
     uint16_t rel_delta_max;   // maximum relative delta during correction (trustworthiness of the final result)
     bool flag;
 
-    extractor_ind= v_start_ind + BORDER_WIDTH;
+    extractor_ind= v_start_ind + CP(cp, border_width);
     rel_delta_max= 0;
 
     // extract the next untrusted subsequence
     // --------------------------------------
-    while (extractor (v, v_stop_ind, extractor_ind, ss_start_ind, ss_stop_ind)) {
+    while (extractor (v, trusted, v_stop_ind, extractor_ind, ss_start_ind, ss_stop_ind)) {
       _ps(F("indices :"));
       for (v_ind= ss_start_ind; v_ind <= ss_stop_ind; v_ind++) {
         _ps("\t");_pd(v_ind);
@@ -1249,7 +1573,7 @@ void corrector (
         // triplets comprising macro spikes or macro drops are resorbed:
         // (triplet resorption: spike/drop elimination)
         // (the central triple starts at ss_start_ind + 1)
-        if (resorber (z[(ss_start_ind + 1) & LSB], v, ss_cat, ss_start_ind, ss_stop_ind, rel_delta, rc)) {
+        if (resorber (z[(ss_start_ind + 1) & LSB], v, ss_cat, ss_start_ind, ss_stop_ind, cp, rel_delta, rc)) {
           // jump elimination (spike / drop)
           // ================
           // if the resorber gives a better result than the best-fit approximation,
@@ -1286,3 +1610,815 @@ void corrector (
 }
 // END CORRECTOR
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool stream_classifier (     //     returns true, if a re-clustering is requested (outlier rate too high)
+  categories z[],            // I   learned categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  stream_state &s,           // IO  stream counters
+  uint16_t   v_val,          // I   flagged raw data value (as recorded)
+  uint8_t    z_ind           // I   signal level index (either HIGH or LOW)
+) {
+  // ********************* //
+  // 2.3 STREAM CLASSIFIER //  classify a continuously received value with the learned categories
+  // ********************* //
+  // called by the recorder (streaming) after each recorded value, i.e. between two signals:
+  // keep it short: the recorder adds the time spent here to the signal in progress (cf. recorder.cpp: stream_value),
+  // but a signal that ends meanwhile is lost (at 115200 baud, one character may block for ~ 87 us)
+  // output: one character per value (same marking as the sequence_printer), a new line per window
+  // "*" : value is higher than the top-values barrier (-> subsequence separator like pause)
+  // "?" : value does not belong to any category (outlier)
+
+  uint8_t  cat_ind;     // index of current category (combined clusters and aggregations)
+  uint16_t cat_val;     // value of current category (combined clusters and aggregations)
+
+  s.value_count++;
+  if ((v_val & MSB) >= z[z_ind].separator_barrier) {
+    _pc('*');
+  } else
+  // !!! use the same C_OPT as the sequence_printer !!!
+  if (classifier (z[z_ind], v_val & MSB, cat_ind, cat_val, C_OPT_3)) {
+    // use characters for indices >= 10  ('a' = 97; 97 - 10 = 87)
+    _pc((char) ((cat_ind < 10) ? '0' + cat_ind : 87 + cat_ind));
+  } else {
+    _pc('?');
+    s.outlier_count++;
+    s.window_outliers++;
+  }
+
+  // end of window: check the outlier rate
+  // -------------
+  if (++s.window_count < STREAM_WINDOW) return (false);
+  _psln("");
+  s.window_count= 0;
+  if (s.window_outliers > STREAM_OUTLIERS) {
+    s.window_outliers= 0;
+    s.recluster_count++;
+    return (true);
+  }
+  s.window_outliers= 0;
+  return (false);
+
+} // end stream_classifier
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint8_t frame_mismatches (  //     returns the number of certain mismatches between two frames of the same length (max. FRAME_TOLERANCE + 1)
+  categories z[],           // I   categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,           // I   corrected signal sequence
+  uint16_t   a_start,       // I   first pair of frame a
+  uint16_t   b_start,       // I   first pair of frame b
+  uint16_t   f_length       // I   number of pairs of both frames
+) {
+  // ********************** //
+  // 2.4.1 frame_mismatches //  compare two frames position by position
+  // ********************** //
+  // a position is certain, if the value is reliable and categorized (or above the separator barrier);
+  // uncertain positions ("!", "?", "-" and spikes / drops) match everything
+  uint16_t p_ind;       // index of pair
+  uint8_t  z_ind;       // signal level index (either HIGH or LOW)
+  uint16_t a_val;       // value of frame a
+  uint16_t b_val;       // value of frame b
+  char     a_sym;       // symbol of frame a
+  char     b_sym;       // symbol of frame b
+  uint8_t  count;       // number of mismatches
+
+  count= 0;
+  for (p_ind= 0; p_ind < f_length; p_ind++) {
+    for (z_ind= LOW; z_ind <= HIGH; z_ind++) {
+      a_val= v[2 * (a_start + p_ind) + 2 - z_ind];
+      b_val= v[2 * (b_start + p_ind) + 2 - z_ind];
+      if (((a_val & LSB) == UNRELIABLE) || ((b_val & LSB) == UNRELIABLE)) continue;
+      a_sym= category_symbol (z[z_ind], a_val);
+      b_sym= category_symbol (z[z_ind], b_val);
+      if ((a_sym == b_sym) || !FRAME_CERTAIN(a_sym) || !FRAME_CERTAIN(b_sym)) continue;
+      if (++count > FRAME_TOLERANCE) return (count);
+    }
+  }
+  return (count);
+}
+// END frame_mismatches
+
+char frame_vote (           //     returns the majority symbol of a position over all repeats of a frame
+  categories z[],           // I   categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,           // I   corrected signal sequence
+  uint16_t   f_start[],     // I   first pair of each frame
+  uint16_t   f_group[],     // I   representative frame of each frame
+  uint8_t    f_size,        // I   number of frames
+  uint8_t    g_ind,         // I   representative frame of the repeats
+  uint16_t   p_ind,         // I   pair of the position (relative to the frame start)
+  uint8_t    z_ind,         // I   signal level index (either HIGH or LOW)
+  bool      &reliable       // O   true, if the majority is carried by a reliable vote or by two repeats
+) {
+  // **************** //
+  // 2.4.2 frame_vote //  majority vote per position (correction of residual "?" and "!" marks)
+  // **************** //
+  // vote weights: reliable certain symbol: 2, unreliable categorized symbol: 1, uncertain marks: 0
+  // a tie marks the position "?"; without any vote the symbol of the representative frame remains
+  uint8_t  weight[NC + NA + 1];   // vote weight per category ([NC + NA]: top-values "*")
+  uint8_t  w_ind;               // index of weight
+  uint8_t  w_max;               // highest weight
+  bool     tie;                 // true, if the highest weight is not unique
+  uint8_t  f_ind;               // index of frame
+  uint16_t v_val;               // value of the position in frame f_ind
+  char     sym;                 // symbol of v_val
+  char     winner;              // majority symbol
+
+  memset(weight, 0, sizeof(weight));
+  for (f_ind= g_ind; f_ind < f_size; f_ind++) {
+    if (f_group[f_ind] != g_ind) continue;
+    v_val= v[2 * (f_start[f_ind] + p_ind) + 2 - z_ind];
+    sym= category_symbol (z[z_ind], v_val);
+    if (!FRAME_CERTAIN(sym)) continue;
+    if      (sym == '*') w_ind= NC + NA;
+    else if (sym <= '9') w_ind= sym - '0';
+    else                 w_ind= sym - 87;
+    weight[w_ind]+= ((v_val & LSB) == RELIABLE) ? 2 : 1;
+  }
+  w_max= 0;
+  tie= false;
+  winner= ' ';
+  for (w_ind= 0; w_ind <= NC + NA; w_ind++) {
+    if (weight[w_ind] == 0) continue;
+    if (weight[w_ind] == w_max) tie= true;
+    if (weight[w_ind] > w_max) {
+      w_max= weight[w_ind];
+      tie= false;
+      if      (w_ind == NC + NA) winner= '*';
+      else if (w_ind < 10)       winner= '0' + w_ind;
+      else                       winner= 87 + w_ind;
+    }
+  }
+  if (w_max == 0) {
+    // no vote: the representative frame decides
+    v_val= v[2 * (f_start[g_ind] + p_ind) + 2 - z_ind];
+    reliable= ((v_val & LSB) == RELIABLE);
+    return (category_symbol (z[z_ind], v_val));
+  }
+  reliable= (w_max >= 2);
+  if (tie) {
+    reliable= false;
+    return ('?');
+  }
+  return (winner);
+}
+// END frame_vote
+
+uint8_t frame_splitter (    //     returns the number of frames (1 .. NF)
+  categories z[],           // I   categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,           // I   corrected signal sequence
+  int16_t    v_length,      // I   number of signal durations
+  uint16_t   f_start[],     // O   first pair of each frame (NF)
+  uint16_t   f_length[]     // O   number of pairs of each frame (NF)
+) {
+  // ******************** //
+  // 2.4.3 frame_splitter //  split the corrected sequence into frames (cf. frame_merger, protocol_decoder)
+  // ******************** //
+  // a frame ends after a pair (HIGH, LOW) above the separator barrier or after a LOW gap (FRAME_GAP);
+  // the "ending" belongs to the last frame, frames beyond NF are appended to the last frame
+  uint16_t p_count;         // number of pairs of the sequence
+  uint16_t p_ind;           // index of pair
+  uint32_t gap;             // lowest LOW value that separates two frames
+  uint8_t  f_size;          // number of frames
+
+  // end handling (cf. sequence_printer)
+  if ((v[v_length + 1] != 0) && (v[v_length + 2] != 0)) {
+    v_length+= 2;
+  }
+  p_count= v_length >> 1;
+
+  gap= min((uint32_t) z[LOW].separator_barrier, (uint32_t) FRAME_GAP * z[LOW].cluster_center[0]);
+  f_size= 0;
+  f_start[0]= 0;
+  for (p_ind= 0; p_ind + 1 < p_count; p_ind++) {
+    if (f_size == NF - 1) break;
+    if ((v[2 * p_ind + 1] < z[HIGH].separator_barrier) && (v[2 * p_ind + 2] < gap)) continue;
+    f_length[f_size]= p_ind + 1 - f_start[f_size];
+    f_size++;
+    f_start[f_size]= p_ind + 1;
+  }
+  f_length[f_size]= p_count - f_start[f_size];
+  f_size++;
+  return (f_size);
+}
+// END frame_splitter
+
+void frame_merger (
+  categories z[],           // I   categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,           // I   corrected signal sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  int16_t    v_length,      // I   number of signal durations
+  uint16_t   uint16buf64[]  // X   frame table (4 * NF <= DIM_64)
+) {
+  // **************** //
+  // 2.4 FRAME MERGER //  print each distinct frame of the trace once with its repeat count
+  // **************** //
+  // - split   : the categorized sequence is split into frames after each pair (HIGH, LOW) above the separator barrier;
+  //             a LOW of FRAME_GAP times the lowest LOW cluster center is a gap as well (clustered sync pauses)
+  // - merge   : frames of the same length with at most FRAME_TOLERANCE certain mismatches are repeats
+  //             of the first one (the representative)
+  // - vote    : the repeats are merged by a majority vote per position (cf. frame_vote)
+  // - print   : per distinct frame: repeat count, number of pairs, hash of the voted symbols (djb2, 16 bits)
+  //             and the rows of the sequence_printer (reliability marks: majority without a reliable vote)
+  // frames beyond NF are appended to the last frame
+  uint16_t *f_start=  uint16buf64;            // first pair of the frame
+  uint16_t *f_length= uint16buf64 + NF;       // number of pairs of the frame
+  uint16_t *f_group=  uint16buf64 + 2 * NF;   // representative frame (first frame of its repeats)
+  uint16_t *f_repeat= uint16buf64 + 3 * NF;   // number of repeats (representative frames only)
+  uint8_t  f_size;          // number of frames
+  uint8_t  f_ind;           // index of frame
+  uint8_t  g_ind;           // index of representative frame
+  uint16_t p_ind;           // index of pair
+  uint8_t  z_ind;           // signal level index (either HIGH or LOW)
+  uint8_t  row;             // printed row: HIGH marks, HIGH, LOW, LOW marks
+  uint16_t hash;            // hash of the voted symbols
+  bool     reliable;        // cf. frame_vote
+  char     sym;             // voted symbol
+
+  // split
+  // =====
+  f_size= frame_splitter (z, v, v_length, f_start, f_length);
+
+  // merge
+  // =====
+  for (f_ind= 0; f_ind < f_size; f_ind++) {
+    f_group[f_ind]= f_ind;
+    f_repeat[f_ind]= 1;
+    for (g_ind= 0; g_ind < f_ind; g_ind++) {
+      if (f_group[g_ind] != g_ind) continue;
+      if (f_length[g_ind] != f_length[f_ind]) continue;
+      if (frame_mismatches (z, v, f_start[g_ind], f_start[f_ind], f_length[f_ind]) > FRAME_TOLERANCE) continue;
+      f_group[f_ind]= g_ind;
+      f_repeat[g_ind]++;
+      break;
+    }
+  }
+
+  // vote & print
+  // ============
+  for (g_ind= 0; g_ind < f_size; g_ind++) {
+    if (f_group[g_ind] != g_ind) continue;
+    hash= 5381;
+    for (p_ind= 0; p_ind < f_length[g_ind]; p_ind++) {
+      for (z_ind= HIGH; ; z_ind= LOW) {
+        hash= (hash << 5) + hash + (uint8_t) frame_vote (z, v, f_start, f_group, f_size, g_ind, p_ind, z_ind, reliable);
+        if (z_ind == LOW) break;
+      }
+    }
+    _ps(F("frame: "));_pd(g_ind);
+    _ps(F(", repeats: "));_pd(f_repeat[g_ind]);
+    _ps(F(", pairs: "));_pd(f_length[g_ind]);
+    _ps(F(", hash: "));_pdln(hash);
+    for (row= 0; row < 4; row++) {
+      z_ind= (row < 2) ? HIGH : LOW;
+      if      (row == 1) _ps(F("HIGH: "));
+      else if (row == 2) _ps(F("LOW : "));
+      else               _ps(F("    : "));
+      for (p_ind= 0; p_ind < f_length[g_ind]; p_ind++) {
+        sym= frame_vote (z, v, f_start, f_group, f_size, g_ind, p_ind, z_ind, reliable);
+        if ((row == 0) || (row == 3)) _pc(((sym == ' ') || reliable) ? ' ' : '!');
+        else _pc(sym);
+      }
+      _psln("");
+    }
+  }
+  category_table_printer (z);
+
+} // end frame_merger
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#if (CATEGORIZER_OUTPUT == BIT_OUTPUT)
+// learned protocol signatures
+THREAD_LOCAL protocol_signature protocol_table[NP];
+
+void protocol_decoder (
+  categories z[],           // I   categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,           // I   corrected signal sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  int16_t    v_length,      // I   number of signal durations
+  uint16_t   uint16buf64[], // X   frame table (2 * NF <= DIM_64)
+  uint8_t    uint8buf32[]   // X   bit payloads (2 * PROTOCOL_BYTES <= DIM_32)
+) {
+  // ******************** //
+  // 2.5 PROTOCOL DECODER //  print the bit payload of each frame
+  // ******************** //
+  // - lookup  : a learned signature whose data levels match clusters of the categories (C_OPT_3) is used at once
+  // - analysis: otherwise the encoding is recognized from the categories (cf. protocol_analyzer)
+  //             and learned in place of the oldest signature
+  // - decode  : the data runs of the frames (cf. frame_splitter, frame_bits) are decoded into packed bits,
+  //             runs of less than PROTOCOL_MIN_BITS bits are skipped,
+  //             consecutive runs of the same payload are printed once with their repeat count
+  // without a known encoding, the categorized sequence is printed (cf. sequence_printer)
+  uint16_t *f_start=  uint16buf64;                // first pair of the frame
+  uint16_t *f_length= uint16buf64 + NF;           // number of pairs of the frame
+  uint8_t  *bits=      uint8buf32;                // payload of the current frame
+  uint8_t  *last_bits= uint8buf32 + PROTOCOL_BYTES; // payload of the previous frame
+  protocol_signature p;     // signature of the trace
+  uint8_t  e_ind;           // index of the signature in protocol_table
+  uint8_t  k_ind;           // index of table entry
+  bool     learned;         // true, if the signature was found in protocol_table
+  uint8_t  c_ind;           // cf. classifier
+  uint16_t c_val;           // cf. classifier
+  uint8_t  z_ind;           // signal level index (either HIGH or LOW)
+  uint8_t  level;           // short (0) or long (1) data level
+  uint8_t  f_size;          // number of frames
+  uint8_t  f_ind;           // index of frame
+  uint8_t  last_f;          // frame of the first run of the previous payload
+  uint8_t  repeat;          // number of runs of the previous payload
+  uint16_t p_ind;           // first pair of the next data run
+  uint16_t n;               // number of bits of the current data run
+  uint16_t last_n;          // number of bits of the previous payload
+  uint8_t  b_ind;           // index of payload byte
+  uint8_t  nibble;
+
+  f_size= frame_splitter (z, v, v_length, f_start, f_length);
+
+  // lookup
+  // ======
+  learned= false;
+  for (e_ind= 0; e_ind < NP; e_ind++) {
+    if (protocol_table[e_ind].encoding == PROTOCOL_UNKNOWN) continue;
+    learned= true;
+    for (z_ind= LOW; z_ind <= HIGH; z_ind++) {
+      for (level= 0; level < 2; level++) {
+        if (!classifier (z[z_ind], protocol_table[e_ind].center[z_ind][level], c_ind, c_val, C_OPT_3)) learned= false;
+      }
+    }
+    if (learned) break;
+  }
+  if (learned) {
+    p= protocol_table[e_ind];
+    protocol_table[e_ind].hit_count++;
+  } else {
+    // analysis
+    // ========
+    if (protocol_analyzer (z, v, f_start, f_length, f_size, p) == PROTOCOL_UNKNOWN) {
+      _psln(F("protocol: unknown"));
+      sequence_printer (z, v, v_length);
+      return;
+    }
+    // replace an empty or the oldest entry
+    e_ind= 0;
+    for (k_ind= 0; k_ind < NP; k_ind++) {
+      if (protocol_table[k_ind].encoding == PROTOCOL_UNKNOWN) {e_ind= k_ind; break;}
+      if (protocol_table[k_ind].age > protocol_table[e_ind].age) e_ind= k_ind;
+    }
+    p.hit_count= 0;
+    protocol_table[e_ind]= p;
+  }
+  for (k_ind= 0; k_ind < NP; k_ind++) {
+    if (protocol_table[k_ind].age < 255) protocol_table[k_ind].age++;
+  }
+  protocol_table[e_ind].age= 0;
+
+  _ps(F("protocol: "));_pd(e_ind);
+  if      (p.encoding == PROTOCOL_PWM) _ps(F(", PWM"));
+  else if (p.encoding == PROTOCOL_PPM) _ps(F(", PPM"));
+  else                                 _ps(F(", Manchester"));
+  if (learned) {_ps(F(" (learned, hits: "));_pd(p.hit_count + 1);_ps(F(")"));}
+  else          _ps(F(" (analyzed)"));
+  _ps(F(", HIGH: "));_pd(p.center[HIGH][0]);_ps(F(" / "));_pd(p.center[HIGH][1]);
+  _ps(F(", LOW: "));_pd(p.center[LOW][0]);_ps(F(" / "));_pdln(p.center[LOW][1]);
+
+  // decode
+  // ======
+  // the data runs of all frames, f_ind == f_size: prints the last payload
+  repeat= 0;
+  last_n= 0;
+  last_f= 0;
+  p_ind= 0;
+  f_ind= 0;
+  while (f_ind <= f_size) {
+    n= 0;
+    if (f_ind < f_size) {
+      if (p_ind < f_start[f_ind]) p_ind= f_start[f_ind];
+      if (p_ind >= f_start[f_ind] + f_length[f_ind]) {f_ind++; continue;}
+      n= frame_bits (p, v, p_ind, f_start[f_ind] + f_length[f_ind], bits);
+      // runs of a few bits: end pulses, preambles
+      if (n < PROTOCOL_MIN_BITS) continue;
+      if ((repeat > 0) && (n == last_n) && (memcmp(bits, last_bits, PROTOCOL_BYTES) == 0)) {
+        repeat++;
+        continue;
+      }
+    } else {
+      f_ind++;
+    }
+    if (repeat > 0) {
+      _ps(F("frame: "));_pd(last_f);
+      _ps(F(", repeats: "));_pd(repeat);
+      _ps(F(", bits: "));_pd(last_n);
+      _ps(F(", payload: "));
+      for (b_ind= 0; (b_ind < PROTOCOL_BYTES) && (8 * b_ind < last_n); b_ind++) {
+        nibble= last_bits[b_ind] >> 4;
+        _pc((char)((nibble < 10) ? '0' + nibble : 'A' - 10 + nibble));
+        nibble= last_bits[b_ind] & 15;
+        _pc((char)((nibble < 10) ? '0' + nibble : 'A' - 10 + nibble));
+      }
+      if (last_n > 8 * PROTOCOL_BYTES) _ps(F(" (truncated)"));
+      _psln("");
+    }
+    memcpy(last_bits, bits, PROTOCOL_BYTES);
+    last_n= n;
+    last_f= f_ind;
+    repeat= 1;
+  }
+
+} // end protocol_decoder
+#endif
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint8_t protocol_analyzer ( //     returns the recognized encoding (PROTOCOL_UNKNOWN: none)
+  categories z[],           // I   categories ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,           // I   corrected signal sequence
+  uint16_t   f_start[],     // I   first pair of each frame
+  uint16_t   f_length[],    // I   number of pairs of each frame
+  uint8_t    f_size,        // I   number of frames
+  protocol_signature &p     // O   encoding and data levels
+) {
+  // *********************** //
+  // 2.5.1 protocol_analyzer //  recognize the encoding and its data levels from the categories
+  // *********************** //
+  // data levels: the clusters below the separator barrier holding at least 1 / PROTOCOL_SHARE of the clustered
+  // values of their level (sync pulses and gaps are rare); 1 or 2 data levels per level are required
+  // - 2 HIGH, 1 LOW levels: PWM
+  // - 1 HIGH, 2 LOW levels: PPM
+  // - 2 HIGH, 2 LOW levels: PWM if 3 / 4 of the data pairs are complementary (one short, one long value),
+  //                         Manchester if the long levels are 1.5 .. 2.5 times the short ones (1T / 2T)
+  uint8_t  n[2];            // number of data levels per level
+  uint16_t total;           // clustered values of the level below the separator barrier
+  uint8_t  z_ind;           // signal level index (either HIGH or LOW)
+  uint8_t  c_ind;           // index of cluster
+  uint8_t  f_ind;           // index of frame
+  uint16_t p_ind;           // index of pair
+  uint8_t  h_level;         // data level of the HIGH of a pair
+  uint8_t  l_level;         // data level of the LOW of a pair
+  uint16_t pair_count;      // number of data pairs
+  uint16_t comp_count;      // number of complementary data pairs
+
+  p.encoding= PROTOCOL_UNKNOWN;
+  p.age= 0;
+  for (z_ind= LOW; z_ind <= HIGH; z_ind++) {
+    total= 0;
+    for (c_ind= 0; c_ind < z[z_ind].cluster_size; c_ind++) {
+      if (z[z_ind].cluster_center[c_ind] < z[z_ind].separator_barrier) total+= z[z_ind].cluster_count[c_ind];
+    }
+    n[z_ind]= 0;
+    // clusters in ascending order: the first data level is the short one
+    for (c_ind= 0; c_ind < z[z_ind].cluster_size; c_ind++) {
+      if (z[z_ind].cluster_center[c_ind] >= z[z_ind].separator_barrier) continue;
+      if ((uint32_t) PROTOCOL_SHARE * z[z_ind].cluster_count[c_ind] < total) continue;
+      if (n[z_ind] == 2) return (PROTOCOL_UNKNOWN);
+      p.center[z_ind][n[z_ind]]= z[z_ind].cluster_center[c_ind];
+      n[z_ind]++;
+    }
+    if (n[z_ind] == 0) return (PROTOCOL_UNKNOWN);
+    if (n[z_ind] == 1) p.center[z_ind][1]= p.center[z_ind][0];
+  }
+
+  if ((n[HIGH] == 2) && (n[LOW] == 1)) p.encoding= PROTOCOL_PWM;
+  if ((n[HIGH] == 1) && (n[LOW] == 2)) p.encoding= PROTOCOL_PPM;
+  if ((n[HIGH] == 2) && (n[LOW] == 2)) {
+    pair_count= 0;
+    comp_count= 0;
+    for (f_ind= 0; f_ind < f_size; f_ind++) {
+      for (p_ind= f_start[f_ind]; p_ind < f_start[f_ind] + f_length[f_ind]; p_ind++) {
+        h_level= protocol_level (p, HIGH, v[2 * p_ind + 1]);
+        l_level= protocol_level (p, LOW,  v[2 * p_ind + 2]);
+        if ((h_level == PROTOCOL_NONE) || (l_level == PROTOCOL_NONE)) continue;
+        pair_count++;
+        if (h_level != l_level) comp_count++;
+      }
+    }
+    if ((pair_count > 0) && (4 * (uint32_t) comp_count >= 3 * (uint32_t) pair_count)) {
+      p.encoding= PROTOCOL_PWM;
+    } else {
+      p.encoding= PROTOCOL_MANCHESTER;
+      for (z_ind= LOW; z_ind <= HIGH; z_ind++) {
+        if ((2 * (uint32_t) p.center[z_ind][1] < 3 * (uint32_t) p.center[z_ind][0]) ||
+            (2 * (uint32_t) p.center[z_ind][1] > 5 * (uint32_t) p.center[z_ind][0])) p.encoding= PROTOCOL_UNKNOWN;
+      }
+    }
+  }
+  return (p.encoding);
+}
+// END protocol_analyzer
+
+uint8_t protocol_level (    //     returns the data level of a value: 0: short, 1: long, PROTOCOL_NONE: neither
+  protocol_signature &p,    // I   data levels
+  uint8_t    z_ind,         // I   signal level index (either HIGH or LOW)
+  uint16_t   v_val          // I   flagged value
+) {
+  // ******************** //
+  // 2.5.2 protocol_level //  data level of a value (within 25 % of its center, cf. C_OPT_2)
+  // ******************** //
+  uint8_t  level;           // short (0) or long (1) data level
+  uint16_t center;          // data level center
+
+  v_val&= MSB;
+  for (level= 0; level < 2; level++) {
+    center= p.center[z_ind][level];
+    if (abs((int32_t) v_val - (int32_t) center) <= (int32_t) (center >> 2)) return (level);
+  }
+  return (PROTOCOL_NONE);
+}
+// END protocol_level
+
+// append a bit to the payload (the bits beyond 8 * PROTOCOL_BYTES are counted only)
+#define PUT_BIT(b)  {if ((n < 8 * PROTOCOL_BYTES) && (b)) bits[n >> 3]|= 0x80 >> (n & 7); n++;}
+
+uint16_t frame_bits (       //     returns the number of decoded bits of the next data run
+  protocol_signature &p,    // I   encoding and data levels
+  duration_seq v,           // I   corrected signal sequence
+  uint16_t   &p_ind,        // IO  I: first pair to decode; O: first pair after the data run
+  uint16_t   p_stop,        // I   first pair after the frame
+  uint8_t    bits[]         // O   packed bits, most significant bit first (PROTOCOL_BYTES)
+) {
+  // **************** //
+  // 2.5.3 frame_bits //  decode the next data run of a frame into packed bits
+  // **************** //
+  // a data run starts at the first decodable pair and ends at the next sync pulse or gap,
+  // i.e. a frame may hold several runs (sync pauses below FRAME_GAP do not split frames)
+  // - PWM       : a pair of a data HIGH gives its level, a LOW that is no data level ends the run
+  // - PPM       : a pair of data levels gives the level of the LOW
+  // - Manchester: each value gives 1 (short) or 2 (long) half bits of its level, decoded in pairs
+  //               (HIGH-LOW: 1, LOW-HIGH: 0); of the two alignments (run starting with a whole bit
+  //               or with the second half of a 0) the one with fewer invalid pairs (HIGH-HIGH, LOW-LOW) is taken
+  uint16_t n;               // number of bits
+  uint16_t q_ind;           // index of pair
+  uint16_t k;               // index of value
+  uint16_t k_start;         // first value of the run (Manchester)
+  uint16_t k_stop;          // first value after the run (Manchester)
+  uint8_t  h_level;         // data level of the HIGH of a pair
+  uint8_t  l_level;         // data level of the LOW of a pair
+  uint8_t  level;           // data level of a value
+  uint8_t  z_ind;           // signal level index (either HIGH or LOW)
+  uint8_t  half;            // pending half bit (HIGH, LOW or PROTOCOL_NONE)
+  uint8_t  h_ind;           // index of half bit
+  uint8_t  pass;            // Manchester: 0, 1: alignment 0 / 1 (errors only), 2: decoding with the best alignment
+  uint8_t  align;           // Manchester: alignment of the pass
+  uint16_t errors[2];       // Manchester: invalid pairs per alignment
+
+  n= 0;
+  memset(bits, 0, PROTOCOL_BYTES);
+  if (p.encoding != PROTOCOL_MANCHESTER) {
+    for (q_ind= p_ind; q_ind < p_stop; q_ind++) {
+      h_level= protocol_level (p, HIGH, v[2 * q_ind + 1]);
+      l_level= protocol_level (p, LOW,  v[2 * q_ind + 2]);
+      if (p.encoding == PROTOCOL_PWM) {
+        if (h_level == PROTOCOL_NONE) {
+          if (n > 0) break;
+          continue;
+        }
+        PUT_BIT(h_level);
+        if (l_level == PROTOCOL_NONE) {q_ind++; break;}
+      } else {
+        if ((h_level == PROTOCOL_NONE) || (l_level == PROTOCOL_NONE)) {
+          if (n > 0) break;
+          continue;
+        }
+        PUT_BIT(l_level);
+      }
+    }
+    p_ind= q_ind;
+    return (n);
+  }
+
+  // Manchester
+  // the run: from the first data value to the next value that is no data level
+  for (k_start= 2 * p_ind + 1; k_start < 2 * p_stop + 1; k_start++) {
+    if (protocol_level (p, (k_start & 1) ? HIGH : LOW, v[k_start]) != PROTOCOL_NONE) break;
+  }
+  for (k_stop= k_start; k_stop < 2 * p_stop + 1; k_stop++) {
+    if (protocol_level (p, (k_stop & 1) ? HIGH : LOW, v[k_stop]) == PROTOCOL_NONE) break;
+  }
+  p_ind= (k_stop < 2 * p_stop + 1) ? (k_stop + 1) >> 1 : p_stop;
+  if (p_ind <= (k_start - 1) >> 1) p_ind= ((k_start - 1) >> 1) + 1;
+  for (pass= 0; pass < 3; pass++) {
+    if (pass < 2) {align= pass; errors[pass]= 0;}
+    else align= (errors[1] < errors[0]) ? 1 : 0;
+    n= 0;
+    memset(bits, 0, PROTOCOL_BYTES);
+    // alignment 1: the run starts with the second half of a bit (a phantom first half of the opposite level)
+    half= (align == 0) ? PROTOCOL_NONE : ((k_start & 1) ? LOW : HIGH);
+    for (k= k_start; k < k_stop; k++) {
+      z_ind= (k & 1) ? HIGH : LOW;
+      level= protocol_level (p, z_ind, v[k]);
+      for (h_ind= 0; h_ind <= level; h_ind++) {
+        if (half == PROTOCOL_NONE) {half= z_ind; continue;}
+        if (half == z_ind) {
+          // invalid pair: resynchronize on the current half bit
+          if (pass < 2) errors[pass]++;
+          continue;
+        }
+        PUT_BIT(half == HIGH);
+        half= PROTOCOL_NONE;
+      }
+    }
+    // a final "1" ends with the LOW of the gap
+    if (half == HIGH) PUT_BIT(1);
+  }
+  return (n);
+}
+// END frame_bits
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool prescreener (           //     returns true, if the trace is predicted clusterable (false: noise, skip the categorizer)
+  duration_seq v,            // I   flagged raw data value sequence (as recorded)
+  uint16_t   v_length,       // I   number of signal durations: HIGH- plus LOW- durations without end markers
+  uint16_t   unreliable_count, // I number of unreliable (flagged) values contained in the signal sequence
+  uint8_t    bin_count[]     // X   buffer: 2 * PRESCREEN_BINS bin counts ([z_ind * PRESCREEN_BINS + b_ind])
+) {
+  // ************** //
+  // 2.6 PRE-SCREEN //  predict unclusterable traces before they are reported and categorized
+  // ************** //
+  // one pass over the recorded values instead of the histograms of the clusterer:
+  // - the reliable values of each level are counted in PRESCREEN_BINS coarse bins (half octaves from PRESCREEN_FLOOR)
+  // - a duration level populates one or two bins, noise populates a continuum of bins:
+  //   PRESCREEN_RUN consecutive bins of at least MIN_SIZE values are not expected from a clusterable trace
+  // - more than 1 / PRESCREEN_UNRELIABLE unreliable values leave too few trusted values to the clusterer
+  // the prediction is conservative (false: a clusterable trace would be lost), cf. offline/benchmark.cpp: summary
+  uint16_t v_ind;       // index of v[]
+  uint16_t w;           // value / (PRESCREEN_FLOOR / 2): the 2 most significant bits
+  uint8_t  b_ind;       // index of bin
+  uint8_t  z_ind;       // signal level index (either HIGH or LOW)
+  uint8_t  run;         // number of consecutive populated bins
+
+  if ((uint32_t)unreliable_count * PRESCREEN_UNRELIABLE > v_length) return (false);
+  memset(bin_count, 0, 2 * PRESCREEN_BINS);
+  for (v_ind= 1; v_ind <= v_length; v_ind++) {
+    w= v[v_ind];
+    if ((w & LSB) == UNRELIABLE) continue;
+    if ((w < PRESCREEN_FLOOR) || (w >= (PRESCREEN_FLOOR << (PRESCREEN_BINS / 2)))) continue;
+    // half octave: exponent and second bit
+    w/= PRESCREEN_FLOOR / 2;
+    b_ind= 0;
+    while (w >= 4) {w>>= 1; b_ind+= 2;}
+    b_ind+= w & 1;
+    b_ind+= (v_ind & 1) ? HIGH * PRESCREEN_BINS : LOW * PRESCREEN_BINS;
+    if (bin_count[b_ind] < 255) bin_count[b_ind]++;
+  }
+  for (z_ind= LOW; z_ind <= HIGH; z_ind++) {
+    run= 0;
+    for (b_ind= 0; b_ind < PRESCREEN_BINS; b_ind++) {
+      if (bin_count[z_ind * PRESCREEN_BINS + b_ind] < MIN_SIZE) run= 0;
+      else if (++run >= PRESCREEN_RUN) return (false);
+    }
+  }
+  return (true);
+
+} // end prescreener
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool separator (             //     returns true, if the trace is split into two sub-sequences (false: v[] unchanged)
+  duration_seq v,            // IO  flagged raw data value sequence v[1 .. v_length + 2] ("ending" included)
+                             //     -> the other transmitter: v[1 .. s_length[0] + 2], followed by the reference transmitter
+  uint16_t   v_length,       // I   number of signal durations: HIGH- plus LOW- durations without end markers
+  const uint8_t transmitter[], // I packed transmitter tags of the HIGHs (cf. durations.h: TRANSMITTER_OF)
+  uint16_t   s_length[],     // O   [0]: other, [1]: reference transmitter: number of signal durations of the sub-sequence
+  uint16_t   s_unreliable[]  // O   [0]: other, [1]: reference transmitter: number of unreliable values of the sub-sequence
+) {
+  // ************* //
+  // 2.7 SEPARATOR //  split a trace of two overlapping transmitters into one sub-sequence per transmitter
+  // ************* //
+  // the recorder tags each HIGH with its strength bucket (radio_lib.h: COLLISION_SEPARATE), a pair is a HIGH
+  // and the following LOW; the sub-sequence of a transmitter is the sequence of its pairs, where the LOW of
+  // the last pair of a run is extended up to the next HIGH of the same transmitter:
+  // - merging (right to left): the LOW absorbs the durations of the following run of the other transmitter
+  //   (its reliability: the LOW itself and the last LOW of that run, i.e. both of its edges)
+  // - partition: the pairs of the other transmitter are moved to the front, stable (rotations by three reversals)
+  // - each sub-sequence ends with (x, CEIL), its last HIGH followed by a pause
+  // categorize v[1 ..] with s_length[0], then move the reference transmitter to the front (separator_shift)
+  uint16_t p_count;     // number of pairs (the last HIGH of an "ending" (x, CEIL) included)
+  uint16_t count[2];    // number of pairs per transmitter tag
+  uint16_t p, q;        // index of pair: v[2 * p + 1], v[2 * p + 2]
+  uint16_t w;           // number of pairs of the other transmitter at the front
+  uint16_t v_ind;       // index of v[]
+  uint16_t low;
+  uint32_t run_sum;     // sum of the durations of the current run (right to left)
+  uint32_t next_sum;    // sum of the durations of the following run of the other transmitter
+  uint8_t  run_flag;    // reliability of the last LOW of the current run
+  uint8_t  next_flag;   // reliability of the last LOW of the following run
+  uint8_t  run_tag;     // transmitter of the current run
+  uint8_t  tag;
+
+  p_count= v_length / 2 + ((v[v_length + 1] != 0) ? 1 : 0);
+  count[0]= count[1]= 0;
+  for (p= 0; p < p_count; p++) count[TRANSMITTER_OF(transmitter, 2 * p + 1)]++;
+  // two transmitters, each of at least one pair in front of its ending
+  if ((count[0] < 2) || (count[1] < 2)) return (false);
+
+  // merging
+  // -------
+  run_tag= TRANSMITTER_OF(transmitter, 2 * p_count - 1);
+  run_sum= next_sum= 0;
+  run_flag= next_flag= RELIABLE;
+  for (p= p_count; p-- > 0; ) {
+    v_ind= 2 * p + 1;
+    tag= TRANSMITTER_OF(transmitter, v_ind);
+    low= v[v_ind + 1];
+    if ((tag != run_tag) || (p == p_count - 1)) {
+      // the last pair of a run (the runs are scanned from right to left)
+      if (tag != run_tag) {next_sum= run_sum; next_flag= run_flag;}
+      run_sum= 0;
+      run_tag= tag;
+      run_flag= low & LSB;
+      if (next_sum > 0) v[v_ind + 1]= (uint16_t)min((uint32_t)CEIL_U, (low & MSB) + next_sum) | ((low | next_flag) & LSB);
+    }
+    run_sum+= (v[v_ind] & MSB) + (low & MSB);
+  }
+
+  // partition
+  // ---------
+  // rotate the pairs [w .. q - 1]: the run [p .. q - 1] of the other transmitter moves in front of [w .. p - 1]
+  w= 0;
+  for (p= 0; p < p_count; ) {
+    if (TRANSMITTER_OF(transmitter, 2 * p + 1) == 0) {p++; continue;}
+    for (q= p + 1; (q < p_count) && TRANSMITTER_OF(transmitter, 2 * q + 1); q++);
+    if (p > w) {
+      sequence_reverse (v, 2 * w + 1, 2 * p);
+      sequence_reverse (v, 2 * p + 1, 2 * q);
+      sequence_reverse (v, 2 * w + 1, 2 * q);
+    }
+    w+= q - p;
+    p= q;
+  }
+
+  // endings and unreliable counts
+  // -----------------------------
+  v[2 * count[1]]= CEIL;
+  v[2 * p_count]=  CEIL;
+  s_length[0]= 2 * count[1] - 2;
+  s_length[1]= 2 * count[0] - 2;
+  s_unreliable[0]= s_unreliable[1]= 0;
+  for (v_ind= 1; v_ind <= s_length[0]; v_ind++) s_unreliable[0]+= v[v_ind] & LSB;
+  for (v_ind= 1; v_ind <= s_length[1]; v_ind++) s_unreliable[1]+= v[s_length[0] + 2 + v_ind] & LSB;
+  return (true);
+
+} // end separator
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void sequence_reverse (
+  duration_seq v,            // IO  flagged raw data value sequence
+  uint16_t   i,              // I   first index of the range (included)
+  uint16_t   j               // I   last  index of the range (included)
+) {
+  // ------------------------ //
+  // 2.7.1 sequence_reverse   //  reverse v[i .. j] in place
+  // ------------------------ //
+  uint16_t val;
+
+  for ( ; i < j; i++, j--) {val= v[i]; v[i]= v[j]; v[j]= val;}
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void separator_shift (
+  duration_seq v,            // IO  separated sequence (cf. separator)
+  uint16_t   s_start,        // I   number of values in front of the second sub-sequence: s_length[0] + 2
+  uint16_t   s_count         // I   number of values of the second sub-sequence: s_length[1] + 2 ("ending" included)
+) {
+  // ----------------------- //
+  // 2.7.2 separator_shift   //  move the second sub-sequence to the front (the first one is overwritten)
+  // ----------------------- //
+  uint16_t v_ind;
+
+  for (v_ind= 1; v_ind <= s_count; v_ind++) v[v_ind]= v[s_start + v_ind];
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void categorizer_printer (
+  categories z[],            // I   categories of a successful categorization ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,            // I   categorized (corrected) signal sequence
+  uint16_t   v_length,       // I   number of signal durations (cf. categorizer: sequence_length)
+  uint8_t    uint8buf32[],   // X   uint8_t  buffer
+  uint16_t   uint16buf64[]   // X   uint16_t buffer
+) {
+  // ************************* //
+  // 2.8 categorizer_printer   //  print a categorization (CATEGORIZER_OUTPUT), an optional consumer of categorizer()
+  // ************************* //
+  STAGE_MARK(STAGE_PRINTER);
+#if (CATEGORIZER_OUTPUT != RESULT_OUTPUT)
+  _psln(F(""));
+#endif
+#if (CATEGORIZER_OUTPUT == FRAME_OUTPUT)
+  _psln(F("Merged Frames"));
+  frame_merger (z, v, v_length, uint16buf64);
+#elif (CATEGORIZER_OUTPUT == BIT_OUTPUT)
+  _psln(F("Decoded Frames"));
+  protocol_decoder (z, v, v_length, uint16buf64, uint8buf32);
+#elif (CATEGORIZER_OUTPUT == PACKED_OUTPUT)
+  // decoded by offline/trace_reader.cpp: packed_sequence_reader
+  _psln(F("Packed Sequence"));
+  sequence_encoder (z, v, v_length);
+  _psln(F(""));
+#elif (CATEGORIZER_OUTPUT == SEQUENCE_OUTPUT)
+  _psln(F("Categorized Sequence"));
+  //P _psln(F("===================="));
+  sequence_printer (z, v, v_length);
+#endif
+  // RESULT_OUTPUT: nothing is printed, the caller consumes the structured result (cf. result_builder)
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
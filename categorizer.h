@@ -11,6 +11,8 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
 
   ===========================
   = Categorizer (Interface) =
@@ -18,6 +20,7 @@
 
 // Off-Line Processing
 // -------------------
+// host build: offline/Makefile (Arduino.h shim, no changes needed), or in Eclipse:
    #include <iostream>
    #include <stdio.h>
    #include <stdlib.h>
@@ -41,15 +44,40 @@
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+#include "durations.h"   // duration_seq: storage of the signal durations (DURATION_STORAGE)
+
 // dimension of buffers
 #define DIM_64    64  // dim uint16buf64
 #define DIM_32    32  // dim uint8buf32
+#define DIM_T     (NV / 8)  // dim trusted: packed trusted-position bits (1 bit per signal duration)
+// memory profile: trace length against cluster capacity (cf. arena.h: RAM report)
+#define SMALL_PROFILE    0    // short traces (remote controls): 256 durations, frees ~ 550 bytes
+#define DEFAULT_PROFILE  1    // 512 durations, 8 clusters, 16 outliers
+#define LARGE_PROFILE    2    // rich protocols: 12 clusters, 24 outliers, the trace is shortened to 448 durations
+#define MEMORY_PROFILE   DEFAULT_PROFILE
 // dimension of the trace
-#define NV  512       // number of signal durations (HIGH- plus LOW- duration values)
 // dimensions < 256!
-#define NC    8       // dim cluster       :  number of clusters
-#define NA    8       // dim aggreg        :  number of aggregations
-#define NO   16       // dim outlier_ind   :  number of outliers
+#if (MEMORY_PROFILE == SMALL_PROFILE)
+  #define NV_16  256  // number of signal durations (HIGH- plus LOW- duration values) stored in 16 bits
+  #define NC    6     // dim cluster       :  number of clusters
+  #define NA    6     // dim aggreg        :  number of aggregations
+  #define NO   12     // dim outlier_ind   :  number of outliers
+#elif (MEMORY_PROFILE == LARGE_PROFILE)
+  #define NV_16  448
+  #define NC   12
+  #define NA   12
+  #define NO   24
+#else
+  #define NV_16  512
+  #define NC    8
+  #define NA    8
+  #define NO   16
+#endif
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  #define NV  (NV_16 / 8 * 15)   // 9 instead of 16 bits per duration in about the same RAM (cf. durations.h)
+#else
+  #define NV  NV_16
+#endif
 #define NM   2*NO     // dim m_outlier_ind <= DIM_64 : number of merged HIGH- and LOW- outliers
 #define NB   32       // dim bin_count     <= DIM_32 : number of bins per histogram
 #define NH   2*NB     // dim h_hit_ind     <= DIM_64 : number of first bin-hits (if not enough memory: NH= 32
@@ -68,10 +96,134 @@
 #define FIRST_HITS      2   // histogram: the first 2 bin hits are recorded
 #define MIN_SIZE        3   // histogram: minimum number of elements required to constitute a cluster
 #define REL_DELTA      50   // relative delta per thousand (‰)
+// categorizer parameters (categorizer_parameters): the constants above and the classifier options below
+#define FIXED_PARAMETERS     0    // the defaults are compiled in (constant folded, the passed parameters are not read)
+#define TUNABLE_PARAMETERS   1    // read from the parameters passed to categorizer() (receiver.ino: setup)
+#define PARAMETER_MODE   FIXED_PARAMETERS
+#ifdef HOST_TUNING
+  // host parameter sweep (offline/batch.cpp)
+  #undef  PARAMETER_MODE
+  #define PARAMETER_MODE   TUNABLE_PARAMETERS
+#endif
+#define BORDER_WIDTH_MAX   16   // tunable: range of the border width [2, BORDER_WIDTH_MAX]
+// static state (caches, tables, bit output): per worker thread in the host batch runner (offline/batch.cpp)
+#ifdef HOST_THREADS
+  #define THREAD_LOCAL  thread_local
+#else
+  #define THREAD_LOCAL
+#endif
+// histogram bin filling (clusterer)
+#define MULTI_PASS_HISTOGRAM   0    // one scan of the sequence per histogram
+#define SINGLE_PASS_HISTOGRAM  1    // one scan: log-scaled bucket sort of the filtered values (NV/2 bytes of RAM),
+                                    // each histogram is filled from the buckets covering its value range
+#define HISTOGRAM_MODE   MULTI_PASS_HISTOGRAM
+#define NL             64   // single pass: number of log-scaled buckets (<= DIM_64)
 // classifier option
 #define C_OPT_2 2     // relative delta: 25.00 %   outlier separation
 #define C_OPT_3 3     // relative delta: 12.50 %
 #define C_OPT_4 4     // relative delta:  6.25 %   test; resorber option
+#define C_OPT_MAX 7   // tunable: range of the options [1, C_OPT_MAX] (relative delta 2 ** -option)
+// classifier (cf. categorizer_lib.cpp: classifier, lookup_builder)
+#define LINEAR_CLASSIFIER  0    // the clusters and the aggregations are searched for each value
+#define LOOKUP_CLASSIFIER  1    // cluster matches of the category option (C_OPT_3) by binary search of the value ranges
+                                // built once per clustering (4 * NC + 1 bytes per categories), the others: linear
+#define CLASSIFIER_MODE    LINEAR_CLASSIFIER
+// trusted positions (cf. trusted_mask): the value and its neighbors of the same sequence are reliable
+#define TRUSTED(t, i)   ((t)[(i) >> 3] & (1 << ((i) & 7)))
+// stream classifier (continuous reception)
+#define STREAM_WINDOW   64  // number of values per outlier rate window
+#define STREAM_OUTLIERS  8  // re-clustering if a window contains more outliers (12.5 %)
+// categorizer output
+#define SEQUENCE_OUTPUT    0    // the whole categorized sequence (sequence_printer)
+#define FRAME_OUTPUT       1    // each distinct frame once with its repeat count (frame_merger)
+#define PACKED_OUTPUT      2    // the categorized sequence at 3 - 4 bits per value (cf. codec.cpp: sequence_encoder)
+#define BIT_OUTPUT         3    // the bit payload of each frame, decoded by the recognized protocol (protocol_decoder)
+#define RESULT_OUTPUT      4    // nothing printed: the caller consumes the structured result (categorizer_result)
+#define CATEGORIZER_OUTPUT SEQUENCE_OUTPUT
+#define NF             16   // frame merger: number of frames per trace (4 * NF <= DIM_64)
+#define FRAME_TOLERANCE 1   // frame merger: tolerated number of certain mismatches between repeats
+#define FRAME_GAP      10   // frame merger: a LOW of FRAME_GAP times the lowest LOW cluster center separates two frames
+// frame merger: certain symbol (category index or top-value), cf. category_symbol
+#define FRAME_CERTAIN(c)  (((c) != '?') && ((c) != '-') && ((c) != ' '))
+// protocol decoder: encodings recognized from the data levels (the most populated clusters of each level)
+#define PROTOCOL_UNKNOWN     0  // no known encoding: the categorized sequence is printed instead
+#define PROTOCOL_PWM         1  // pulse width: 2 HIGH levels (short: 0, long: 1), the LOW completes the period
+#define PROTOCOL_PPM         2  // pulse distance: 1 HIGH level, 2 LOW levels (short: 0, long: 1)
+#define PROTOCOL_MANCHESTER  3  // 1T / 2T on both levels: half bits HIGH-LOW: 1, LOW-HIGH: 0
+#define PROTOCOL_NONE        2  // protocol_level: neither short (0) nor long (1), e.g. sync pulses and gaps
+#define NP              4   // number of learned protocol signatures
+#define PROTOCOL_SHARE  8   // data level: a cluster of at least 1 / PROTOCOL_SHARE of the clustered values of its level
+#define PROTOCOL_MIN_BITS 4 // shorter data runs are skipped (end pulses, preambles)
+#define PROTOCOL_BYTES 16   // bit payload per data run (2 * PROTOCOL_BYTES <= DIM_32): longer frames are truncated
+// category cache (repeated transmissions)
+#define NO_CATEGORY_CACHE  0    // every trace is clustered by histograms
+#define CATEGORY_CACHE     1    // the clusters of recent traces are tried first (NK entries of ~ 100 bytes of RAM)
+#define CATEGORY_CACHING   NO_CATEGORY_CACHE
+#define NK              2   // number of cache entries
+#define CACHE_OUTLIERS  4   // cache hit: maximum number of trusted non-border values outside the cached clusters (per level)
+#define CACHE_ROUNDING  4   // signature: cluster centers rounded to 2 ** CACHE_ROUNDING
+// pre-screen (receiver.ino: before the hand-off of a recorded slot, cf. prescreener)
+#define NO_PRESCREEN       0    // every reception is reported and categorized
+#define PRESCREEN          1    // receptions predicted unclusterable (noise) are counted and skipped
+#define PRESCREEN_VERIFY   2    // debug: the prediction is reported and checked against the categorizer return code
+#define PRESCREEN_MODE     NO_PRESCREEN
+#define PRESCREEN_BINS    16    // bins per level (2 * PRESCREEN_BINS <= DIM_32): half octaves (2 significant bits) from PRESCREEN_FLOOR
+#define PRESCREEN_FLOOR   32    // lowest value of the first bin, a power of 2 (smaller values and values above the bins, e.g. gaps, are not counted)
+#define PRESCREEN_RUN      8    // unclusterable: PRESCREEN_RUN consecutive bins of at least MIN_SIZE values (a continuum of values)
+#define PRESCREEN_UNRELIABLE 4  // unclusterable: more than 1 / PRESCREEN_UNRELIABLE of the values are unreliable
+// structured result (cf. result_builder): one code per position, the symbol of the sequence_printer
+#define RESULT_INDEX      0x1F  // category index (clusters, then aggregations: cf. classifier), or a special index:
+#define RESULT_NONE       0x1F  //   "?" unclassified: no matching category
+#define RESULT_ZERO       0x1E  //   " " zero duration (spike / drop)
+#define RESULT_BELOW      0x20  // "-" flag: unclassified, lower than the floor of the lowest category (index RESULT_NONE)
+#define RESULT_TOP        0x40  // "*" flag: above the separator barrier, e.g. a pause (index RESULT_NONE)
+#define RESULT_UNRELIABLE 0x80  // "!" flag: the value is unreliable
+#define RESULT_CATEGORY(c)  (((c) & RESULT_INDEX) < RESULT_ZERO)   // the code is a category index
+// the codes in place of the durations: the bytes of the duration storage
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  #define RESULT_STORAGE(v)  ((v).code)
+#else
+  #define RESULT_STORAGE(v)  ((uint8_t *)(v))
+#endif
+// channel key of a trace: frequency (FRQ units, 24 bits) and reference HIGH strength (rounded to 4 dB)
+#define CACHE_KEY(frequency, ref_strength_high)  \
+  ((((uint32_t)(ref_strength_high) >> 2) << 24) | ((uint32_t)(frequency) & 0xFFFFFFUL))
+
+// dimension constraints
+// =====================
+#if ((NC > 255) || (NA > 255) || (NO > 255))
+  #error "categorizer.h: NC, NA and NO are uint8_t dimensions"
+#endif
+#if (NC + NA > RESULT_ZERO)
+  #error "categorizer.h: the category indices NC + NA must fit RESULT_INDEX"
+#endif
+#if (NC + NA > 36)
+  #error "categorizer.h: NC + NA > 36, category indices are printed as one character (0 .. 9, a .. z)"
+#endif
+#if ((NM > DIM_64) || (NH > DIM_64) || (NL > DIM_64) || (4 * NF > DIM_64))
+  #error "categorizer.h: NM, NH, NL and 4 * NF must fit into uint16buf64 (DIM_64)"
+#endif
+#if ((NB > DIM_32) || (2 * PROTOCOL_BYTES > DIM_32) || (2 * PRESCREEN_BINS > DIM_32))
+  #error "categorizer.h: NB, 2 * PROTOCOL_BYTES and 2 * PRESCREEN_BINS must fit into uint8buf32 (DIM_32)"
+#endif
+#if ((PRESCREEN_BINS % 2 != 0) || ((PRESCREEN_FLOOR << (PRESCREEN_BINS / 2)) > CEIL) || (PRESCREEN_FLOOR < 4))
+  #error "categorizer.h: pre-screen bins out of range (PRESCREEN_BINS even, PRESCREEN_FLOOR >= 4, bins below CEIL)"
+#endif
+#if (NV % 8 != 0)
+  #error "categorizer.h: NV must be a multiple of 8 (packed trusted positions)"
+#endif
+#if ((HISTOGRAM_MODE == SINGLE_PASS_HISTOGRAM) && (NV / 2 > 256))
+  #error "categorizer.h: single pass histogram: the positions of one level (NV / 2) are uint8_t"
+#endif
+#if ((HISTOGRAM_MODE == SINGLE_PASS_HISTOGRAM) && (NH < 2 * NB))
+  #error "categorizer.h: single pass histogram: two first hits per bin are held in h_hit_ind (NH >= 2 * NB)"
+#endif
+#if ((NV < 4 * BORDER_WIDTH) || (NV + 5 > 65535U))
+  #error "categorizer.h: NV out of range"
+#endif
+#if ((PARAMETER_MODE == TUNABLE_PARAMETERS) && ((NV < 4 * BORDER_WIDTH_MAX) || (BORDER_WIDTH > BORDER_WIDTH_MAX)))
+  #error "categorizer.h: tunable border width: NV < 4 * BORDER_WIDTH_MAX or BORDER_WIDTH > BORDER_WIDTH_MAX"
+#endif
 
 // categorizer return codes
 // ========================
@@ -86,7 +238,7 @@
 #define CRC_6 6       // unclusterable: too many hits in histogram
 #define CRC_7 7       // unclusterable: no cluster
 #define CRC_8 8       // unclusterable: overlapping clusters
-#define CRC_9 9       //
+#define CRC_9 9       // cache miss: the trace does not fit the cached clusters (internal, followed by histogram clustering)
 // fatal errors (program errors that should never occur)
 #define CRC_10 10     // fatal error: histogram bin range error
 #define CRC_11 11     // fatal error: bin_start_ind error error
@@ -116,25 +268,136 @@ typedef struct {
   uint16_t separator_barrier;     // barrier between ordinary values and exceptionally big values (gap of factor ten)
   // inliers
   uint8_t  inlier_count;          // number of tolerated empty-bin-subsequences encountered within the bin sequence of a cluster
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+  // classifier lookup (C_OPT_3, cf. lookup_builder): the values of which the cluster [c_ind] is the matching category
+  uint8_t  lookup_size;           // number of value ranges (= cluster_size; 0: not built)
+  uint16_t lookup_floor[NC];      // [lookup_floor, lookup_ceil): sorted, disjoint, within the zone of the nearest cluster
+  uint16_t lookup_ceil[NC];
+#endif
 } categories;
 
-// categorize signal durations into clusters of duration levels (HIGH/LOW processed separately)
-int8_t categorizer (categories duration_category[], uint16_t signal_sequence[], uint16_t signal_count, uint16_t unreliable_count, uint8_t &error_code,
-                    uint8_t uint8buf32[], uint16_t uint16buf64[]);
+typedef struct {
+  // categorizer parameters (defaults: CATEGORIZER_DEFAULTS), read with CP (PARAMETER_MODE)
+  // the category option C_OPT_3 is not tunable: the output stages and the codecs (sequence_printer, stream_classifier,
+  // protocol_decoder, codec.cpp) must classify as the clusterer and the corrector do
+  uint8_t  border_width;          // BORDER_WIDTH  [2, BORDER_WIDTH_MAX]
+  uint16_t start_val;             // START_VAL
+  uint8_t  max_holes;             // MAX_HOLES
+  uint8_t  first_hits;            // FIRST_HITS    [1, 2] (NH = 2 * NB)
+  uint8_t  min_size;              // MIN_SIZE      >= 1
+  uint8_t  outlier_option;        // classifier option of the outlier separation (corrector: C_OPT_2)
+  uint8_t  resorber_option;       // classifier option of a close best-fit (resorber: C_OPT_4)
+} categorizer_parameters;
+
+#define CATEGORIZER_DEFAULTS  {BORDER_WIDTH, START_VAL, MAX_HOLES, FIRST_HITS, MIN_SIZE, C_OPT_2, C_OPT_4}
+// parameter p of the categorizer_parameters cp, e.g. CP(cp, min_size)
+// fixed: the default constant of p (cf. CP_min_size); tunable: the field of cp
+#if (PARAMETER_MODE == TUNABLE_PARAMETERS)
+  #define CP(cp, p)   ((cp).p)
+#else
+  #define CP(cp, p)   (CP_##p)
+#endif
+#define CP_border_width     BORDER_WIDTH
+#define CP_start_val        START_VAL
+#define CP_max_holes        MAX_HOLES
+#define CP_first_hits       FIRST_HITS
+#define CP_min_size         MIN_SIZE
+#define CP_outlier_option   C_OPT_2
+#define CP_resorber_option  C_OPT_4
+
+typedef struct {
+  // counters of the stream classifier (continuous reception)
+  uint32_t value_count;           // number of streamed values
+  uint32_t outlier_count;         // number of streamed values that could not be classified
+  uint16_t recluster_count;       // number of requested re-clusterings
+  uint8_t  window_count;          // number of values in the current window
+  uint8_t  window_outliers;       // number of outliers in the current window
+} stream_state;
+
+typedef struct {
+  // clusters of one level (HIGH / LOW) of a cached categorization
+  uint8_t  cluster_size;          // number of clusters (0: empty entry)
+  uint16_t cluster_ceil[NC];      // cf. categories
+  uint16_t cluster_center[NC];
+  uint16_t cluster_floor[NC];
+} cluster_set;
+
+typedef struct {
+  // category cache entry: the clusters of a recent, successfully categorized trace
+  uint32_t    key;                // channel key (CACHE_KEY)
+  uint8_t     age;                // number of categorizations since the last use (replacement of the oldest entry)
+  cluster_set level[2];           // [1]: HIGH-durations clusters, [0]: LOW-durations clusters
+} cache_entry;
+
+typedef struct {
+  // counters of the category cache
+  uint16_t hit_count;             // number of traces classified against a cached entry (no histograms)
+  uint16_t miss_count;            // number of traces clustered by histograms
+} cache_stats;
+
+typedef struct {
+  // structured result of a successful categorization (cf. result_builder): no printing, no extra buffer
+  categories *z;                  // categories of the categorizer ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  uint8_t    *code;               // code[1 .. length]: result code per position (RESULT_INDEX and flags)
+  uint16_t    length;             // number of positions (the "ending" included, if it is a pause)
+} categorizer_result;
+
+typedef struct {
+  // learned protocol signature: encoding and data levels of a recently decoded trace
+  uint8_t  encoding;              // PROTOCOL_PWM .. PROTOCOL_MANCHESTER (PROTOCOL_UNKNOWN: empty entry)
+  uint8_t  age;                   // number of decodings since the last use (replacement of the oldest entry)
+  uint16_t center[2][2];          // data level centers [1]: HIGH, [0]: LOW; [0]: short, [1]: long (one level: equal)
+  uint16_t hit_count;             // number of traces decoded by a lookup of this signature
+} protocol_signature;
+
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+extern THREAD_LOCAL cache_stats cache_counters;    // accumulated since their last reset (cf. receiver.ino: processing)
+extern THREAD_LOCAL cache_entry category_cache[NK];   // seeded with the stored profiles (cf. store.cpp: store_begin)
+#endif
+#if (CATEGORIZER_OUTPUT == BIT_OUTPUT)
+extern THREAD_LOCAL protocol_signature protocol_table[NP];   // learned signatures (cf. protocol_decoder)
+#endif
+
+// categorize signal durations into clusters of duration levels (HIGH/LOW processed separately), nothing is printed:
+// the consumers of a successful categorization follow (categorizer_printer, result_builder)
+int8_t categorizer (categories duration_category[], duration_seq signal_sequence, uint16_t signal_count, uint16_t unreliable_count, uint32_t cache_key,
+                    const categorizer_parameters &cp, uint8_t &error_code, uint8_t uint8buf32[], uint16_t uint16buf64[], uint8_t trusted[]);
+
+bool stream_classifier (categories z[], stream_state &s, uint16_t v_val, uint8_t z_ind);
+bool prescreener       (duration_seq v, uint16_t v_length, uint16_t unreliable_count, uint8_t bin_count[]);
+bool separator         (duration_seq v, uint16_t v_length, const uint8_t transmitter[], uint16_t s_length[], uint16_t s_unreliable[]);
+    void sequence_reverse (duration_seq v, uint16_t i, uint16_t j);
+    void separator_shift  (duration_seq v, uint16_t s_start, uint16_t s_count);
+void categorizer_printer (categories z[], duration_seq v, uint16_t v_length, uint8_t uint8buf32[], uint16_t uint16buf64[]);
 
 bool sequence_reader  (uint16_t signal_duration[], uint16_t &sequence_length, uint16_t &unreliable_count);
-void clusterer        (categories &z,  uint16_t v[], uint16_t v_start_ind, uint16_t v_stop_ind, bool    &overlap_flag, uint8_t &rc, uint8_t uint8buf32[], uint16_t uint16buf64[]);
-void corrector        (categories z[], uint16_t v[], uint16_t v_length, uint16_t unreliable_count, uint8_t &rc, uint16_t uint16buf64[]);
-    bool extractor    (uint16_t   v[], uint16_t v_stop_ind, uint16_t &v_ind, uint16_t &ss_start_ind, uint16_t &ss_stop_ind);
-    bool resorber     (categories &z,  uint16_t v[], uint16_t u[], uint16_t ss_start_ind, uint16_t ss_stop_ind, uint16_t &rel_delta, uint8_t &rc);
-    void aggregator   (categories &z,  uint16_t v[], uint8_t  v_min_count, uint8_t &rc);
+void clusterer        (categories &z,  duration_seq v, uint16_t v_start_ind, uint16_t v_stop_ind, cluster_set *cached, const categorizer_parameters &cp, bool &overlap_flag, uint8_t &rc, uint8_t uint8buf32[], uint16_t uint16buf64[], uint8_t trusted[]);
+void corrector        (categories z[], duration_seq v, uint16_t v_length, uint16_t unreliable_count, const categorizer_parameters &cp, uint8_t &rc, uint16_t uint16buf64[], uint8_t trusted[]);
+    bool extractor    (duration_seq v, uint8_t trusted[], uint16_t v_stop_ind, uint16_t &v_ind, uint16_t &ss_start_ind, uint16_t &ss_stop_ind);
+    bool resorber     (categories &z,  duration_seq v, uint16_t u[], uint16_t ss_start_ind, uint16_t ss_stop_ind, const categorizer_parameters &cp, uint16_t &rel_delta, uint8_t &rc);
+    void aggregator   (categories &z,  duration_seq v, uint8_t  v_min_count, uint8_t &rc);
 bool classifier       (categories &z,  uint16_t v_val, uint8_t &c_ind, uint16_t &c_val, uint8_t option);
-void sequence_printer (categories z[], uint16_t v[], int16_t v_length);
-void category_printer (categories &z,  uint16_t v[]);
+    void lookup_builder (categories &z, uint8_t option);
+void frame_merger     (categories z[], duration_seq v, int16_t v_length, uint16_t uint16buf64[]);
+    uint8_t frame_mismatches (categories z[], duration_seq v, uint16_t a_start, uint16_t b_start, uint16_t f_length);
+    char    frame_vote       (categories z[], duration_seq v, uint16_t f_start[], uint16_t f_group[], uint8_t f_size,
+                              uint8_t g_ind, uint16_t p_ind, uint8_t z_ind, bool &reliable);
+    uint8_t frame_splitter   (categories z[], duration_seq v, int16_t v_length, uint16_t f_start[], uint16_t f_length[]);
+void protocol_decoder (categories z[], duration_seq v, int16_t v_length, uint16_t uint16buf64[], uint8_t uint8buf32[]);
+    uint8_t  protocol_analyzer (categories z[], duration_seq v, uint16_t f_start[], uint16_t f_length[], uint8_t f_size, protocol_signature &p);
+    uint8_t  protocol_level    (protocol_signature &p, uint8_t z_ind, uint16_t v_val);
+    uint16_t frame_bits        (protocol_signature &p, duration_seq v, uint16_t &p_ind, uint16_t p_stop, uint8_t bits[]);
+void sequence_printer (categories z[], duration_seq v, int16_t v_length);
+char category_symbol  (categories &z,  uint16_t v_val);
+void result_builder   (categories z[], duration_seq v, int16_t v_length, uint8_t r_code[], categorizer_result &r);
+    uint8_t category_result (categories &z, uint16_t v_val);
+void category_table_printer (categories z[]);
+void category_printer (categories &z,  duration_seq v);
 
 void sort (uint16_t s[], uint16_t n);
-void index_sort (uint16_t v[], uint16_t v_ind[], uint16_t n);
+void index_sort (duration_seq v, uint16_t v_ind[], uint16_t n);
 void merge (uint16_t a[], uint8_t na, uint16_t b[], uint8_t nb, uint16_t c[], uint8_t &nc);
-void statistics (categories &z, uint16_t v[], uint16_t v_start_ind, uint16_t v_stop_ind);
+void statistics (categories &z, duration_seq v, uint8_t trusted[], uint16_t v_start_ind, uint16_t v_stop_ind);
+void trusted_mask (duration_seq v, uint16_t sequence_length, uint8_t trusted[]);
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -15,6 +15,8 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
 
   ==========================
   = 3. Categorizer Library =
@@ -24,20 +26,27 @@
   3.2 resorber  : resorb spikes and drops
   3.3 aggregator: aggregate border outliers (L1), resistant outliers (L2) and untrusted top-outliers (L2)
   3.4 classifier: find the nearest category (comprising clusters and aggregations)
+  3.4.1 lookup_builder: value ranges of the cluster matches (LOOKUP_CLASSIFIER)
   3.5 sequence_printer: map the raw data into a categorized sequence (category indices)
+  3.5.1 category_symbol: symbol of a value (category index or special category mark)
+  3.5.2 category_table_printer: print the category centers
+  3.5.3 result_builder: the structured result, one code per position (in place of the durations)
+  3.5.4 category_result: result code of a value (category index or special category flags)
   3.6 category_printer: print the categories (clusters and aggregations)
   3.7 Helper
-  3.7.1 sort: insertion sort (ascending)
-  3.7.2 index_sort: index insertion sort (ascending)
+  3.7.1 sort: sorting network (n <= 6) or insertion sort (ascending)
+  3.7.2 index_sort: index insertion sort (ascending), keys cached with LOG8_DURATIONS
   3.7.3 merge: merging of sorted arrays (without doubles)
   3.7.4 statistics: compute mean, median and absolute deviation
-  3.7.5 miscellaneous
+  3.7.5 trusted_mask: packed trusted positions (value and neighbors reliable)
+  3.7.6 miscellaneous
 
 */
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 bool extractor (           //     return true, if a valid subsequence has been found
-  uint16_t   v[],          // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  duration_seq v,          // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  uint8_t    trusted[],    // I   packed trusted positions (cf. trusted_mask)
   uint16_t   v_stop_ind,   // I   stop  index of v[] (included)
   uint16_t  &v_ind,        // IO  current extractor index position in the array of values (scan progress)
   uint16_t  &ss_start_ind, // O   first index of the subsequence of unreliable elements
@@ -50,15 +59,20 @@ bool extractor (           //     return true, if a valid subsequence has been f
   // start the subsequence with the element in front of the next unreliable value
   // end   the subsequence with the element after the last unreliable value
   // note:
-  // - v_ind >= 2, because v_ind starts at BORDER_WIDTH + 1
+  // - v_ind >= 2, because v_ind starts at the border width + 1
   // - the subsequence length is intentionally not checked here but later in the resorber
   // - a reliable element must be found before or at v_stop_ind
+  // - trusted positions are reliable: 8 trusted positions in a row (a full mask byte) are skipped at once
+  //   (the corrector never flags a value, the mask remains valid ahead of v_ind)
 
   ss_start_ind= 0;
   ss_stop_ind=  0;
 
   // find the next start index of the subsequence
   for ( ; v_ind <= v_stop_ind - 2; v_ind++) {
+    // byte-at-a-time skipping
+    while (((v_ind & 7) == 0) && (trusted[v_ind >> 3] == 0xFF) && (v_ind + 8 <= v_stop_ind - 2)) v_ind+= 8;
+    if (TRUSTED(trusted, v_ind)) continue;
     if ((v[v_ind] & LSB) == UNRELIABLE) {
       ss_start_ind= v_ind - 1;
       goto FIND_STOP_INDEX;
@@ -84,10 +98,11 @@ FIND_STOP_INDEX:
 
 bool resorber (              //    return true on successful correction of a spike or a drop
     categories &z,           // I  categories of the central triple (either HIGH- or LOW- raw data values)
-    uint16_t  v[],           // IO flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+    duration_seq v,          // IO flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
     uint16_t  ss_cat[],      // I  category values (centers) of the subsequence
     uint16_t  ss_start_ind,  // I  start index of the quintuple
     uint16_t  ss_stop_ind,   // I  stop  index of the quintuple
+    const categorizer_parameters &cp,  // I  categorizer parameters (CP)
     uint16_t &rel_delta,     // IO I: best-fit; O: smaller relative delta of resorber and best-fit
     uint8_t  &rc             // O  return_code (0: no error)
 ) {
@@ -119,7 +134,7 @@ bool resorber (              //    return true on successful correction of a spi
   // initialize
   rel_delta_bestfit= rel_delta;
   if (rel_delta_bestfit > 100) option= C_OPT_3;  // (12.5 %)
-  else option= C_OPT_4;  // (6.25 %)
+  else option= CP(cp, resorber_option);  // (C_OPT_4: 6.25 %)
   v_ind= ss_start_ind;
 
   // check whether the central triple is classifiable
@@ -191,7 +206,7 @@ bool resorber (              //    return true on successful correction of a spi
 
 void aggregator (
     categories &z,          // I  categories of the central triple (either HIGH- or LOW- raw data values)
-    uint16_t v[],           // IO flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+    duration_seq v,         // IO flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
     uint8_t v_min_count,    // I  required minimum number of elements (MIN_SIZE)
     uint8_t &rc             // O  return_code (0: no error)
 ) {
@@ -329,6 +344,29 @@ bool classifier (      //     returns true, if a matching cluster or aggregation
   uint16_t d1;      // distance to the above cluster (current)
   uint16_t d2;      // distance to the below cluster
   uint16_t delta;   // = abs( v_val - cat_val )
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+  uint8_t  l_low;   // binary search of the lookup ranges
+  uint8_t  l_high;
+  uint8_t  l_mid;
+
+  // (0) lookup of the cluster matches (cf. lookup_builder)
+  // -----------------------------------
+  // the first range whose ceil is above v_val; outside of the ranges: (A) and (B)
+  if ((option == C_OPT_3) && (z.lookup_size > 0)) {
+    l_low= 0;
+    l_high= z.lookup_size;
+    while (l_low < l_high) {
+      l_mid= (l_low + l_high) >> 1;
+      if (v_val < z.lookup_ceil[l_mid]) l_high= l_mid;
+      else l_low= l_mid + 1;
+    }
+    if ((l_low < z.lookup_size) && (v_val >= z.lookup_floor[l_low])) {
+      cat_ind= l_low;
+      cat_val= z.cluster_center[l_low];
+      return (true);
+    }
+  }
+#endif
 
   cat_ind= 0;
   cat_val= 0;
@@ -424,11 +462,68 @@ CONTINUE_WITH_AGGREGATIONS:
 }
 // END classifier
 
+#if (CLASSIFIER_MODE == LOOKUP_CLASSIFIER)
+void lookup_builder (
+  categories &z,       // IO  the clusters (sorted, final) -> the lookup ranges
+  uint8_t   option     // I   tightness of the classifier (the lookup answers this option only)
+) {
+  // -------------------- //
+  // 3.4.1 lookup_builder //  value ranges of the cluster matches
+  // -------------------- //
+  // the range of cluster c_ind holds the values of which classifier (A) returns true with c_ind:
+  // - the zone of the nearest cluster: the gap between two clusters is divided at the midpoint of their centers
+  // - within the zone: the cluster itself [floor, ceil) and the values near enough to the center (option)
+  // the ranges do not depend on the aggregations, (A) returns before (B): the aggregator does not invalidate them;
+  // a value outside of the ranges is classified linearly (the lookup only shortcuts the matches)
+  uint8_t  c_ind;         // index of cluster
+  uint16_t center;        // cluster mean value
+  uint16_t delta;         // near enough: abs(v_val - center) < delta
+  uint32_t zone_floor;    // zone of the nearest cluster [zone_floor, zone_ceil)
+  uint32_t zone_ceil;
+  uint32_t near_floor;    // near enough to the center [near_floor, near_ceil)
+  uint32_t near_ceil;
+  uint32_t r_floor;       // range of c_ind
+  uint32_t r_ceil;
+
+  for (c_ind= 0; c_ind < z.cluster_size; c_ind++) {
+    center= z.cluster_center[c_ind];
+    delta= center >> option;
+    // (A): v_val >= midpoint + 1 belongs to the upper cluster (d1 < d2), the zone is limited by the clusters
+    if (c_ind == 0) zone_floor= 0;
+    else {
+      zone_floor= ((uint32_t)z.cluster_center[c_ind - 1] + center) / 2 + 1;
+      if (zone_floor > z.cluster_floor[c_ind]) zone_floor= z.cluster_floor[c_ind];
+      if (zone_floor < z.cluster_ceil[c_ind - 1]) zone_floor= z.cluster_ceil[c_ind - 1];
+    }
+    if (c_ind == z.cluster_size - 1) zone_ceil= CEIL_U;
+    else {
+      zone_ceil= ((uint32_t)center + z.cluster_center[c_ind + 1]) / 2 + 1;
+      if (zone_ceil > z.cluster_floor[c_ind + 1]) zone_ceil= z.cluster_floor[c_ind + 1];
+      if (zone_ceil < z.cluster_ceil[c_ind]) zone_ceil= z.cluster_ceil[c_ind];
+    }
+    // the cluster, then the values near enough to the center, if both ranges join
+    r_floor= max((uint32_t)z.cluster_floor[c_ind], zone_floor);
+    r_ceil=  min((uint32_t)z.cluster_ceil[c_ind], zone_ceil);
+    near_floor= max((uint32_t)center + 1 - delta, zone_floor);
+    near_ceil=  min((uint32_t)center + delta, zone_ceil);
+    if ((near_floor < near_ceil) && (near_floor <= r_ceil) && (near_ceil >= r_floor)) {
+      r_floor= min(r_floor, near_floor);
+      r_ceil=  max(r_ceil, near_ceil);
+    }
+    if (r_ceil < r_floor) r_ceil= r_floor;
+    z.lookup_floor[c_ind]= r_floor;
+    z.lookup_ceil[c_ind]=  r_ceil;
+  }
+  z.lookup_size= z.cluster_size;
+}
+// END lookup_builder
+#endif
+
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 void sequence_printer (
   categories z[],    // I   categories of raw data values  ([1]: HIGH-duration_categories, [0]: LOW-duration_categories)
-  uint16_t v[],      // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  duration_seq v,    // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
   int16_t  v_length  // I   number of signal durations
 ) {
   // ******************** //
@@ -447,8 +542,6 @@ void sequence_printer (
   int16_t  j, k;
   uint8_t  z_ind;   // signal level index (either HIGH or LOW)
   int16_t  v_ind;   // index of signal sequence
-  uint8_t  cat_ind; // index of current category (combined clusters and aggregations)
-  uint16_t cat_val; // value of current category (combined clusters and aggregations)
 
   // end handling
   // ------------
@@ -502,27 +595,7 @@ void sequence_printer (
         _ps(" ");
         continue;
       }
-      // check whether the current value is above the barrier (includes CEIL!)
-      if (v[v_ind] >= z[z_ind].separator_barrier) {
-        _ps(F("*"));
-        continue;
-      }
-      // check whether the current value is classifiable
-      // !!! use the same C_OPT as in border values classification !!!
-      if (classifier (z[z_ind], v[v_ind], cat_ind, cat_val, C_OPT_3)) {
-        // the nearest category is near enough
-        // the current value is classifiable
-        // cat_ind contains the index of the category corresponding to v_val
-        if (cat_ind < 10) _pd(cat_ind);
-        // use characters for indices >= 10  ('a' = 97; 97 - 10 = 87)
-        else _pc(87 + cat_ind);
-        continue;
-      }
-      // the current value is not classifiable
-      // check whether it is smaller than the smallest category
-      if ((cat_ind == 0) && (v[v_ind] < cat_val)) _ps(F("-"));
-      else _ps(F("?"));
-
+      _pc(category_symbol (z[z_ind], v[v_ind]));
     }
     _psln("");
     if (z_ind == LOW ) break;
@@ -545,6 +618,39 @@ void sequence_printer (
   _psln("");
 
 
+  category_table_printer (z);
+}
+// END sequence_printer
+
+char category_symbol (  //     returns the print symbol of a value (category index or special category mark)
+  categories &z,        // I   categories of either HIGH- or LOW- raw data values
+  uint16_t  v_val       // I   flagged raw data value
+) {
+  // ********************* //
+  // 3.5.1 category_symbol //  symbol of a value in the categorized sequence (cf. sequence_printer)
+  // ********************* //
+  uint8_t  r_code;  // result code of the value (cf. category_result)
+
+  r_code= category_result (z, v_val);
+  if (r_code & RESULT_TOP) return ('*');
+  if (r_code & RESULT_BELOW) return ('-');
+  r_code&= RESULT_INDEX;
+  if (r_code == RESULT_ZERO) return (' ');
+  if (r_code == RESULT_NONE) return ('?');
+  // use characters for indices >= 10  ('a' = 97; 97 - 10 = 87)
+  return ((r_code < 10) ? '0' + r_code : 87 + r_code);
+}
+// END category_symbol
+
+void category_table_printer (
+  categories z[]     // I   categories of raw data values  ([1]: HIGH-duration_categories, [0]: LOW-duration_categories)
+) {
+  // **************************** //
+  // 3.5.2 category_table_printer //  print the category centers (cf. sequence_printer, frame_merger)
+  // **************************** //
+  uint8_t  z_ind;   // signal level index (either HIGH or LOW)
+  uint8_t  cat_ind; // index of current category (combined clusters and aggregations)
+
   // print categories index
   // ----------------------
   _psln("");
@@ -574,14 +680,73 @@ void sequence_printer (
   }
 
 }
-// END sequence_printer
+// END category_table_printer
+
+void result_builder (
+  categories z[],    // I   categories of raw data values  ([1]: HIGH-duration_categories, [0]: LOW-duration_categories)
+  duration_seq v,    // I   flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  int16_t  v_length, // I   number of signal durations
+  uint8_t  r_code[], // O   r_code[1 .. r.length]: result code per position (may be RESULT_STORAGE(v): v is overwritten)
+  categorizer_result &r  // O   structured result
+) {
+  // ************************ //
+  // 3.5.3 result_builder     //  the categorized sequence as one code per position (no printing, cf. sequence_printer)
+  // ************************ //
+  // the code of v[v_ind] is the category index (RESULT_INDEX) and the flags of the special categories (RESULT_TOP,
+  // RESULT_BELOW) and of the reliability (RESULT_UNRELIABLE), the symbols of the sequence_printer
+  // in place: r_code[v_ind] is written after v[v_ind] has been read, it occupies the storage of v[v_ind / 2] or v[v_ind]
+  int16_t  v_ind;   // index of signal sequence
+  uint16_t v_val;   // flagged raw data value
+
+  // end handling (cf. sequence_printer)
+  if ((v[v_length + 1] != 0) && (v[v_length + 2] != 0)) {
+    v_length+= 2;
+  }
+  for (v_ind= 1; v_ind <= v_length; v_ind++) {
+    v_val= v[v_ind];
+    r_code[v_ind]= category_result (z[v_ind & 1], v_val) | (((v_val & LSB) == UNRELIABLE) ? RESULT_UNRELIABLE : 0);
+  }
+  r.z=      z;
+  r.code=   r_code;
+  r.length= v_length;
+}
+// END result_builder
+
+uint8_t category_result (  //     returns the result code of a value (category index or special category, cf. RESULT_INDEX)
+  categories &z,        // I   categories of either HIGH- or LOW- raw data values
+  uint16_t  v_val       // I   flagged raw data value
+) {
+  // ********************* //
+  // 3.5.4 category_result //  category of a value (cf. category_symbol, result_builder), the reliability is not coded
+  // ********************* //
+  uint8_t  cat_ind; // index of current category (combined clusters and aggregations)
+  uint16_t cat_val; // value of current category (combined clusters and aggregations)
+
+  // zero duration values (spikes and drops)
+  if (v_val == 0) return (RESULT_ZERO);
+  // check whether the current value is above the barrier (includes CEIL!)
+  if (v_val >= z.separator_barrier) return (RESULT_TOP | RESULT_NONE);
+  // check whether the current value is classifiable
+  // !!! use the same C_OPT as in border values classification !!!
+  if (classifier (z, v_val, cat_ind, cat_val, C_OPT_3)) {
+    // the nearest category is near enough
+    // the current value is classifiable
+    // cat_ind contains the index of the category corresponding to v_val
+    return (cat_ind);
+  }
+  // the current value is not classifiable
+  // check whether it is smaller than the smallest category
+  if ((cat_ind == 0) && (v_val < cat_val)) return (RESULT_BELOW | RESULT_NONE);
+  return (RESULT_NONE);
+}
+// END category_result
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 ///*PP
 void category_printer (
   categories &z,    // I  current categories of either HIGH- or LOW- raw data values
-  uint16_t v[]      // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  duration_seq v    // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
 ) {
   // ******************** //
   // 3.6 category_printer //  print the categories (clusters and aggregations)
@@ -633,8 +798,8 @@ void category_printer (
 // ********** //
 // 3.7 Helper //
 // ********** //
-// 3.7.1 sort: insertion sort (ascending)
-// 3.7.2 index_sort: index insertion sort (ascending)
+// 3.7.1 sort: sorting network (n <= 6) or insertion sort (ascending)
+// 3.7.2 index_sort: index insertion sort (ascending), keys cached with LOG8_DURATIONS
 // 3.7.3 merge: merging of sorted arrays (without doubles)
 // 3.7.4 statistics: compute mean, median and absolute deviation
 // 3.7.5 miscellaneous
@@ -642,16 +807,38 @@ void category_printer (
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+// compare and exchange of the sorting networks
+#define SORT_CSWAP(a, b)  if (v[a] > v[b]) {tmp= v[a]; v[a]= v[b]; v[b]= tmp;}
+
 void sort (
   uint16_t v[],   // IO  values to be sorted in ascending order
   uint16_t n      // I   number of elements in v
 ) {
   // ---------- //
-  // 3.7.1 sort //  yaneurao's insertion sort  (ascending)
+  // 3.7.1 sort //  sorting networks for the common sizes, else yaneurao's insertion sort  (ascending)
   // ---------- //
+  // most outlier sets and first bin-hits hold less than 7 values: the networks avoid the data dependent
+  // shifting of the insertion sort (optimal networks: 1, 3, 5, 9 and 12 compare and exchanges)
 
   uint16_t  i, j;
   uint16_t  tmp;
+  switch (n) {
+    case 0:
+    case 1: return;
+    case 2: SORT_CSWAP(0, 1);
+            return;
+    case 3: SORT_CSWAP(0, 2); SORT_CSWAP(0, 1); SORT_CSWAP(1, 2);
+            return;
+    case 4: SORT_CSWAP(0, 2); SORT_CSWAP(1, 3); SORT_CSWAP(0, 1); SORT_CSWAP(2, 3); SORT_CSWAP(1, 2);
+            return;
+    case 5: SORT_CSWAP(0, 3); SORT_CSWAP(1, 4); SORT_CSWAP(0, 2); SORT_CSWAP(1, 3); SORT_CSWAP(0, 1);
+            SORT_CSWAP(2, 4); SORT_CSWAP(1, 2); SORT_CSWAP(3, 4); SORT_CSWAP(2, 3);
+            return;
+    case 6: SORT_CSWAP(0, 5); SORT_CSWAP(1, 3); SORT_CSWAP(2, 4); SORT_CSWAP(1, 2); SORT_CSWAP(3, 4);
+            SORT_CSWAP(0, 3); SORT_CSWAP(2, 5); SORT_CSWAP(0, 1); SORT_CSWAP(2, 3); SORT_CSWAP(4, 5);
+            SORT_CSWAP(1, 2); SORT_CSWAP(3, 4);
+            return;
+  }
   for (i= 1; i < n; i++)
   {
     tmp= v[i];
@@ -670,16 +857,42 @@ void sort (
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 void index_sort (
-  uint16_t v[],       // I   indexed values (sort criteria)
+  duration_seq v,     // I   indexed values (sort criteria)
   uint16_t v_ind[],   // IO  index of values to be sorted
-  uint16_t n          // I   number of elements in v_ind
+  uint16_t n          // I   number of elements in v_ind (<= NO)
 ) {
   // ---------------- //
   // 3.7.2 index_sort //  yaneurao's index insertion sort  (ascending)
   // ---------------- //
+  // insertion sort is stable: outliers of equal values keep their order of appearance
+  // LOG8_DURATIONS: the keys are cached alongside the indices, v[v_ind[i]] is decoded once per element
+  // instead of twice per comparison (a 16-bit word is read directly: the cache would only cost 2 * NO bytes of stack)
 
   uint16_t  i, j;
   uint16_t  tmp_ind;
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  uint16_t  key[NO];      // cached keys: key[i] = v[v_ind[i]] (2 * NO bytes of stack)
+  uint16_t  tmp_key;
+
+  if (n > NO) n= NO;
+  for (i= 0; i < n; i++) key[i]= v[v_ind[i]];
+  for (i= 1; i < n; i++)
+  {
+    tmp_ind= v_ind[i];
+    tmp_key= key[i];
+    if (key[i-1] > tmp_key)
+    {
+      j= i;
+      do {
+      v_ind[j]= v_ind[j-1];
+      key[j]= key[j-1];
+      --j;
+      } while (j > 0 && key[j-1] > tmp_key);
+      v_ind[j]= tmp_ind;
+      key[j]= tmp_key;
+    }
+  }
+#else
   for (i= 1; i < n; i++)
   {
     tmp_ind= v_ind[i];
@@ -693,6 +906,7 @@ void index_sort (
       v_ind[j]= tmp_ind;
     }
   }
+#endif
 } // end index_sort
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -736,7 +950,8 @@ void merge (uint16_t a[], uint8_t na, uint16_t b[], uint8_t nb, uint16_t c[], ui
 /*
 void statistics (
   categories &z,
-  uint16_t v[],         // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  duration_seq v,       // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  uint8_t  trusted[],   // I  packed trusted positions (cf. trusted_mask)
   uint16_t v_start_ind, // I  start index of v[] (included)
   uint16_t v_stop_ind   // I  stop  index of v[] (included)
 ) {
@@ -777,13 +992,8 @@ void statistics (
       if (v_val <  c_floor_val) continue;
       // value filter
       if (filter) {
-        // check immediate neighborhood for unreliable values
-        // - element in front the current element
-        if ((v[v_ind+1] & LSB) == UNRELIABLE) continue;
-        // - current element
-        if ((v[v_ind  ] & LSB) == UNRELIABLE) continue;
-        // - element after the current element
-        if ((v[v_ind-1] & LSB) == UNRELIABLE) continue;
+        // value and immediate neighborhood reliable
+        if (!TRUSTED(trusted, v_ind)) continue;
       }
       // check top value range
       if (v_val >= c_ceil_val) {
@@ -832,8 +1042,43 @@ void statistics (
 */
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void trusted_mask (
+  duration_seq v,            // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  uint16_t sequence_length,  // I  total number of signal durations (index of the last LOW, < NV)
+  uint8_t  trusted[]         // O  packed trusted positions: bit (v_ind & 7) of trusted[v_ind >> 3]
+) {
+  // ------------------ //
+  // 3.7.5 trusted_mask //  packed trusted positions: the value and its immediate neighbors are reliable
+  // ------------------ //
+  // computed once per trace, replaces the neighborhood filter of every histogram pass, of the border
+  // processing and of the statistics; the extractor skips trusted positions
+  // the HIGH- and LOW- sequences end without outer neighbor (cf. border processing):
+  // - first HIGH (1) and first LOW (2): no check in front
+  // - last  HIGH (sequence_length - 1) and last LOW (sequence_length): no check behind
+  uint16_t v_ind;
+  uint8_t  rel_prev;  // previous value reliable
+  uint8_t  rel_curr;  // current  value reliable
+  uint8_t  rel_next;  // next     value reliable
+
+  for (v_ind= 0; v_ind < DIM_T; v_ind++) trusted[v_ind]= 0;
+  rel_prev= 1;
+  rel_curr= (v[1] & LSB) == RELIABLE;
+  for (v_ind= 1; v_ind <= sequence_length; v_ind++) {
+    rel_next= (v[v_ind + 1] & LSB) == RELIABLE;
+    if (rel_curr
+      && (rel_prev || (v_ind <= 2))
+      && (rel_next || (v_ind >= sequence_length - 1))) {
+      trusted[v_ind >> 3]|= 1 << (v_ind & 7);
+    }
+    rel_prev= rel_curr;
+    rel_curr= rel_next;
+  }
+} // end trusted_mask
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
 // ------------------- //
-// 3.7.5 miscellaneous //
+// 3.7.6 miscellaneous //
 // ------------------- //
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
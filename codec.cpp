@@ -0,0 +1,321 @@
+#include <Arduino.h>
+#include "categorizer.h"
+#include "codec.h"
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ============
+  = 4. Codec =  lossless compression of signal duration traces
+  ============
+
+  4.1 trace_encoder: stream a trace in compressed form
+  4.2 sequence_encoder: stream a categorized sequence in packed form (CATEGORIZER_OUTPUT == PACKED_OUTPUT)
+  4.3 Helper
+  4.3.1 varint_encoder: 7 bits per byte, least significant group first
+  4.3.2 bit_encoder   : bit-packed output, most significant bit first
+
+Compressed Trace
+================
+OOK durations collapse onto a handful of category centers, hence a value is encoded
+as its category index plus a small residual. The categories are those of the previous
+reception (the same device usually repeats its frame), their centers are sent in the header, 
+so that the decoder (offline/trace_reader.cpp) needs no classification.
+Without categories, the values are encoded as zigzag deltas to the previous value of the same level.
+
+stream:
+- start marker  : '!' 'C'
+- mode          : byte (CODEC_RAW / CODEC_CATEGORY)
+- v_length, unreliable_count : varint
+- CODEC_RAW: values v[1 .. v_length + 2] as varint (zigzag (v[ind] - v[ind - 2]))
+- CODEC_CATEGORY:
+  - for HIGH then LOW: number of categories n : byte, n x varint (center / 2)
+  - Rice parameter k : byte
+  - values v[1 .. v_length + 2], bit-packed (most significant bit first, last byte padded with zeros):
+    - category index : b bits, the smallest b with 2^b > n (index n: escape)
+    - reliability    : 1 bit (LSB of the value)
+    - category       : residual= zigzag ((value - center) / 2) as Rice code:
+                       (residual >> k) one bits, a zero bit, k low order bits of the residual
+    - escape         : 15 bits value / 2 (no matching category, or residual >> k >= CODEC_RICE_LIMIT)
+- checksum      : uint16 (little endian), Fletcher16 of the values (the same as in the checkout record)
+
+Packed Sequence
+===============
+The categorized sequence of the sequence_printer (3.5) at 3 - 4 bits per value instead of 2 rows of
+characters plus 2 rows of reliability marks; offline/trace_reader.cpp reconstructs the printer view.
+
+stream:
+- start marker  : '!' 'S'
+- v_length      : varint, number of printed values (the "ending" included, if it is not (0, 0))
+- for HIGH then LOW: number of clusters c : byte, number of aggregations a : byte, (c + a) x varint (center)
+- symbols of v[1 .. v_length], bit-packed (most significant bit first, last byte padded with zeros):
+  b bits per value of a level with n= c + a categories, the smallest b with 2^b >= n + SEQUENCE_ESCAPES
+  - 0 .. n - 1          : category index
+  - n + SEQUENCE_TOP    : "*" above the separator barrier
+  - n + SEQUENCE_LOWER  : "-" lower than the lowest category
+  - n + SEQUENCE_NONE   : "?" no matching category
+  - n + SEQUENCE_ZERO   : " " zero duration (spike / drop)
+  - n + SEQUENCE_BANG   : "!" the next symbol belongs to an unreliable value (prefix)
+- checksum      : uint16 (little endian), Fletcher16 of the symbols (prefixes included)
+
+*/
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+// bit-packed output
+THREAD_LOCAL uint8_t codec_acc;    // pending bits
+THREAD_LOCAL uint8_t codec_bits;   // number of pending bits
+
+void trace_encoder (
+  categories z[],            // I  categories of a previous reception ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  uint8_t    mode,           // I  CODEC_RAW / CODEC_CATEGORY
+  duration_seq v,            // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  uint16_t   v_length,       // I  number of signal durations (without end-record)
+  uint16_t   unreliable_count// I  number of unreliable (flagged) values
+) {
+  // ***************** //
+  // 4.1 trace_encoder //  stream a trace in compressed form
+  // ***************** //
+
+  uint16_t v_ind;            // index of current value
+  uint16_t v_val;            // current value without reliability flag
+  uint16_t v_stop_ind;       // index of the "ending"
+  uint16_t prev_val[2];      // previous value of the same level (raw mode)
+  uint8_t  cat_size[2];      // number of categories per level (= escape index)
+  uint8_t  cat_bits[2];      // width of the category index per level
+  uint8_t  cat_ind;          // index of current category (combined clusters and aggregations)
+  uint16_t cat_val;          // value of current category (combined clusters and aggregations)
+  uint8_t  z_ind;            // signal level index (either HIGH or LOW)
+  uint8_t  k;                // Rice parameter
+  uint32_t residual_sum;     // sum of the category residuals (choice of k)
+  uint16_t residual_count;   //  number of the category residuals
+  int32_t  delta;            // signed difference
+  uint32_t residual;         // zigzag mapped difference
+  // Fletcher16 Checksum (cf. categorizer_lib.cpp)
+  uint16_t sum1;
+  uint16_t sum2;
+
+  v_stop_ind= v_length + 2;
+
+  // header
+  // ------
+  _pb(CODEC_MARKER_1);
+  _pb(CODEC_MARKER_2);
+  _pb(mode);
+  varint_encoder(v_length);
+  varint_encoder(unreliable_count);
+
+  sum1= 0;
+  sum2= 0;
+  if (mode == CODEC_RAW) {
+    // zigzag delta to the previous value of the same level (flag included)
+    // ------------
+    prev_val[HIGH]= 0;
+    prev_val[LOW]=  0;
+    for (v_ind= 1; v_ind <= v_stop_ind; v_ind++) {
+      sum1= (sum1 + v[v_ind]) % 255;
+      sum2= (sum2 + sum1) % 255;
+      delta= (int32_t)v[v_ind] - (int32_t)prev_val[v_ind & LSB];
+      prev_val[v_ind & LSB]= v[v_ind];
+      varint_encoder((delta < 0) ? ((uint32_t)(-delta) << 1) - 1 : (uint32_t)delta << 1);
+    }
+    goto CHECKSUM;
+  }
+
+  // categories: clusters followed by aggregations (cf. classifier)
+  // ----------
+  for (z_ind= HIGH; ;z_ind= LOW) {
+    cat_size[z_ind]= z[z_ind].cluster_size + z[z_ind].aggreg_size_2;
+    for (cat_bits[z_ind]= 0; (1 << cat_bits[z_ind]) <= cat_size[z_ind]; cat_bits[z_ind]++);
+    _pb(cat_size[z_ind]);
+    for (cat_ind= 0; cat_ind < cat_size[z_ind]; cat_ind++) {
+      if (cat_ind < z[z_ind].cluster_size) cat_val= z[z_ind].cluster_center[cat_ind];
+      else cat_val= z[z_ind].aggreg_center[cat_ind - z[z_ind].cluster_size];
+      varint_encoder(cat_val >> 1);
+    }
+    if (z_ind == LOW) break;
+  }
+
+  // Rice parameter: mean residual
+  // --------------
+  residual_sum= 0;
+  residual_count= 0;
+  for (v_ind= 1; v_ind <= v_stop_ind; v_ind++) {
+    v_val= v[v_ind] & MSB;
+    if (!classifier (z[v_ind & LSB], v_val, cat_ind, cat_val, C_OPT_3)) continue;
+    // the decoder knows the center / 2 only: the residual is an integer
+    delta= ((int32_t)v_val - (int32_t)(cat_val & MSB)) / 2;
+    residual_sum+= (delta < 0) ? ((uint32_t)(-delta) << 1) - 1 : (uint32_t)delta << 1;
+    residual_count++;
+  }
+  for (k= 0; ((uint32_t)residual_count << k) < residual_sum; k++);
+  _pb(k);
+
+  // values
+  // ------
+  codec_acc= 0;
+  codec_bits= 0;
+  for (v_ind= 1; v_ind <= v_stop_ind; v_ind++) {
+    sum1= (sum1 + v[v_ind]) % 255;
+    sum2= (sum2 + sum1) % 255;
+
+    z_ind= v_ind & LSB;
+    v_val= v[v_ind] & MSB;
+    if (classifier (z[z_ind], v_val, cat_ind, cat_val, C_OPT_3)) {
+      delta= ((int32_t)v_val - (int32_t)(cat_val & MSB)) / 2;
+      residual= (delta < 0) ? ((uint32_t)(-delta) << 1) - 1 : (uint32_t)delta << 1;
+      if ((residual >> k) < CODEC_RICE_LIMIT) {
+        // category index, reliability, Rice coded residual
+        bit_encoder(cat_ind, cat_bits[z_ind]);
+        bit_encoder(v[v_ind] & LSB, 1);
+        bit_encoder((1 << (residual >> k)) - 1, residual >> k);
+        bit_encoder(0, 1);
+        bit_encoder(residual & ((1UL << k) - 1), k);
+        continue;
+      }
+    }
+    // escape: no matching category (e.g. "ending", top-values), or excessive residual
+    bit_encoder(cat_size[z_ind], cat_bits[z_ind]);
+    bit_encoder(v[v_ind] & LSB, 1);
+    bit_encoder(v_val >> 1, 15);
+  }
+  // pad the last byte
+  if (codec_bits > 0) bit_encoder(0, 8 - codec_bits);
+
+CHECKSUM:
+  // checksum
+  // --------
+  sum1|= sum2 << 8;
+  _pb(sum1 & 0xFF);
+  _pb(sum1 >> 8);
+} // end trace_encoder
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void sequence_encoder (
+  categories z[],            // I  categories of the sequence ([1]: HIGH-durations categories, [0]: LOW-durations categories)
+  duration_seq v,            // I  flagged raw data value sequence: odd indices: HIGH-durations, even indices: LOW-durations
+  int16_t    v_length        // I  number of signal durations
+) {
+  // ******************** //
+  // 4.2 sequence_encoder //  stream a categorized sequence in packed form (cf. sequence_printer)
+  // ******************** //
+
+  int16_t  v_ind;            // index of current value
+  uint8_t  z_ind;            // signal level index (either HIGH or LOW)
+  uint8_t  cat_size[2];      // number of categories per level
+  uint8_t  cat_bits[2];      // width of a symbol per level
+  uint8_t  cat_ind;          // index of current category (combined clusters and aggregations)
+  uint8_t  code;             // symbol code
+  char     sym;              // printer symbol (cf. category_symbol)
+  // Fletcher16 Checksum (cf. categorizer_lib.cpp)
+  uint16_t sum1;
+  uint16_t sum2;
+
+  // end handling (cf. sequence_printer)
+  if ((v[v_length + 1] != 0) && (v[v_length + 2] != 0)) {
+    v_length+= 2;
+  }
+
+  // header
+  // ------
+  _pb(SEQUENCE_MARKER_1);
+  _pb(SEQUENCE_MARKER_2);
+  varint_encoder(v_length);
+  for (z_ind= HIGH; ;z_ind= LOW) {
+    cat_size[z_ind]= z[z_ind].cluster_size + z[z_ind].aggreg_size_2;
+    for (cat_bits[z_ind]= 0; (1 << cat_bits[z_ind]) < cat_size[z_ind] + SEQUENCE_ESCAPES; cat_bits[z_ind]++);
+    _pb(z[z_ind].cluster_size);
+    _pb(z[z_ind].aggreg_size_2);
+    for (cat_ind= 0; cat_ind < z[z_ind].cluster_size; cat_ind++) varint_encoder(z[z_ind].cluster_center[cat_ind]);
+    for (cat_ind= 0; cat_ind < z[z_ind].aggreg_size_2; cat_ind++) varint_encoder(z[z_ind].aggreg_center[cat_ind]);
+    if (z_ind == LOW) break;
+  }
+
+  // symbols
+  // -------
+  codec_acc= 0;
+  codec_bits= 0;
+  sum1= 0;
+  sum2= 0;
+  for (v_ind= 1; v_ind <= v_length; v_ind++) {
+    z_ind= v_ind & LSB;
+    if ((v[v_ind] != 0) && ((v[v_ind] & LSB) == UNRELIABLE)) {
+      code= cat_size[z_ind] + SEQUENCE_BANG;
+      bit_encoder(code, cat_bits[z_ind]);
+      sum1= (sum1 + code) % 255;
+      sum2= (sum2 + sum1) % 255;
+    }
+    sym= category_symbol (z[z_ind], v[v_ind]);
+    if      (sym == '*') code= cat_size[z_ind] + SEQUENCE_TOP;
+    else if (sym == '-') code= cat_size[z_ind] + SEQUENCE_LOWER;
+    else if (sym == '?') code= cat_size[z_ind] + SEQUENCE_NONE;
+    else if (sym == ' ') code= cat_size[z_ind] + SEQUENCE_ZERO;
+    else if (sym <= '9') code= sym - '0';
+    else                 code= sym - 87;
+    bit_encoder(code, cat_bits[z_ind]);
+    sum1= (sum1 + code) % 255;
+    sum2= (sum2 + sum1) % 255;
+  }
+  // pad the last byte
+  if (codec_bits > 0) bit_encoder(0, 8 - codec_bits);
+
+  // checksum
+  // --------
+  sum1|= sum2 << 8;
+  _pb(sum1 & 0xFF);
+  _pb(sum1 >> 8);
+} // end sequence_encoder
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ********** //
+// 4.3 Helper //
+// ********** //
+
+void varint_encoder (
+  uint32_t val       // I  unsigned value
+) {
+  // -------------------- //
+  // 4.3.1 varint_encoder //  7 bits per byte, least significant group first, MSB: continuation
+  // -------------------- //
+  while (val >= 0x80) {
+    _pb((uint8_t)(val | 0x80));
+    val>>= 7;
+  }
+  _pb((uint8_t)val);
+} // end varint_encoder
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void bit_encoder (
+  uint16_t val,      // I  value (the low order bits are output)
+  uint8_t  n         // I  number of bits (<= 16)
+) {
+  // ----------------- //
+  // 4.3.2 bit_encoder //  bit-packed output, most significant bit first
+  // ----------------- //
+  while (n > 0) {
+    n--;
+    codec_acc= (codec_acc << 1) | ((val >> n) & 1);
+    if (++codec_bits == 8) {
+      _pb(codec_acc);
+      codec_acc= 0;
+      codec_bits= 0;
+    }
+  }
+} // end bit_encoder
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -0,0 +1,56 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  =====================
+  = Codec (Interface) =
+  =====================
+  (include categorizer.h first)
+
+// Off-Line Processing
+// -------------------
+// include the following line in Eclipse
+   void _pb   (uint8_t b) {putchar(b);}
+*/
+
+// Arduino byte output
+#define _pb   Serial.write
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// compressed trace (cf. codec.cpp)
+#define CODEC_MARKER_1  '!'   // start marker
+#define CODEC_MARKER_2  'C'
+#define CODEC_RAW         0   // mode: zigzag varint deltas to the previous value of the same level (HIGH / LOW)
+#define CODEC_CATEGORY    1   // mode: category index plus Rice coded residual to the category center (bit-packed)
+#define CODEC_RICE_LIMIT  8   // maximal Rice quotient, larger residuals are escaped
+// packed categorized sequence (cf. codec.cpp)
+#define SEQUENCE_MARKER_1  '!'   // start marker
+#define SEQUENCE_MARKER_2  'S'
+#define SEQUENCE_TOP       0  // escape codes, following the category indices: "*" above the separator barrier
+#define SEQUENCE_LOWER     1  // "-" lower than the lowest category
+#define SEQUENCE_NONE      2  // "?" no matching category
+#define SEQUENCE_ZERO      3  // " " zero duration (spike / drop)
+#define SEQUENCE_BANG      4  // "!" prefix: the next symbol belongs to an unreliable value
+#define SEQUENCE_ESCAPES   5  // number of escape codes
+
+// encode a trace: v[1 .. v_length + 2] ("ending" included)
+void trace_encoder (categories z[], uint8_t mode, duration_seq v, uint16_t v_length, uint16_t unreliable_count);
+// encode the categorized sequence of the sequence_printer
+void sequence_encoder (categories z[], duration_seq v, int16_t v_length);
+    void varint_encoder (uint32_t val);
+    void bit_encoder    (uint16_t val, uint8_t n);
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
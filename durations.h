@@ -0,0 +1,126 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ==============================
+  = Duration Storage (Interface)=  how the recorder stores the signal durations for the categorizer
+  ==============================
+  (included by radio_lib.h and categorizer.h)
+
+  duration_seq is the type of the signal duration sequence v[] of the recorder and of the categorizer:
+  - WORD_DURATIONS: uint16_t per duration (the value and the reliability flag LSB), v is a plain pointer
+  - LOG8_DURATIONS: an 8-bit logarithmic code per duration plus 1 packed reliability bit,
+    v[i] decodes on read and encodes on write (duration_ref), the sequence is unchanged otherwise
+  The 8-bit code is a small float of the duration value / 2 (the LSB is the reliability bit):
+  - code 0 .. 63          : exact values 0 .. 126
+  - code e * 32 + m       : (32 + m) << e, rounded (e = 2 .. 6, m has 5 bits): values up to 4032, error <= 1.6 %
+  - code 224 + k * 8 + m  : (8 + m) << (k + 9), rounded (k = 0 .. 3, m has 3 bits): long durations, error <= 6.2 %
+                            (values above 59392: 57344, cf. LOG8_CEIL)
+  - code LOG8_CEIL (255)  : escape of the long pauses and the end records (values >= CEIL)
+  The error stays well below the cluster widths of the categorizer (classifier C_OPT_3: 12.5 %),
+  but the categorized values are no longer the exact raw values.
+  9 bits instead of 16 per duration: with the same RAM, NV grows by 15 / 8 (cf. categorizer.h: NV).
+  Each access of v[i] costs the encode / decode (a few shifts and compares, no table).
+  Transmitter tags (radio_lib.h: COLLISION_SEPARATE): 1 packed bit per HIGH v[i] (i odd) for the categorizer
+  to separate two transmitters (cf. categorizer.cpp: separator), independent of the duration storage.
+*/
+
+#ifndef DURATIONS_H
+#define DURATIONS_H
+
+#include <stdint.h>
+
+// duration storage
+#define WORD_DURATIONS    0     // 16 bits per duration
+#define LOG8_DURATIONS    1     // 8-bit logarithmic code plus a packed reliability bit per duration
+#define DURATION_STORAGE  WORD_DURATIONS
+
+// transmitter tags: the HIGH v[i] is bit ((i >> 1) & 7) of t[i >> 4] (0: reference transmitter, 1: other transmitter)
+#define TRANSMITTER_DIM(nv)        (((nv) / 2 + 8) / 8)    // bytes of the tags of v[1 .. nv + 1]
+#define TRANSMITTER_OF(t, i)       (((t)[(i) >> 4] >> (((i) >> 1) & 7)) & 1)
+#define TRANSMITTER_SET(t, i)      ((t)[(i) >> 4]|=  (uint8_t)(1 << (((i) >> 1) & 7)))
+#define TRANSMITTER_CLEAR(t, i)    ((t)[(i) >> 4]&= (uint8_t)~(1 << (((i) >> 1) & 7)))
+
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+
+#define LOG8_CEIL       255     // escape code: long pause (CEIL)
+#define LOG8_LONG       224     // first code of the long durations (4 significant bits)
+#define LOG8_CEIL_VALUE 65000U  // decoded value of LOG8_CEIL (= CEIL, cf. categorizer.h)
+
+// encode a flagged duration value into its 8-bit code (the reliability LSB is not encoded)
+static inline uint8_t log8_encode (uint16_t value) {
+  uint16_t w;     // value / 2, normalized
+  uint8_t  e;     // exponent
+
+  if (value >= LOG8_CEIL_VALUE) return (LOG8_CEIL);
+  w= value >> 1;
+  // codes 0 .. 63: exact
+  if (w < 64) return (w);
+  // codes 64 .. 223: 6 significant bits, rounded
+  e= 1;
+  while (w >= 128) {w>>= 1; e++;}
+  w= (w + 1) >> 1;
+  e++;
+  if (w >= 64) {w>>= 1; e++;}
+  if (e <= 6) return ((e << 5) | (w & 31));
+  // codes 224 .. 254: 4 significant bits, rounded
+  w= value >> 1;
+  e= 0;
+  while (w >= 32) {w>>= 1; e++;}
+  w= (w + 1) >> 1;
+  if (w >= 16) {w>>= 1; e++;}
+  w= LOG8_LONG + ((e - 7) << 3) + (w & 7);
+  return ((w < LOG8_CEIL) ? w : LOG8_CEIL - 1);
+}
+
+// decode an 8-bit code into the duration value (reliability LSB = 0)
+static inline uint16_t log8_decode (uint8_t code) {
+  if (code == LOG8_CEIL) return (LOG8_CEIL_VALUE);
+  if (code >= LOG8_LONG) return (((uint16_t)(8 + (code & 7))) << (((code - LOG8_LONG) >> 3) + 9));
+  if (code < 64) return (code << 1);
+  return (((uint16_t)(32 + (code & 31))) << (code >> 5));
+}
+
+// reference to one duration of a log8 sequence: read decodes, write encodes
+class duration_ref {
+public:
+  duration_ref (uint8_t *code, uint8_t *flag, uint16_t i) : c_ptr(code + i), f_ptr(flag + (i >> 3)), f_mask(1 << (i & 7)) {}
+  operator uint16_t () const {return (log8_decode(*c_ptr) | ((*f_ptr & f_mask) ? 1 : 0));}
+  duration_ref &operator= (uint16_t value) {
+    *c_ptr= log8_encode(value);
+    if (value & 1) *f_ptr|= f_mask; else *f_ptr&= ~f_mask;
+    return (*this);
+  }
+  duration_ref &operator= (const duration_ref &r) {return (*this= (uint16_t)r);}
+private:
+  uint8_t *c_ptr;   // code
+  uint8_t *f_ptr;   // packed reliability bits
+  uint8_t  f_mask;  // reliability bit of the duration
+};
+
+// log8 sequence: v[i] as with uint16_t v[]
+struct duration_seq {
+  uint8_t *code;  // 8-bit codes [1 .. count + 2]
+  uint8_t *flag;  // packed reliability bits: bit (i & 7) of flag[i >> 3]
+  duration_ref operator[] (uint16_t i) const {return (duration_ref(code, flag, i));}
+};
+
+#else
+
+typedef uint16_t *duration_seq;
+
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ========================
+  = Host Arduino (Shim)  =  the subset of Arduino.h used by the categorizer (host build, cf. Makefile)
+  ========================
+
+  Serial prints either to a stream (out) or into the capture buffer (text), which lets the
+  benchmark compare the categorizer output with the golden output trace by trace.
+  Serial.write captures zero bytes as well (binary output, cf. codec.cpp): use length, not strlen.
+  Note: int has 32 bits on the host (16 bits on the ATmega328P).
+  HOST_SIMULATION (radio simulator, cf. simulator.cpp): the pins, ports and timing functions used by the
+  recorder and the radio library; the time is the simulated time of the radio timeline.
+*/
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+#define HIGH  1
+#define LOW   0
+
+#define F(x)  x
+#define min(a, b)  ((a) < (b) ? (a) : (b))
+#define max(a, b)  ((a) > (b) ? (a) : (b))
+#undef  abs
+#define abs(x)     ((x) > 0 ? (x) : -(x))
+
+#define HOST_SERIAL_DIM  16384   // capture buffer (a categorized sequence of NV values takes ~ 2 KB)
+
+class HostSerial {
+public:
+  FILE   *out;                    // output stream (NULL: capture into text)
+  char    text[HOST_SERIAL_DIM];  // captured output (null terminated)
+  size_t  length;                 // number of captured characters
+
+  HostSerial() : out(stdout), length(0) {text[0]= '\0';}
+
+  // clear the capture buffer
+  void   clear             () {length= 0; text[0]= '\0';}
+
+  size_t print   (const char s[])   {return put(s);}
+  size_t print   (char c)           {char s[2]= {c, '\0'}; return put(s);}
+  size_t print   (int d)            {return put_long(d);}
+  size_t print   (unsigned int d)   {return put_long(d);}
+  size_t print   (long d)           {return put_long(d);}
+  size_t print   (unsigned long d)  {return put_long((long)d);}
+  size_t println ()                 {return put("\n");}
+  template <typename T>
+  size_t println (T x)              {size_t n= print(x); return n + put("\n");}
+  size_t write   (uint8_t b)        {return out ? fwrite(&b, 1, 1, out) : put_byte(b);}
+
+private:
+  size_t put (const char s[]) {
+    size_t n= strlen(s);
+    if (out) return fwrite(s, 1, n, out);
+    // capture: excess output is discarded
+    size_t k;
+    for (k= 0; (k < n) && (length < HOST_SERIAL_DIM - 1); k++) text[length++]= s[k];
+    text[length]= '\0';
+    return k;
+  }
+  size_t put_byte (uint8_t b) {
+    // binary output (zero bytes included)
+    if (length >= HOST_SERIAL_DIM - 1) return 0;
+    text[length++]= (char)b;
+    text[length]= '\0';
+    return 1;
+  }
+  size_t put_long (long d) {
+    char s[24];
+    snprintf(s, sizeof(s), "%ld", d);
+    return put(s);
+  }
+};
+
+#ifdef HOST_SIMULATION
+// recorder and radio library (cf. radio_lib.cpp: HOST_SIMULATION)
+#define INPUT   0
+#define OUTPUT  1
+#define SS     10                 // slave select RM_1 (pin 10)
+#define _BV(b)  (1 << (b))
+
+extern volatile uint8_t DDRB, PORTB, DDRD, PORTD;
+void pinMode (uint8_t pin, uint8_t mode);
+void digitalWrite (uint8_t pin, uint8_t value);
+void delay (unsigned long ms);
+void delayMicroseconds (unsigned int us);
+unsigned long micros ();
+#endif
+
+#ifdef HOST_THREADS
+// batch runner: the output of each worker thread is captured separately (cf. batch.cpp)
+extern thread_local HostSerial Serial;
+#else
+extern HostSerial Serial;
+#endif
+
+#endif
@@ -0,0 +1,44 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ====================
+  = Host SPI (Shim)  =  the SPI calls of the radio library (radio simulator, cf. simulator.cpp)
+  ====================
+
+  The registers of the simulated radio modules are accessed by RFM69readReg / RFM69writeReg (simulator.cpp),
+  the SPI bus itself does nothing.
+*/
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#define SPI_MODE0        0
+#define MSBFIRST         1
+#define SPI_CLOCK_DIV2   4
+
+class HostSPI {
+public:
+  void    begin          () {}
+  void    end            () {}
+  void    setDataMode    (uint8_t) {}
+  void    setBitOrder    (uint8_t) {}
+  void    setClockDivider(uint8_t) {}
+  uint8_t transfer       (uint8_t) {return (0);}
+};
+
+extern HostSPI SPI;
+
+#endif
@@ -0,0 +1,557 @@
+// the standard library first: Arduino.h defines min and max as macros
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <Arduino.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "categorizer.h"
+#include "trace_reader.h"
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ================
+  = Batch Runner =  parallel off-line categorization of large trace corpora (host build, not part of the sketch)
+  ================
+
+  usage:
+    batch [-j threads] [-t timeout_ms] [-o output] trace_file_or_directory ...
+    batch -S [-j threads] [-t timeout_ms] [-p NAME=v1,v2,... ...] trace_file_or_directory ...
+
+    -j  number of worker threads (default: the number of cores)
+    -t  hang guard: a categorization that takes more CPU time is aborted and counted as "hang"
+    -o  write the categorizer output of all traces, in the order of the traces (the same file as benchmark -o)
+    -S  parameter sweep: categorize the corpus for each point of the grid of categorizer parameters,
+        one line of return code rates per point
+    -p  grid of a parameter (default: START_VAL=30,50,70 MAX_HOLES=0,1,2 MIN_SIZE=2,3,4); swept: BORDER_WIDTH,
+        START_VAL, MAX_HOLES, FIRST_HITS, MIN_SIZE, OUTLIER_OPTION (C_OPT_2), RESORBER_OPTION (C_OPT_4);
+        the other parameters keep their defaults (categorizer.h: CATEGORIZER_DEFAULTS)
+  a directory is read file by file (regular files, in name order), each file may hold any number of text traces
+
+  the objects are compiled with HOST_THREADS and HOST_TUNING (cf. Makefile):
+  - HOST_THREADS: the static state of the categorizer and the serial capture (cf. Arduino.h) are per thread,
+    each worker has its own scratch buffers; the output of a trace is captured, not printed
+  - HOST_TUNING : TUNABLE_PARAMETERS, each work unit passes the parameters of its sweep point (cf. categorizer.h)
+  note: the category cache (CATEGORY_CACHING) and the learned protocols (BIT_OUTPUT) are per worker,
+  their results depend on the assignment of the traces to the workers
+
+  R.1 main
+  R.2 trace_loader: read the traces of a file or a directory
+  R.3 worker: categorize the work units (sweep point, trace) of the shared counter
+  R.4 categorize_unit: categorization of one trace with a CPU time hang guard
+  R.5 summaries: return code distribution, sweep table
+  R.6 Helper
+  R.6.1 parse_grid: NAME=v1,v2,... of a swept parameter
+  R.6.2 set_parameter / get_parameter: swept parameter of a sweep point
+  R.6.3 now_ns: monotonic clock
+*/
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#define DIM_V       (NV + 5)    // dim signal_duration (cf. receiver.ino)
+#define RC_HANG     (CRC_18 + 1)  // return code distribution: categorization aborted by the hang guard
+#define NRC         (RC_HANG + 1) // dim of the return code distribution
+#define TIMEOUT_MS   100        // default hang guard (a categorization takes less than 1 ms)
+#define NSWEPT         7        // number of swept parameters (categorizer_parameters)
+#define GRID_DIM      16        // maximal number of values per swept parameter
+
+#ifndef sigev_notify_thread_id
+  #define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+// host serial output (cf. Arduino.h): one capture buffer per thread
+thread_local HostSerial Serial;
+
+typedef struct {
+  // trace of the corpus
+  trace_record t;                       // trace header
+  std::vector<uint16_t> v;              // signal sequence [0 .. count + 2]
+} batch_trace;
+
+typedef struct {
+  // scratch of a worker (the arena of receiver.ino)
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  uint8_t    duration_code[DIM_V];
+  uint8_t    duration_flag[(DIM_V + 7) / 8];
+#else
+  uint16_t   signal_duration[DIM_V];
+#endif
+  categories duration_category[2];
+  uint8_t    uint8buf32[DIM_32];
+  uint16_t   uint16buf64[DIM_64];
+  uint8_t    trusted[DIM_T];
+} worker_scratch;
+
+typedef struct {
+  // swept parameter (field s_ind of categorizer_parameters)
+  const char *name;                     // name of the default constant (categorizer.h)
+  uint16_t low;                         // range of the values
+  uint16_t high;
+  uint8_t  default_size;                // default grid (-S without -p of this parameter; 0: the default value)
+  uint16_t default_grid[3];
+} swept_parameter;
+
+const swept_parameter swept[NSWEPT]= {
+  {"BORDER_WIDTH",    2, BORDER_WIDTH_MAX, 0, {0}},
+  {"START_VAL",       0, CEIL,             3, {30, 50, 70}},
+  {"MAX_HOLES",       0, NB,               3, {0, 1, 2}},
+  {"FIRST_HITS",      1, 2,                0, {0}},
+  {"MIN_SIZE",        1, 255,              3, {2, 3, 4}},
+  {"OUTLIER_OPTION",  1, C_OPT_MAX,        0, {0}},
+  {"RESORBER_OPTION", 1, C_OPT_MAX,        0, {0}}
+};
+const categorizer_parameters parameter_defaults= CATEGORIZER_DEFAULTS;
+
+bool    trace_loader (const char path[], std::vector<batch_trace> &corpus);
+void    worker (worker_scratch *w, long timeout_ms);
+uint8_t categorize_unit (worker_scratch &w, batch_trace &b, const categorizer_parameters &cp, timer_t guard, long timeout_ms);
+void    rc_summary (uint32_t rc_count[], uint32_t trace_count);
+void    sweep_summary (uint32_t point_count);
+bool    parse_grid (const char arg[]);
+void    set_parameter (categorizer_parameters &p, uint8_t s_ind, uint16_t val);
+uint16_t get_parameter (const categorizer_parameters &p, uint8_t s_ind);
+int64_t now_ns ();
+
+// corpus and work units: unit u is the trace u % corpus.size() of the sweep point u / corpus.size()
+std::vector<batch_trace> corpus;
+std::vector<categorizer_parameters> point;   // sweep points (no sweep: the defaults)
+std::vector<uint8_t>     unit_rc;       // return code per unit
+std::vector<std::string> unit_output;   // captured output per unit (-o only)
+std::atomic<uint32_t>    next_unit;     // shared counter of the workers
+uint32_t unit_count;
+bool     capture;                       // keep the output of each unit
+
+// grid of the swept parameters (grid_size 0: not swept)
+uint16_t grid[NSWEPT][GRID_DIM];
+uint8_t  grid_size[NSWEPT];
+
+// hang guard: the timer of a worker interrupts its own thread
+thread_local sigjmp_buf hang_jump;
+void hang_handler (int sig) {siglongjmp(hang_jump, 1);}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+int main (int argc, char *argv[])
+{
+  // ******** //
+  // R.1 main //
+  // ******** //
+  uint32_t thread_count;      // number of workers
+  long     timeout_ms;        // hang guard
+  const char *output;         // categorizer output file (NULL: none)
+  bool     sweep;             // parameter sweep
+  FILE     *out;
+  int      opt;
+  int      arg_ind;
+  uint32_t u_ind;
+  uint32_t w_ind;
+  uint32_t rc_count[NRC];
+  uint8_t  s_ind;
+  uint8_t  i[NSWEPT];
+  categorizer_parameters p;
+  int64_t  start;
+  std::vector<worker_scratch> scratch;
+  std::vector<std::thread>    workers;
+
+  thread_count= max(1u, std::thread::hardware_concurrency());
+  timeout_ms= TIMEOUT_MS;
+  output= NULL;
+  sweep= false;
+  while ((opt= getopt(argc, argv, "j:t:o:Sp:")) != -1) {
+    switch (opt) {
+      case 'j': thread_count= max(1, atoi(optarg)); break;
+      case 't': timeout_ms= atol(optarg); break;
+      case 'o': output= optarg; break;
+      case 'S': sweep= true; break;
+      case 'p': if (!parse_grid(optarg)) return (2); break;
+      default:
+        fprintf(stderr, "usage: %s [-j threads] [-t timeout_ms] [-o output] trace_file_or_directory ...\n", argv[0]);
+        fprintf(stderr, "       %s -S [-j threads] [-t timeout_ms] [-p NAME=v1,v2,... ...] trace_file_or_directory ...\n", argv[0]);
+        return (2);
+    }
+  }
+  if (optind >= argc) {
+    fprintf(stderr, "%s: no trace file\n", argv[0]);
+    return (2);
+  }
+
+  // load the corpus
+  // ---------------
+  for (arg_ind= optind; arg_ind < argc; arg_ind++) {
+    if (!trace_loader(argv[arg_ind], corpus)) return (2);
+  }
+  if (corpus.empty()) {
+    fprintf(stderr, "%s: no trace\n", argv[0]);
+    return (2);
+  }
+
+  // sweep points
+  // ------------
+  // no sweep: only the defaults of categorizer.h
+  if (sweep) {
+    // default grid of the parameters without -p
+    for (s_ind= 0; s_ind < NSWEPT; s_ind++) {
+      if (grid_size[s_ind] > 0) continue;
+      memcpy(grid[s_ind], swept[s_ind].default_grid, sizeof(swept[s_ind].default_grid));
+      grid_size[s_ind]= swept[s_ind].default_size;
+    }
+    // all combinations of the swept values (odometer: the last parameter changes fastest)
+    memset(i, 0, sizeof(i));
+    do {
+      p= parameter_defaults;
+      for (s_ind= 0; s_ind < NSWEPT; s_ind++) {
+        if (grid_size[s_ind] > 0) set_parameter(p, s_ind, grid[s_ind][i[s_ind]]);
+      }
+      point.push_back(p);
+      for (s_ind= NSWEPT; s_ind > 0; s_ind--) {
+        if (++i[s_ind - 1] < grid_size[s_ind - 1]) break;
+        i[s_ind - 1]= 0;
+      }
+    } while (s_ind > 0);
+  } else point.push_back(parameter_defaults);
+  unit_count= point.size() * corpus.size();
+  unit_rc.assign(unit_count, 0);
+  capture= (output != NULL) && !sweep;
+  if (capture) unit_output.resize(unit_count);
+
+  // thread pool
+  // -----------
+  // the workers share the counter of the next unit, each one with its own scratch
+  thread_count= min(thread_count, unit_count);
+  scratch.resize(thread_count);
+  signal(SIGALRM, hang_handler);
+  next_unit= 0;
+  start= now_ns();
+  for (w_ind= 0; w_ind < thread_count; w_ind++) workers.push_back(std::thread(worker, &scratch[w_ind], timeout_ms));
+  for (w_ind= 0; w_ind < thread_count; w_ind++) workers[w_ind].join();
+  start= now_ns() - start;
+
+  printf("traces: %u, sweep points: %u, threads: %u, time: %.3f ms (%.0f categorizations per s)\n",
+         (uint32_t)corpus.size(), (uint32_t)point.size(), thread_count, start / 1e6, unit_count * 1e9 / start);
+  if (sweep) {
+    sweep_summary(point.size());
+    return (0);
+  }
+
+  // output in the order of the traces
+  // ---------------------------------
+  if (capture) {
+    if ((out= fopen(output, "w")) == NULL) {perror(output); return (2);}
+    for (u_ind= 0; u_ind < unit_count; u_ind++) {
+      fprintf(out, "=== trace %u\n", u_ind + 1);
+      fwrite(unit_output[u_ind].data(), 1, unit_output[u_ind].size(), out);
+    }
+    fclose(out);
+  }
+  memset(rc_count, 0, sizeof(rc_count));
+  for (u_ind= 0; u_ind < unit_count; u_ind++) rc_count[unit_rc[u_ind]]++;
+  rc_summary(rc_count, unit_count);
+  return (0);
+
+} // end main
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool trace_loader (                   // false: the path cannot be read
+  const char path[],                  // I  trace file or directory of trace files
+  std::vector<batch_trace> &corpus    // IO the traces are appended
+) {
+  // **************** //
+  // R.2 trace_loader //  read the traces of a file or a directory
+  // **************** //
+  // traces longer than NV and traces with reader errors are skipped (with a message)
+  static uint16_t v[DIM_V];
+  struct stat st;
+  DIR      *dir;
+  struct dirent *entry;
+  std::vector<std::string> names;
+  FILE     *in;
+  trace_record t;
+  batch_trace b;
+  uint8_t  rc;
+  uint32_t trace_ind;
+  size_t   n_ind;
+
+  if (stat(path, &st) != 0) {perror(path); return (false);}
+  if (S_ISDIR(st.st_mode)) {
+    if ((dir= opendir(path)) == NULL) {perror(path); return (false);}
+    while ((entry= readdir(dir)) != NULL) {
+      if (entry->d_name[0] == '.') continue;
+      names.push_back(std::string(path) + "/" + entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    for (n_ind= 0; n_ind < names.size(); n_ind++) {
+      if ((stat(names[n_ind].c_str(), &st) != 0) || !S_ISREG(st.st_mode)) continue;
+      if (!trace_loader(names[n_ind].c_str(), corpus)) return (false);
+    }
+    return (true);
+  }
+
+  if ((in= fopen(path, "r")) == NULL) {perror(path); return (false);}
+  trace_ind= 0;
+  while ((rc= text_trace_reader(in, v, DIM_V, t)) != TRC_1) {
+    trace_ind++;
+    if ((rc == TRC_0) && (t.count > NV)) rc= TRC_4;
+    if (rc != TRC_0) {
+      fprintf(stderr, "%s: trace %u skipped (trace reader return code %u)\n", path, trace_ind, rc);
+      continue;
+    }
+    b.t= t;
+    b.v.assign(v, v + t.count + 3);
+    corpus.push_back(b);
+  }
+  fclose(in);
+  return (true);
+
+} // end trace_loader
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void worker (
+  worker_scratch *w,    // X  scratch of this worker
+  long timeout_ms       // I  hang guard per categorization
+) {
+  // ********** //
+  // R.3 worker //  categorize the work units (sweep point, trace) of the shared counter
+  // ********** //
+  struct sigevent sev;
+  timer_t  guard;
+  uint32_t u_ind;
+
+  // hang guard: CPU time of this thread, the signal is delivered to this thread
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify= SIGEV_THREAD_ID;
+  sev.sigev_signo= SIGALRM;
+  sev.sigev_notify_thread_id= syscall(SYS_gettid);
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &guard) != 0) {perror("timer_create"); exit(2);}
+  Serial.out= NULL;
+  while ((u_ind= next_unit++) < unit_count) {
+    unit_rc[u_ind]= categorize_unit(*w, corpus[u_ind % corpus.size()], point[u_ind / corpus.size()], guard, timeout_ms);
+    if (capture) unit_output[u_ind].assign(Serial.text, Serial.length);
+  }
+  timer_delete(guard);
+
+} // end worker
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint8_t categorize_unit (   // return code (RC_HANG: aborted by the hang guard)
+  worker_scratch &w,        // X  scratch of the worker
+  batch_trace &b,           // I  trace (not modified: the categorizer works on a copy)
+  const categorizer_parameters &cp,   // I  parameters of the sweep point
+  timer_t  guard,           // I  hang guard timer of the worker
+  long     timeout_ms       // I  hang guard [ms CPU time]
+) {
+  // ******************* //
+  // R.4 categorize_unit //  categorization of one trace with a CPU time hang guard
+  // ******************* //
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  duration_seq signal_duration= {w.duration_code, w.duration_flag};
+  uint16_t     v_ind;
+#else
+  duration_seq signal_duration= w.signal_duration;
+#endif
+  struct itimerspec its;
+  uint8_t  rc;
+
+  // the categorizer corrects the signal sequence in place
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  // encoded as by the recorder (cf. durations.h)
+  for (v_ind= 0; v_ind < b.t.count + 3; v_ind++) signal_duration[v_ind]= b.v[v_ind];
+#else
+  memcpy(w.signal_duration, b.v.data(), (b.t.count + 3) * sizeof(uint16_t));
+#endif
+  memset(w.duration_category, 0, sizeof(w.duration_category));
+  Serial.clear();
+  memset(&its, 0, sizeof(its));
+
+  if (sigsetjmp(hang_jump, 1) != 0) {
+    // the hang guard fired: the categorizer did not terminate
+    Serial.clear();
+    Serial.print(F("hang guard: categorization aborted"));
+    Serial.println();
+    return (RC_HANG);
+  }
+  its.it_value.tv_sec=  timeout_ms / 1000;
+  its.it_value.tv_nsec= (timeout_ms % 1000) * 1000000;
+  timer_settime(guard, 0, &its, NULL);
+  rc= 0;
+  categorizer (w.duration_category, signal_duration, b.t.count, b.t.unreliable_count, 0, cp, rc,
+               w.uint8buf32, w.uint16buf64, w.trusted);
+  if (rc == CRC_0) categorizer_printer (w.duration_category, signal_duration, b.t.count, w.uint8buf32, w.uint16buf64);
+  memset(&its, 0, sizeof(its));
+  timer_settime(guard, 0, &its, NULL);
+  return (rc);
+
+} // end categorize_unit
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ************* //
+// R.5 summaries //
+// ************* //
+
+void rc_summary (uint32_t rc_count[], uint32_t trace_count)
+{
+  // return code distribution (same format as benchmark: summary)
+  uint8_t rc;
+
+  printf("\ncategorizer return codes\n");
+  for (rc= 0; rc < NRC; rc++) {
+    if (rc_count[rc] == 0) continue;
+    if (rc == RC_HANG) printf("hang  ");
+    else printf("CRC_%-2u", rc);
+    printf(" %8u %7.2f %%\n", rc_count[rc], trace_count ? 100.0 * rc_count[rc] / trace_count : 0.0);
+  }
+}
+
+void sweep_summary (uint32_t point_count)
+{
+  // one line per sweep point: the rates [%] of the return codes that occur in the sweep
+  std::vector<uint32_t> rc_count(point_count * NRC, 0);
+  uint32_t total[NRC];
+  uint32_t u_ind;
+  uint32_t p_ind;
+  uint8_t  s_ind;
+  uint8_t  rc;
+  double   n;
+
+  memset(total, 0, sizeof(total));
+  for (u_ind= 0; u_ind < unit_count; u_ind++) {
+    rc_count[(u_ind / corpus.size()) * NRC + unit_rc[u_ind]]++;
+    total[unit_rc[u_ind]]++;
+  }
+  n= corpus.size();
+  printf("\nreturn code rates [%%] per sweep point\n");
+  for (s_ind= 0; s_ind < NSWEPT; s_ind++) {
+    if (grid_size[s_ind] > 0) printf("%-*s", max(10, (int)strlen(swept[s_ind].name) + 1), swept[s_ind].name);
+  }
+  for (rc= 0; rc < NRC; rc++) {
+    if (total[rc] == 0) continue;
+    if (rc == RC_HANG) printf("%8s", "hang");
+    else printf("   CRC_%-2u", rc);
+  }
+  printf("\n");
+  for (p_ind= 0; p_ind < point_count; p_ind++) {
+    for (s_ind= 0; s_ind < NSWEPT; s_ind++) {
+      if (grid_size[s_ind] > 0) printf("%-*u", max(10, (int)strlen(swept[s_ind].name) + 1), get_parameter(point[p_ind], s_ind));
+    }
+    for (rc= 0; rc < NRC; rc++) {
+      if (total[rc] == 0) continue;
+      printf("%8.2f", 100.0 * rc_count[p_ind * NRC + rc] / n);
+    }
+    printf("\n");
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ********** //
+// R.6 Helper //
+// ********** //
+
+bool parse_grid (const char arg[])
+{
+  // ---------------- //
+  // R.6.1 parse_grid //  NAME=v1,v2,... of a swept parameter (false: syntax error, with a message)
+  // ---------------- //
+  const char *values;
+  char     *end;
+  uint8_t  s_ind;
+  long     val;
+
+  for (s_ind= 0; s_ind < NSWEPT; s_ind++) {
+    if ((strncmp(arg, swept[s_ind].name, strlen(swept[s_ind].name)) == 0) && (arg[strlen(swept[s_ind].name)] == '=')) break;
+  }
+  if (s_ind == NSWEPT) {
+    fprintf(stderr, "-p %s: unknown parameter (swept:", arg);
+    for (s_ind= 0; s_ind < NSWEPT; s_ind++) fprintf(stderr, " %s", swept[s_ind].name);
+    fprintf(stderr, ")\n");
+    return (false);
+  }
+  values= arg + strlen(swept[s_ind].name) + 1;
+  grid_size[s_ind]= 0;
+  while (*values != '\0') {
+    val= strtol(values, &end, 10);
+    if ((end == values) || (val < swept[s_ind].low) || (val > swept[s_ind].high) || (grid_size[s_ind] >= GRID_DIM)) {
+      fprintf(stderr, "-p %s: invalid value list (range %u .. %u, at most %u values)\n", arg, swept[s_ind].low, swept[s_ind].high, GRID_DIM);
+      return (false);
+    }
+    if ((*end != ',') && (*end != '\0')) {
+      fprintf(stderr, "-p %s: invalid value list\n", arg);
+      return (false);
+    }
+    grid[s_ind][grid_size[s_ind]++]= val;
+    values= (*end == ',') ? end + 1 : end;
+  }
+  if (grid_size[s_ind] == 0) {
+    fprintf(stderr, "-p %s: no value\n", arg);
+    return (false);
+  }
+  return (true);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void set_parameter (categorizer_parameters &p, uint8_t s_ind, uint16_t val)
+{
+  // ------------------- //
+  // R.6.2 set_parameter //  swept parameter s_ind of a sweep point (the value is in range, cf. parse_grid)
+  // ------------------- //
+  switch (s_ind) {
+    case 0: p.border_width=    val; break;
+    case 1: p.start_val=       val; break;
+    case 2: p.max_holes=       val; break;
+    case 3: p.first_hits=      val; break;
+    case 4: p.min_size=        val; break;
+    case 5: p.outlier_option=  val; break;
+    case 6: p.resorber_option= val; break;
+  }
+}
+
+uint16_t get_parameter (const categorizer_parameters &p, uint8_t s_ind)
+{
+  switch (s_ind) {
+    case 0:  return (p.border_width);
+    case 1:  return (p.start_val);
+    case 2:  return (p.max_holes);
+    case 3:  return (p.first_hits);
+    case 4:  return (p.min_size);
+    case 5:  return (p.outlier_option);
+    default: return (p.resorber_option);
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+int64_t now_ns ()
+{
+  // ------------ //
+  // R.6.3 now_ns //  monotonic clock [ns]
+  // ------------ //
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
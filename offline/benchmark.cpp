@@ -0,0 +1,975 @@
+#include <Arduino.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include "categorizer.h"
+#include "profiler.h"
+#include "trace_reader.h"
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  =============
+  = Benchmark =  off-line categorization of recorded traces (host build, not part of the sketch)
+  =============
+
+  usage:
+    benchmark [-r repetitions] [-t timeout_ms] [-o output] [-w golden | -c golden] trace_file ...
+    benchmark -g trace_count trace_file
+    benchmark -p receiver_output ...
+    benchmark -s [-r repetitions] trace_file ...
+    benchmark -x
+
+    -r  categorize each trace r times (timing), the output of the last run is kept
+    -t  hang guard: a categorization that takes longer is aborted and counted as "hang"
+    -o  write the categorizer output of all traces (to inspect a difference)
+    -w  write the golden file: one line per trace with return code and digest of the categorizer output
+    -c  compare with the golden file (exit code 1 if any trace differs)
+    -g  write trace_count synthetic traces (text format of receiver.ino: reporting)
+    -p  decode the packed categorized sequences of the files (CATEGORIZER_OUTPUT == PACKED_OUTPUT) to the standard output
+    -s  sort benchmark: sort and index_sort (cf. categorizer_lib.cpp: 3.7) against the insertion sorts,
+        on windows of 2 .. NO values of one level of each trace (r: repetitions per window set)
+    -x  separator check: separator and separator_shift (cf. categorizer.cpp: 2.7) against a reference, on fixed
+        cases (interleaved and one-pair runs, with and without (x, CEIL) ending, odd v_length) and random traces
+
+  the trace files hold receiver output (output_option 1, !TRACE!); traces with reader errors are skipped
+
+  B.1 main
+  B.2 categorize_trace: timed categorization with hang guard
+  B.3 golden_record: compare / write the golden record of a trace
+  B.4 summary: per-stage timings, return code distribution and pre-screen predictions
+  B.5 Synthetic Traces
+  B.5.1 synthetic_trace: random OOK sequence of a few duration levels
+  B.5.2 trace_writer: text trace (cf. receiver.ino: reporting)
+  B.6 Helper
+  B.6.1 stage_hook: stage boundary (cf. profiler.h: STAGE_MARK)
+  B.6.2 now_ns: monotonic clock
+  B.6.3 digest: FNV-1a hash of the categorizer output
+  B.7 Sort Benchmark
+  B.7.1 sort_benchmark: timed sorts of the windows of a trace
+  B.7.2 sort_summary: time per sort and window size
+  B.7.3 insertion_sort, insertion_index_sort: the reference (insertion sorts without network and key cache)
+  B.8 Separator Check
+  B.8.1 separator_check: the fixed cases and random collided traces
+  B.8.2 collided_trace: trace of the pairs of a tag string
+  B.8.3 separator_case: separator and separator_shift of one trace against the reference
+  B.8.4 separator_reference: the expected sub-sequences, by a forward scan
+
+*/
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#define DIM_V       (NV + 5)    // dim signal_duration (cf. receiver.ino)
+#define RC_HANG     (CRC_18 + 1)  // return code distribution: categorization aborted by the hang guard
+#define NRC         (RC_HANG + 1) // dim rc_count
+#define RC_SKIPPED  NRC         // golden record: trace skipped (reader error)
+#define TIMEOUT_MS   100        // default hang guard (a categorization takes less than 1 ms)
+#define GOLDEN_DIM    64        // maximal length of a golden record
+#define SEPARATOR_TRACES 10000  // random traces of the separator check
+
+// host serial output (cf. Arduino.h)
+HostSerial Serial;
+
+uint8_t categorize_trace (uint16_t v[], trace_record &t, uint16_t repetitions, long timeout_ms, bool &clusterable);
+bool    golden_record (uint32_t trace_ind, uint8_t rc, FILE *golden_out, FILE *golden_in);
+void    summary (uint32_t trace_count, uint32_t error_count, uint16_t repetitions);
+void    synthetic_trace (uint16_t v[], trace_record &t);
+void    trace_writer (FILE *out, uint16_t v[], trace_record &t);
+void    stage_hook (uint8_t stage);
+int64_t now_ns ();
+uint32_t digest (const char s[], size_t n);
+void    sort_benchmark (uint16_t v[], trace_record &t, uint16_t repetitions);
+void    sort_summary (uint32_t trace_count);
+void    insertion_sort (uint16_t v[], uint16_t n);
+void    insertion_index_sort (duration_seq v, uint16_t v_ind[], uint16_t n);
+bool    separator_check ();
+uint16_t collided_trace (uint16_t v[], uint8_t transmitter[], const char tags[], char ending, bool random);
+void    separator_case (const char name[], uint16_t v[], uint16_t v_length, const uint8_t transmitter[]);
+bool    separator_reference (uint16_t d[], uint16_t v_length, const uint8_t transmitter[], uint16_t e[], uint16_t e_length[], uint16_t e_unreliable[]);
+
+// stage timing
+uint8_t  stage_open;                    // stage in progress (STAGE_NONE: none)
+int64_t  stage_start;                   // start time of the stage in progress [ns]
+int64_t  stage_total[STAGE_COUNT + 1];  // accumulated time per stage [ns] ([STAGE_COUNT]: categorizer)
+int64_t  stage_max[STAGE_COUNT + 1];    // longest run per stage [ns]
+uint32_t stage_calls[STAGE_COUNT + 1];  // number of runs per stage
+int64_t  run_time[STAGE_COUNT + 1];     // time per stage of the current run [ns]
+
+// categorizer parameters: the defaults of categorizer.h (cf. batch.cpp: parameter sweep)
+const categorizer_parameters parameters= CATEGORIZER_DEFAULTS;
+
+// distribution of the categorizer return codes (first run of each trace)
+uint32_t rc_count[NRC];
+// pre-screen (cf. categorizer.cpp: prescreener): return codes of the traces predicted unclusterable
+uint32_t screen_count[NRC];
+int64_t  screen_total;                  // accumulated time of the pre-screen [ns]
+
+// number of traces that differ from the golden file
+uint32_t golden_diff_count;
+
+// sort benchmark per window size: [0]: sort, [1]: insertion_sort, [2]: index_sort, [3]: insertion_index_sort
+int64_t  sort_time[4][NO + 1];          // accumulated time [ns]
+uint32_t sort_calls[NO + 1];            // number of sorted windows (per sort)
+uint32_t sort_errors;                   // windows sorted differently than by the reference
+
+// separator check (cf. categorizer.cpp: 2.7)
+uint32_t separator_count;               // checked traces
+uint32_t separator_split;               // of which split into two sub-sequences
+uint32_t separator_errors;              // traces separated differently than by the reference
+
+// hang guard
+sigjmp_buf hang_jump;
+void hang_handler (int sig) {siglongjmp(hang_jump, 1);}
+
+// pseudo random numbers of the synthetic traces (portable linear congruential generator)
+uint32_t lcg_state;
+uint16_t lcg (uint16_t n) {lcg_state= lcg_state * 1103515245UL + 12345UL; return (uint16_t)((lcg_state >> 16) % n);}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+int main (int argc, char *argv[])
+{
+  // ******** //
+  // B.1 main //
+  // ******** //
+  static uint16_t v[DIM_V];   // signal_duration
+  trace_record t;
+  uint16_t repetitions;       // number of runs per trace
+  long     timeout_ms;        // hang guard
+  const char *output;         // categorizer output file (NULL: none)
+  const char *golden_write;   // golden file to write (NULL: none)
+  const char *golden_check;   // golden file to compare with (NULL: none)
+  long     synthetic_count;   // number of synthetic traces to write (0: benchmark)
+  bool     packed;            // decode packed categorized sequences (no benchmark)
+  bool     sorting;           // sort benchmark (no categorization)
+  bool     separating;        // separator check (no trace file)
+  bool     clusterable;       // pre-screen prediction of the trace
+  FILE     *in;
+  FILE     *out;
+  FILE     *golden_out;
+  FILE     *golden_in;
+  char     line[GOLDEN_DIM];
+  uint32_t trace_count;       // number of categorized traces
+  uint32_t error_count;       // number of skipped traces (reader errors)
+  uint32_t trace_ind;         // trace number (1: first trace of the first file)
+  uint8_t  rc;
+  int      opt;
+  int      arg_ind;
+
+  repetitions= 1;
+  timeout_ms= TIMEOUT_MS;
+  output= NULL;
+  golden_write= NULL;
+  golden_check= NULL;
+  synthetic_count= 0;
+  packed= false;
+  sorting= false;
+  separating= false;
+  while ((opt= getopt(argc, argv, "r:t:o:w:c:g:psx")) != -1) {
+    switch (opt) {
+      case 'r': repetitions= max(1, atoi(optarg)); break;
+      case 't': timeout_ms= atol(optarg); break;
+      case 'o': output= optarg; break;
+      case 'w': golden_write= optarg; break;
+      case 'c': golden_check= optarg; break;
+      case 'g': synthetic_count= atol(optarg); break;
+      case 'p': packed= true; break;
+      case 's': sorting= true; break;
+      case 'x': separating= true; break;
+      default:
+        fprintf(stderr, "usage: %s [-r repetitions] [-t timeout_ms] [-o output] [-w golden | -c golden] trace_file ...\n", argv[0]);
+        fprintf(stderr, "       %s -g trace_count trace_file\n", argv[0]);
+        fprintf(stderr, "       %s -p receiver_output ...\n", argv[0]);
+        fprintf(stderr, "       %s -s [-r repetitions] trace_file ...\n", argv[0]);
+        fprintf(stderr, "       %s -x\n", argv[0]);
+        return (2);
+    }
+  }
+  // separator check
+  // ---------------
+  if (separating) return (separator_check() ? 0 : 1);
+  if (optind >= argc) {
+    fprintf(stderr, "%s: no trace file\n", argv[0]);
+    return (2);
+  }
+
+  // synthetic traces
+  // ----------------
+  if (synthetic_count > 0) {
+    if ((in= fopen(argv[optind], "w")) == NULL) {perror(argv[optind]); return (2);}
+    for (lcg_state= 1; synthetic_count > 0; synthetic_count--) {
+      synthetic_trace(v, t);
+      trace_writer(in, v, t);
+    }
+    fclose(in);
+    return (0);
+  }
+
+  // packed categorized sequences
+  // -----------------------------
+  if (packed) {
+    for (arg_ind= optind; arg_ind < argc; arg_ind++) {
+      if ((in= fopen(argv[arg_ind], "r")) == NULL) {perror(argv[arg_ind]); return (2);}
+      while ((rc= packed_sequence_reader(in, stdout)) != TRC_1) {
+        if (rc != TRC_0) fprintf(stderr, "%s: packed sequence skipped (trace reader return code %u)\n", argv[arg_ind], rc);
+        printf("\n");
+      }
+      fclose(in);
+    }
+    return (0);
+  }
+
+  // sort benchmark
+  // --------------
+  if (sorting) {
+    trace_count= 0;
+    for (arg_ind= optind; arg_ind < argc; arg_ind++) {
+      if ((in= fopen(argv[arg_ind], "r")) == NULL) {perror(argv[arg_ind]); return (2);}
+      while ((rc= text_trace_reader(in, v, DIM_V, t)) != TRC_1) {
+        if ((rc != TRC_0) || (t.count > NV)) continue;
+        sort_benchmark(v, t, repetitions);
+        trace_count++;
+      }
+      fclose(in);
+    }
+    sort_summary(trace_count);
+    return ((sort_errors > 0) ? 1 : 0);
+  }
+
+  // output and golden files
+  // ------------------------
+  out= NULL;
+  golden_out= NULL;
+  golden_in= NULL;
+  if (output) {
+    if ((out= fopen(output, "w")) == NULL) {perror(output); return (2);}
+  }
+  if (golden_write) {
+    if ((golden_out= fopen(golden_write, "w")) == NULL) {perror(golden_write); return (2);}
+  }
+  if (golden_check) {
+    if ((golden_in= fopen(golden_check, "r")) == NULL) {perror(golden_check); return (2);}
+  }
+
+  // categorize all traces
+  // ---------------------
+  // the categorizer output is captured (cf. Arduino.h)
+  Serial.out= NULL;
+  trace_count= 0;
+  error_count= 0;
+  for (arg_ind= optind; arg_ind < argc; arg_ind++) {
+    if ((in= fopen(argv[arg_ind], "r")) == NULL) {perror(argv[arg_ind]); return (2);}
+    while ((rc= text_trace_reader(in, v, DIM_V, t)) != TRC_1) {
+      trace_ind= trace_count + error_count + 1;
+      if ((rc == TRC_0) && (t.count > NV)) rc= TRC_4;
+      if (rc != TRC_0) {
+        fprintf(stderr, "%s: trace %u skipped (trace reader return code %u)\n", argv[arg_ind], trace_ind, rc);
+        error_count++;
+        Serial.clear();
+        golden_record(trace_ind, RC_SKIPPED, golden_out, golden_in);
+        continue;
+      }
+      rc= categorize_trace(v, t, repetitions, timeout_ms, clusterable);
+      rc_count[rc]++;
+      if (!clusterable) screen_count[rc]++;
+      trace_count++;
+      golden_record(trace_ind, rc, golden_out, golden_in);
+      if (out) {
+        fprintf(out, "=== trace %u\n", trace_ind);
+        fwrite(Serial.text, 1, Serial.length, out);
+      }
+    }
+    fclose(in);
+  }
+  if (out) fclose(out);
+  if (golden_out) fclose(golden_out);
+
+  summary(trace_count, error_count, repetitions);
+  if (golden_check) {
+    // traces missing in the trace files
+    while (fgets(line, GOLDEN_DIM, golden_in) != NULL) golden_diff_count++;
+    fclose(golden_in);
+    printf("\ngolden: %u differences (%s)\n", golden_diff_count, golden_check);
+    if (golden_diff_count > 0) return (1);
+  }
+  return (0);
+
+} // end main
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint8_t categorize_trace (  // return code of the first run (RC_HANG: aborted by the hang guard)
+  uint16_t v[],             // I  signal sequence (not modified: the categorizer works on a copy)
+  trace_record &t,          // I  trace header
+  uint16_t repetitions,     // I  number of runs
+  long     timeout_ms,      // I  hang guard per run
+  bool     &clusterable     // O  pre-screen prediction (prescreener, first run)
+) {
+  // ************************ //
+  // B.2 categorize_trace     //  timed categorization with hang guard
+  // ************************ //
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  static uint8_t  duration_code[DIM_V];
+  static uint8_t  duration_flag[(DIM_V + 7) / 8];
+  duration_seq    signal_duration= {duration_code, duration_flag};
+  uint16_t        v_ind;
+#else
+  static uint16_t signal_duration[DIM_V];
+#endif
+  static categories duration_category[2];
+  static uint8_t  uint8buf32[DIM_32];
+  static uint16_t uint16buf64[DIM_64];
+  static uint8_t  trusted[DIM_T];
+  static uint8_t  return_code;
+  static uint8_t  first_rc;
+  static uint16_t run;
+  struct itimerval guard;
+  int64_t  stop;
+  uint8_t  s_ind;
+
+  signal(SIGALRM, hang_handler);
+  memset(&guard, 0, sizeof(guard));
+  first_rc= CRC_0;
+  for (run= 0; run < repetitions; run++) {
+    // the categorizer corrects the signal sequence in place
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+    // encoded as by the recorder (cf. durations.h)
+    for (v_ind= 0; v_ind < t.count + 3; v_ind++) signal_duration[v_ind]= v[v_ind];
+#else
+    memcpy(signal_duration, v, (t.count + 3) * sizeof(uint16_t));
+#endif
+    memset(duration_category, 0, sizeof(duration_category));
+    for (s_ind= 0; s_ind <= STAGE_COUNT; s_ind++) run_time[s_ind]= 0;
+    Serial.clear();
+    return_code= 0;
+    stage_open= STAGE_NONE;
+
+    if (sigsetjmp(hang_jump, 1) != 0) {
+      // the hang guard fired: the categorizer did not terminate
+      stage_open= STAGE_NONE;
+      Serial.clear();
+      if (run == 0) {
+        Serial.print(F("hang guard: categorization aborted"));
+        Serial.println();
+      }
+      return (RC_HANG);
+    }
+    guard.it_value.tv_sec=  timeout_ms / 1000;
+    guard.it_value.tv_usec= (timeout_ms % 1000) * 1000;
+    setitimer(ITIMER_REAL, &guard, NULL);
+
+    if (run == 0) {
+      // pre-screen of the recorded sequence (not a stage: receiver.ino calls it before the reporting)
+      stop= now_ns();
+      clusterable= prescreener (signal_duration, t.count, t.unreliable_count, uint8buf32);
+      screen_total+= now_ns() - stop;
+    }
+    run_time[STAGE_COUNT]= now_ns();
+    categorizer (duration_category, signal_duration, t.count, t.unreliable_count, 0, parameters, return_code,
+                 uint8buf32, uint16buf64, trusted);
+    if (return_code == CRC_0) categorizer_printer (duration_category, signal_duration, t.count, uint8buf32, uint16buf64);
+    stop= now_ns();
+
+    guard.it_value.tv_sec=  0;
+    guard.it_value.tv_usec= 0;
+    setitimer(ITIMER_REAL, &guard, NULL);
+
+    // close the stage in progress
+    if (stage_open < STAGE_COUNT) run_time[stage_open]+= stop - stage_start;
+    run_time[STAGE_COUNT]= stop - run_time[STAGE_COUNT];
+    for (s_ind= 0; s_ind <= STAGE_COUNT; s_ind++) {
+      if ((s_ind == STAGE_COUNT) || (run_time[s_ind] > 0)) {
+        stage_total[s_ind]+= run_time[s_ind];
+        stage_calls[s_ind]++;
+        if (run_time[s_ind] > stage_max[s_ind]) stage_max[s_ind]= run_time[s_ind];
+      }
+    }
+    if (run == 0) {
+      first_rc= return_code;
+    } else {
+      // the categorizer is deterministic
+      if (return_code != first_rc) fprintf(stderr, "run %u: return code %u differs\n", run, return_code);
+    }
+  }
+  return (first_rc);
+
+} // end categorize_trace
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool golden_record (    // true: the golden record is identical
+  uint32_t trace_ind,   // I  trace number (1: first trace of the first file)
+  uint8_t  rc,          // I  return code (RC_HANG: aborted, RC_SKIPPED: reader error)
+  FILE     *golden_out, // I  golden file to write (NULL: none)
+  FILE     *golden_in   // I  golden file to compare with (NULL: none)
+) {
+  // ******************** //
+  // B.3 golden_record    //  compare / write the golden record of a trace
+  // ******************** //
+  // record: "<trace_ind> <rc | hang | skipped> <digest of the categorizer output>"
+  char record[GOLDEN_DIM];
+  char line[GOLDEN_DIM];
+
+  if (rc == RC_SKIPPED) snprintf(record, sizeof(record), "%u skipped\n", trace_ind);
+  else if (rc == RC_HANG) snprintf(record, sizeof(record), "%u hang %08x\n", trace_ind, digest(Serial.text, Serial.length));
+  else snprintf(record, sizeof(record), "%u rc %u %08x\n", trace_ind, rc, digest(Serial.text, Serial.length));
+  if (golden_out) fputs(record, golden_out);
+  if (golden_in == NULL) return (true);
+
+  if (fgets(line, GOLDEN_DIM, golden_in) == NULL) line[0]= '\0';
+  if (strcmp(line, record) == 0) return (true);
+  printf("trace %u differs from golden:\t%.*s\t(golden: %.*s)\n", trace_ind,
+         (int)strcspn(record, "\n"), record, (int)strcspn(line, "\n"), line);
+  golden_diff_count++;
+  return (false);
+
+} // end golden_record
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void summary (uint32_t trace_count, uint32_t error_count, uint16_t repetitions)
+{
+  // *********** //
+  // B.4 summary //  per-stage timings, return code distribution and pre-screen predictions
+  // *********** //
+  const char *stage_name[STAGE_COUNT + 1]= {"warm-up", "recording", "clusterer", "histogram passes",
+                                            "corrector 2.2.1", "corrector 2.2.2", "sequence_printer", "categorizer"};
+  uint8_t s_ind;
+  uint8_t rc;
+
+  printf("traces: %u categorized, %u skipped (%u runs per trace)\n", trace_count, error_count, repetitions);
+  printf("\n%-18s %10s %12s %12s %12s\n", "stage", "runs", "total [ms]", "mean [us]", "max [us]");
+  // the recorder stages do not occur off-line
+  for (s_ind= STAGE_CLUSTERER; s_ind <= STAGE_COUNT; s_ind++) {
+    printf("%-18s %10u %12.3f %12.3f %12.3f\n", stage_name[s_ind], stage_calls[s_ind],
+           stage_total[s_ind] / 1e6,
+           stage_calls[s_ind] ? stage_total[s_ind] / 1e3 / stage_calls[s_ind] : 0.0,
+           stage_max[s_ind] / 1e3);
+  }
+  printf("\ncategorizer return codes\n");
+  for (rc= 0; rc < NRC; rc++) {
+    if (rc_count[rc] == 0) continue;
+    if (rc == RC_HANG) printf("hang  ");
+    else printf("CRC_%-2u", rc);
+    printf(" %8u %7.2f %%\n", rc_count[rc], trace_count ? 100.0 * rc_count[rc] / trace_count : 0.0);
+  }
+  // the traces predicted unclusterable per return code: CRC_0 are false predictions (lost receptions)
+  printf("\npre-screen: predicted unclusterable (mean %.3f us per trace)\n", trace_count ? screen_total / 1e3 / trace_count : 0.0);
+  for (rc= 0; rc < NRC; rc++) {
+    if (screen_count[rc] == 0) continue;
+    if (rc == RC_HANG) printf("hang  ");
+    else printf("CRC_%-2u", rc);
+    printf(" %8u of %8u%s\n", screen_count[rc], rc_count[rc], (rc == CRC_0) ? "  (false predictions)" : "");
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ******************** //
+// B.5 Synthetic Traces //
+// ******************** //
+
+void synthetic_trace (
+  uint16_t v[],       // O  signal sequence: [odd indices]: HIGH-durations, [even indices]: LOW-durations
+  trace_record &t     // O  count, unreliable_count and strengths
+) {
+  // ----------------------- //
+  // B.5.1 synthetic_trace   //  random OOK sequence of a few duration levels
+  // ----------------------- //
+  // per level 1 .. 4 duration categories, jitter, outliers, unreliable values and CEIL pauses
+  uint16_t center[2][4];  // category centers: [1]: HIGH, [0]: LOW
+  uint8_t  center_size[2];
+  uint16_t jitter;        // maximal deviation from the center
+  uint8_t  unreliable;    // rate of unreliable subsequences [%]
+  uint8_t  outliers;      // rate of outliers [%]
+  uint16_t n;
+  uint16_t ind;
+  int32_t  val;
+  uint8_t  z_ind;
+
+  n= (40 + lcg(400)) & ~1;
+  for (z_ind= 0; z_ind < 2; z_ind++) {
+    center_size[z_ind]= 1 + lcg(4);
+    for (ind= 0; ind < center_size[z_ind]; ind++) center[z_ind][ind]= 100 + lcg(3000);
+  }
+  jitter= 1 + lcg(60);
+  unreliable= lcg(3);
+  outliers= lcg(4);
+  // a fifth of the traces is noise
+  if (lcg(5) == 0) jitter= lcg(1500);
+
+  t.unreliable_count= 0;
+  for (ind= 1; ind <= n; ind++) {
+    z_ind= ind & 1;
+    val= center[z_ind][lcg(center_size[z_ind])] + lcg(2 * jitter + 1) - jitter;
+    if (lcg(100) < outliers) val= 50 + lcg(5000);
+    if (lcg(200) == 0) val= CEIL;
+    if (val < 2) val= 2;
+    v[ind]= val & MSB;
+  }
+  // unreliable values come in pairs or triples (cf. recorder: at most three consecutive unreliable signals)
+  for (ind= BORDER_WIDTH + 1; ind + BORDER_WIDTH + 3 < n; ind++) {
+    if (lcg(100) >= unreliable) continue;
+    for (val= 2 + lcg(2); val > 0; val--, ind++) {
+      v[ind]|= UNRELIABLE;
+      t.unreliable_count++;
+    }
+    // at least three reliable signals
+    ind+= 3;
+  }
+  // "ending": a zero duration (0, 0) or a pause (x, CEIL)
+  if (lcg(2)) {
+    v[n + 1]= 0;
+    v[n + 2]= 0;
+  } else {
+    v[n + 1]= center[HIGH][0] & MSB;
+    v[n + 2]= CEIL;
+  }
+  t.count= n;
+  t.checksum= trace_checksum(v, n + 2);
+
+  // signal strengths obtained during warm-up
+  t.strength_count= min(TRACE_STRENGTHS - 1, n);
+  for (ind= 1; ind <= t.strength_count; ind++) t.strength[ind]= (ind & 1) ? 60 + lcg(10) : 20 + lcg(10);
+  t.ref_strength_high= (t.strength[5] + t.strength[7]) >> 1;
+  t.ref_strength_low=  (t.strength[6] + t.strength[8]) >> 1;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void trace_writer (
+  FILE     *out,      // I  trace file
+  uint16_t v[],       // I  signal sequence: v[1 .. count + 2] ("ending" included)
+  trace_record &t     // I  count, unreliable_count, strengths and checksum
+) {
+  // -------------------- //
+  // B.5.2 trace_writer   //  text trace (cf. receiver.ino: reporting)
+  // -------------------- //
+  uint16_t ind;
+  uint16_t k;
+
+  // signal strengths obtained during warm-up
+  fprintf(out, "\nsignal-strength\n");
+  for (ind= 1; ind <= t.strength_count; ind++) {
+    fprintf(out, "%u\t%u", ind, t.strength[ind]);
+    if (++ind <= t.strength_count) fprintf(out, " / %u", t.strength[ind]);
+    fprintf(out, "\n");
+  }
+  // TRACE: all duration values, "ending" included
+  fprintf(out, "!TRACE!\n");
+  k= t.count + 2;
+  for (ind= 1; ind <= k; ind+= 2) fprintf(out, "%u\t%u\t%u\n", ind, v[ind], v[ind + 1]);
+  // checkout record and end-of-data record
+  fprintf(out, "%u\t%u\n", t.checksum, t.unreliable_count);
+  fprintf(out, "-1\t -1\n");
+  // reference strength
+  fprintf(out, "\nref_strength: %u %u\n", t.ref_strength_high, t.ref_strength_low);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ********** //
+// B.6 Helper //
+// ********** //
+
+void stage_hook (uint8_t stage)
+{
+  // ---------------- //
+  // B.6.1 stage_hook //  stage boundary: close the stage in progress, open the next one (cf. categorizer.h)
+  // ---------------- //
+  int64_t now= now_ns();
+  if (stage_open < STAGE_COUNT) run_time[stage_open]+= now - stage_start;
+  stage_open= stage;
+  stage_start= now;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+int64_t now_ns ()
+{
+  // ------------ //
+  // B.6.2 now_ns //  monotonic clock [ns]
+  // ------------ //
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint32_t digest (const char s[], size_t n)
+{
+  // ------------ //
+  // B.6.3 digest //  FNV-1a hash of the categorizer output
+  // ------------ //
+  uint32_t h= 2166136261UL;
+  size_t   ind;
+  for (ind= 0; ind < n; ind++) {
+    h^= (uint8_t)s[ind];
+    h*= 16777619UL;
+  }
+  return (h);
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ****************** //
+// B.7 Sort Benchmark //
+// ****************** //
+
+void sort_benchmark (
+  uint16_t v[],             // I  signal sequence: v[1 .. count + 2]
+  trace_record &t,          // I  trace header
+  uint16_t repetitions      // I  number of runs per window set
+) {
+  // -------------------- //
+  // B.7.1 sort_benchmark //  timed sorts of the windows of a trace
+  // -------------------- //
+  // the windows hold n consecutive values of one level (as the outliers and top values of the categorizer),
+  // each window set is sorted by the categorizer library and by the reference, the results must be equal
+  static uint16_t a[DIM_V];         // windows: sort
+  static uint16_t b[DIM_V];         // windows: reference
+  static uint16_t a_ind[DIM_V];     // windows: index_sort
+  static uint16_t b_ind[DIM_V];     // windows: reference
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  static uint8_t  duration_code[DIM_V];
+  static uint8_t  duration_flag[(DIM_V + 7) / 8];
+  duration_seq    s= {duration_code, duration_flag};
+#else
+  duration_seq    s= v;
+#endif
+  uint16_t w_count;                 // number of values per level
+  uint16_t n;                       // window size
+  uint16_t k;                       // window start
+  uint16_t ind;
+  uint16_t run;
+  uint8_t  z_ind;
+  int64_t  start;
+
+  for (ind= 0; ind < t.count + 3; ind++) s[ind]= v[ind];
+  for (z_ind= 0; z_ind < 2; z_ind++) {
+    w_count= t.count / 2;
+    for (n= 2; n <= NO; n++) {
+      if (w_count < n) break;
+      for (run= 0; run < repetitions; run++) {
+        // windows of values: v[2 - z_ind], v[4 - z_ind], ...
+        for (k= 0; k + n <= w_count; k++) a[k]= b[k]= v[2 * k + 2 - z_ind];
+        for (k= 0; k + n <= w_count; k++) a_ind[k]= b_ind[k]= 2 * k + 2 - z_ind;
+        start= now_ns();
+        for (k= 0; k + n <= w_count; k+= n) sort(&a[k], n);
+        sort_time[0][n]+= now_ns() - start;
+        start= now_ns();
+        for (k= 0; k + n <= w_count; k+= n) insertion_sort(&b[k], n);
+        sort_time[1][n]+= now_ns() - start;
+        start= now_ns();
+        for (k= 0; k + n <= w_count; k+= n) index_sort(s, &a_ind[k], n);
+        sort_time[2][n]+= now_ns() - start;
+        start= now_ns();
+        for (k= 0; k + n <= w_count; k+= n) insertion_index_sort(s, &b_ind[k], n);
+        sort_time[3][n]+= now_ns() - start;
+        sort_calls[n]+= w_count / n;
+        for (k= 0; k + n <= w_count; k++) {
+          if ((a[k] != b[k]) || (a_ind[k] != b_ind[k])) {sort_errors++; break;}
+        }
+      }
+    }
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void sort_summary (uint32_t trace_count)
+{
+  // ------------------ //
+  // B.7.2 sort_summary //  time per sort and window size
+  // ------------------ //
+  const char *sort_name[4]= {"sort", "insertion", "index_sort", "insertion"};
+  int64_t  total[4];
+  uint32_t calls;
+  uint16_t n;
+  uint8_t  k;
+
+  printf("sort benchmark: %u traces, windows of one level\n", trace_count);
+  printf("\n%4s %10s", "n", "windows");
+  for (k= 0; k < 4; k++) printf(" %12s", sort_name[k]);
+  printf("    [ns per window]\n");
+  for (k= 0; k < 4; k++) total[k]= 0;
+  calls= 0;
+  for (n= 2; n <= NO; n++) {
+    if (sort_calls[n] == 0) continue;
+    printf("%4u %10u", n, sort_calls[n]);
+    for (k= 0; k < 4; k++) {
+      printf(" %12.1f", (double)sort_time[k][n] / sort_calls[n]);
+      total[k]+= sort_time[k][n];
+    }
+    printf("\n");
+    calls+= sort_calls[n];
+  }
+  printf("\ntotal [ms]     ");
+  for (k= 0; k < 4; k++) printf(" %12.3f", total[k] / 1e6);
+  printf("\nsort: %.2f x, index_sort: %.2f x faster than the reference, %u windows sorted differently\n",
+         total[0] ? (double)total[1] / total[0] : 0.0, total[2] ? (double)total[3] / total[2] : 0.0, sort_errors);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void insertion_sort (uint16_t v[], uint16_t n)
+{
+  // ---------------------------------------------- //
+  // B.7.3 insertion_sort, insertion_index_sort     //  the reference: yaneurao's insertion sorts (ascending)
+  // ---------------------------------------------- //
+  uint16_t  i, j;
+  uint16_t  tmp;
+  for (i= 1; i < n; i++) {
+    tmp= v[i];
+    if (v[i-1] > tmp) {
+      j= i;
+      do {v[j]= v[j-1]; --j;} while (j > 0 && v[j-1] > tmp);
+      v[j]= tmp;
+    }
+  }
+}
+
+void insertion_index_sort (duration_seq v, uint16_t v_ind[], uint16_t n)
+{
+  uint16_t  i, j;
+  uint16_t  tmp_ind;
+  for (i= 1; i < n; i++) {
+    tmp_ind= v_ind[i];
+    if (v[v_ind[i-1]] > v[tmp_ind]) {
+      j= i;
+      do {v_ind[j]= v_ind[j-1]; --j;} while (j > 0 && v[v_ind[j-1]] > v[tmp_ind]);
+      v_ind[j]= tmp_ind;
+    }
+  }
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ******************* //
+// B.8 Separator Check //
+// ******************* //
+
+bool separator_check ()
+{
+  // --------------------- //
+  // B.8.1 separator_check //  the fixed cases and random collided traces (returns true, if all are separated as by the reference)
+  // --------------------- //
+  // tags: transmitter of each pair ('0': reference, '1': other transmitter), the ending of the trace:
+  // 'c': (x, CEIL), the last tag is the one of x; 'z': (0, 0); 'h': (0, 0) after a HIGH without LOW (odd v_length)
+  const struct {const char *name; const char *tags; char ending;} fixed[]= {
+    {"interleaved runs",                 "00110100", 'c'},
+    {"without (x, CEIL) ending",         "00110100", 'z'},
+    {"odd v_length",                     "00110100", 'h'},
+    {"one-pair runs",                    "01010101", 'c'},
+    {"one-pair runs, odd v_length",      "0101010",  'h'},
+    {"one pair of the other (no split)", "00010000", 'c'}
+  };
+  static uint16_t v[DIM_V];
+  static uint8_t  transmitter[TRANSMITTER_DIM(NV)];
+  char     tags[NV / 2 + 1];
+  uint16_t v_length;
+  uint16_t n;                 // number of pairs
+  uint16_t k;
+  uint8_t  tag;
+  char     ending;
+
+  printf("separator check (cf. categorizer.cpp: 2.7)\n");
+  for (k= 0; k < sizeof(fixed) / sizeof(fixed[0]); k++) {
+    v_length= collided_trace(v, transmitter, fixed[k].tags, fixed[k].ending, false);
+    separator_case(fixed[k].name, v, v_length, transmitter);
+  }
+  // random traces: runs of 1 .. 4 pairs, some unreliable values and long LOWs (merged LOWs up to CEIL)
+  for (lcg_state= 1, k= 0; k < SEPARATOR_TRACES; k++) {
+    n= 3 + lcg(58);
+    tag= lcg(2);
+    for (v_length= 0; v_length < n; v_length++) {
+      if (lcg(4) == 0) tag^= 1;
+      tags[v_length]= '0' + tag;
+    }
+    tags[n]= '\0';
+    ending= "czh"[lcg(3)];
+    v_length= collided_trace(v, transmitter, tags, ending, true);
+    separator_case(NULL, v, v_length, transmitter);
+  }
+  printf("\nseparator: %u traces, %u split, %u separated differently than by the reference\n",
+         separator_count, separator_split, separator_errors);
+  return (separator_errors == 0);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint16_t collided_trace (
+  uint16_t v[],             // O  signal sequence: v[1 .. v_length + 2]
+  uint8_t transmitter[],    // O  packed transmitter tags of the HIGHs
+  const char tags[],        // I  transmitter per pair (cf. separator_check)
+  char ending,              // I  'c': (x, CEIL), 'z': (0, 0), 'h': HIGH without LOW, then (0, 0)
+  bool random               // I  random durations (false: HIGH 100 * pair, LOW 10 * pair)
+) {
+  // -------------------- //
+  // B.8.2 collided_trace //  trace of the pairs of a tag string, returns v_length
+  // -------------------- //
+  uint16_t n;               // number of pairs
+  uint16_t p;
+
+  n= strlen(tags);
+  memset(transmitter, 0, TRANSMITTER_DIM(NV));
+  for (p= 0; p < n; p++) {
+    if (random) {
+      v[2 * p + 1]= 2 * (50 + lcg(1000)) | ((lcg(8) == 0) ? UNRELIABLE : RELIABLE);
+      v[2 * p + 2]= 2 * ((lcg(16) == 0) ? 10000 + lcg(20000) : 20 + lcg(1000)) | ((lcg(8) == 0) ? UNRELIABLE : RELIABLE);
+    } else {
+      v[2 * p + 1]= 100 * (p + 1);
+      v[2 * p + 2]= 10 * (p + 1);
+    }
+    if (tags[p] == '1') TRANSMITTER_SET(transmitter, 2 * p + 1);
+  }
+  v[0]= 0;
+  if (ending == 'c') {v[2 * n]= CEIL; return (2 * n - 2);}
+  if (ending == 'z') {v[2 * n + 1]= v[2 * n + 2]= 0; return (2 * n);}
+  v[2 * n]= v[2 * n + 1]= 0;
+  return (2 * n - 1);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void separator_case (
+  const char name[],        // I  name of a fixed case, printed with the sub-sequences (NULL: random trace)
+  uint16_t v[],             // I  signal sequence: v[1 .. v_length + 2]
+  uint16_t v_length,        // I  number of signal durations
+  const uint8_t transmitter[] // I packed transmitter tags of the HIGHs
+) {
+  // -------------------- //
+  // B.8.3 separator_case //  separator and separator_shift of one trace against the reference
+  // -------------------- //
+  static uint16_t d[DIM_V];         // trace as stored (input of the reference)
+  static uint16_t e[DIM_V];         // the reference: separated sequence
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  static uint8_t  s_code[DIM_V];
+  static uint8_t  s_flag[(DIM_V + 7) / 8];
+  static uint8_t  q_code[DIM_V];
+  static uint8_t  q_flag[(DIM_V + 7) / 8];
+  duration_seq    s= {s_code, s_flag};
+  duration_seq    q= {q_code, q_flag};
+#else
+  static uint16_t s_val[DIM_V];
+  static uint16_t q_val[DIM_V];
+  duration_seq    s= s_val;
+  duration_seq    q= q_val;
+#endif
+  uint16_t s_length[2];             // separator: [0]: other, [1]: reference transmitter
+  uint16_t s_unreliable[2];
+  uint16_t e_length[2];             // the reference
+  uint16_t e_unreliable[2];
+  uint16_t ind;
+  bool     split;
+  bool     e_split;
+  bool     equal;
+
+  for (ind= 0; ind < v_length + 3; ind++) s[ind]= v[ind];
+  for (ind= 0; ind < v_length + 3; ind++) d[ind]= s[ind];
+  e_split= separator_reference(d, v_length, transmitter, e, e_length, e_unreliable);
+  // the merged LOWs stored as by the separator (LOG8_DURATIONS: encoded)
+  for (ind= 0; ind < v_length + 3; ind++) q[ind]= e[ind];
+
+  split= separator(s, v_length, transmitter, s_length, s_unreliable);
+  equal= (split == e_split);
+  for (ind= 1; equal && (ind < v_length + 3); ind++) equal= ((uint16_t)s[ind] == (uint16_t)q[ind]);
+  if (equal && split) {
+    equal= (s_length[0] == e_length[0]) && (s_length[1] == e_length[1])
+        && (s_unreliable[0] == e_unreliable[0]) && (s_unreliable[1] == e_unreliable[1]);
+  }
+  if (name) {
+    printf("\n%s: v_length %u, ", name, v_length);
+    if (split) {
+      printf("s_length %u %u, s_unreliable %u %u\n  other    :", s_length[0], s_length[1], s_unreliable[0], s_unreliable[1]);
+      for (ind= 1; ind <= s_length[0] + 2; ind++) printf(" %u", (uint16_t)s[ind]);
+    } else printf("not split");
+  }
+  if (split) {
+    separator_shift(s, s_length[0] + 2, s_length[1] + 2);
+    for (ind= 1; equal && (ind <= s_length[1] + 2); ind++) equal= ((uint16_t)s[ind] == (uint16_t)q[s_length[0] + 2 + ind]);
+    if (name) {
+      printf("\n  reference:");
+      for (ind= 1; ind <= s_length[1] + 2; ind++) printf(" %u", (uint16_t)s[ind]);
+    }
+    separator_split++;
+  }
+  if (name) printf("\n  %s\n", equal ? "as the reference" : "DIFFERENT from the reference");
+  if (!equal) separator_errors++;
+  separator_count++;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool separator_reference (
+  uint16_t d[],             // I  signal sequence: d[1 .. v_length + 2]
+  uint16_t v_length,        // I  number of signal durations
+  const uint8_t transmitter[], // I packed transmitter tags of the HIGHs
+  uint16_t e[],             // O  separated sequence (unchanged d[], if not split)
+  uint16_t e_length[],      // O  [0]: other, [1]: reference transmitter: number of signal durations of the sub-sequence
+  uint16_t e_unreliable[]   // O  number of unreliable values of the sub-sequence
+) {
+  // ------------------------- //
+  // B.8.4 separator_reference //  the expected sub-sequences, by a forward scan (cf. categorizer.cpp: separator)
+  // ------------------------- //
+  // a pair is a HIGH and the following LOW, a last HIGH without LOW (odd v_length) is dropped;
+  // per transmitter: its pairs, where the LOW extends up to its next HIGH, the LOW of its last pair is CEIL
+  uint16_t p_count;         // number of pairs
+  uint16_t count[2];        // number of pairs per transmitter tag
+  uint16_t p, q, r;
+  uint16_t ind;
+  uint16_t low;
+  uint32_t sum;
+  uint8_t  k;
+  uint8_t  tag;
+
+  for (ind= 0; ind < v_length + 3; ind++) e[ind]= d[ind];
+  p_count= v_length / 2 + ((d[v_length + 1] != 0) ? 1 : 0);
+  count[0]= count[1]= 0;
+  for (p= 0; p < p_count; p++) count[TRANSMITTER_OF(transmitter, 2 * p + 1)]++;
+  if ((count[0] < 2) || (count[1] < 2)) return (false);
+
+  ind= 1;
+  for (k= 0; k < 2; k++) {
+    // the other transmitter first
+    tag= 1 - k;
+    for (p= 0; p < p_count; p++) {
+      if (TRANSMITTER_OF(transmitter, 2 * p + 1) != tag) continue;
+      // q: next pair of the transmitter
+      for (q= p + 1; (q < p_count) && (TRANSMITTER_OF(transmitter, 2 * q + 1) != tag); q++);
+      low= d[2 * p + 2];
+      if (q == p_count) low= CEIL;
+      else if (q > p + 1) {
+        // the pairs p + 1 .. q - 1 of the other transmitter, reliability: both edges of the extended LOW
+        sum= low & MSB;
+        for (r= p + 1; r < q; r++) sum+= (d[2 * r + 1] & MSB) + (d[2 * r + 2] & MSB);
+        low= (uint16_t)min((uint32_t)CEIL_U, sum) | ((low | d[2 * q]) & LSB);
+      }
+      e[ind++]= d[2 * p + 1];
+      e[ind++]= low;
+    }
+    e_length[k]= 2 * count[tag] - 2;
+  }
+  e_unreliable[0]= e_unreliable[1]= 0;
+  for (ind= 1; ind <= e_length[0]; ind++) e_unreliable[0]+= e[ind] & LSB;
+  for (ind= 1; ind <= e_length[1]; ind++) e_unreliable[1]+= e[e_length[0] + 2 + ind] & LSB;
+  return (true);
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
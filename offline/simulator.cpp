@@ -0,0 +1,673 @@
+// STL first: Arduino.h defines min / max as macros
+#include <vector>
+#include <algorithm>
+#include <Arduino.h>
+#include <SPI.h>
+#include <time.h>
+#include <unistd.h>
+#include "radio_lib.h"
+#include "categorizer.h"
+#include "RFM69_registers.h"
+#include "trace_reader.h"
+#include "simulator.h"
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ===================
+  = Radio Simulator =  the recorder on simulated radio modules (host build, not part of the sketch)
+  ===================
+
+  usage:
+    simulator [-s spikes] [-d drops] [-b bounces] [-x collisions] [-f fading] [-j jitter] [-l cycles] trace_file ...
+    simulator -e [-b bounces] [-l cycles]
+
+    -s  spikes    : per LOW, probability [%] of a HIGH spike of 2 .. SIM_SPIKE cycles
+    -d  drops     : per HIGH, probability [%] of a LOW drop of 2 .. SIM_DROP cycles
+    -b  bounces   : toggles of 2 .. SIM_BOUNCE cycles after each edge
+    -x  collisions: per trace, probability [%] of a second, stronger transmitter with another timing (SIM_COLLISION signals)
+    -f  fading    : decrease of the HIGH strength from the first to the last signal [strength]
+    -j  jitter    : maximal deviation of each duration [cycles]
+    -l  cycles of one signal_strength call (default SIM_STRENGTH_CYCLES, calibrated by strength_calibrate)
+    -e  edge rate stress: pulse trains of decreasing width, the highest edge rate the recorder records in full
+
+  The traces of the files are the transmissions: a duration value v of a trace (rs.duration: measured cycles / 2)
+  lasts 2 v poll cycles; the reliability flags are ignored, the simulated strengths decide.
+  The recorder (recorder.cpp) and the poll kernels (radio_lib.cpp: 0.2) run unchanged on the simulated radio
+  modules (radio_lib.cpp: HOST_SIMULATION): every DIO2 read advances the simulated time by one poll cycle (~ 0.5 us),
+  a signal_strength call by its cycles; RM_2 receives nothing. The lost cycles of the kernels (LC2, LC_EDGE)
+  have no counterpart in the simulation: they show up as the bias of the recorded durations.
+  The demodulator follows the OOK threshold written by the recorder (REG_OOKFIX): a HIGH is seen if 2 x strength > REG_OOKFIX.
+
+  S.1 main
+  S.2 Timeline
+  S.2.1 transmission: HIGH intervals of a trace with jitter, drops, spikes, bounces and fading
+  S.2.2 collision: HIGH intervals of a second transmitter
+  S.2.3 timeline_builder: merge of the HIGH intervals into level segments
+  S.2.4 resolve: the transmitted durations as the recorder resolves them (drops and spikes merged)
+  S.3 Simulated Radio Modules
+  S.3.1 sim_high / sim_strength (cf. simulator.h)
+  S.3.2 RFM69 registers: RFM69init, RFM69setMode, RFM69readReg, RFM69writeReg
+  S.3.3 pins and time (cf. Arduino.h: HOST_SIMULATION)
+  S.4 replay_trace: one reception of the recorder, compared with the transmitted durations
+  S.5 edge_stress: pulse trains of decreasing width
+  S.6 summary: recorder return codes, accuracy and replay throughput
+  S.7 now_ns: monotonic clock
+
+*/
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#define DIM_V        (NV + 5)                 // dim signal_duration (cf. receiver.ino)
+#define NRRC         (RRC_17 + 1)             // dim rrc_count
+#define SIM_LEAD     (2 * LONG_PAUSE)         // pause before the transmission [cycles] (the long pause is detected
+                                              // in steps of CEIL_UI: after 3 x 65000 cycles, cf. poll_loop_while_low)
+#define SIM_IDLE     (2 * LONG_PAUSE)         // rp.idle_limit: idle timeout (RRC_16) if the start trigger is missed
+#define SIM_STRENGTH_CYCLES  100              // cycles of one signal_strength call (cf. radio_lib.cpp: strength_lost)
+#define SIM_WRITE_CYCLES      25              // cycles of one register write (SPI, cf. radio_lib.cpp: threshold_lost)
+#define SIM_SENSITIVITY      18               // rp.radio_sensitivity
+#define SIM_STRENGTH_HIGH    22               // strength of the transmitter (start trigger: 18 .. 27)
+#define SIM_STRENGTH_LOW      8               // noise floor
+#define SIM_SPIKE            16               // longest spike [cycles] (< TRIGGER_HIGH: part of the LOW)
+#define SIM_DROP              8               // longest drop  [cycles] (<= DROP_LOW: part of the HIGH)
+#define SIM_BOUNCE            6               // longest bounce toggle [cycles]
+#define SIM_COLLISION        24               // signals of a collision
+#define SIM_COLLISION_DB     10               // strength of the second transmitter above the first one
+#define SIM_STRESS_COUNT    200               // stress: signals per pulse train
+#define SIM_TRIGGER_LOW      16               // drop : LOW  + SIM_LC2 <= TRIGGER_LOW  (cf. radio_lib.cpp)
+#define SIM_TRIGGER_HIGH     48               // spike: HIGH + SIM_LC2 <= TRIGGER_HIGH
+#define SIM_LC2               2               // the poll loops start counting at LC2
+#define SIM_CEIL_HIGH     65000UL             // shortest HIGH that overflows [cycles] (cf. radio_lib.cpp: CEIL_UI)
+#define SIM_MAX_ERROR        64               // stress: maximal error of a duration recorded in full [cycles]
+                                              // (LC_EDGE and LC_THRESHOLD included, cf. radio_lib.h)
+
+typedef struct {
+  uint32_t start;           // first cycle of the HIGH
+  uint32_t end;             // first cycle after the HIGH
+  uint8_t  strength;
+} sim_interval;
+
+typedef struct {
+  uint32_t start;           // first cycle of the segment (the segment lasts until the next one)
+  uint8_t  level;           // HIGH / LOW
+  uint8_t  strength;
+} sim_segment;
+
+typedef struct {
+  uint8_t  spikes;          // [%] per LOW
+  uint8_t  drops;           // [%] per HIGH
+  uint8_t  bounces;         // toggles per edge
+  uint8_t  collisions;      // [%] per trace
+  uint8_t  fading;          // strength decrease over the trace
+  uint16_t jitter;          // [cycles]
+} sim_options;
+
+uint8_t replay_trace (uint16_t v[], trace_record &t, const sim_options &o, bool &full, uint32_t &max_error);
+void    transmission (uint16_t v[], uint16_t n, const sim_options &o, std::vector<sim_interval> &highs, std::vector<uint32_t> &truth);
+void    collision (const std::vector<uint32_t> &truth, std::vector<sim_interval> &highs);
+void    timeline_builder (std::vector<sim_interval> &highs, std::vector<sim_segment> &timeline);
+void    resolve (std::vector<uint32_t> &truth);
+void    edge_stress (const sim_options &o);
+void    summary (uint32_t trace_count, uint32_t error_count, const sim_options &o);
+int64_t now_ns ();
+
+// host serial output and SPI bus (cf. Arduino.h, SPI.h)
+HostSerial Serial;
+HostSPI    SPI;
+
+// RFM69 library (cf. receiver.ino)
+volatile byte _mode;
+byte _powerLevel;
+bool _isRFM69HW;
+byte _slaveSelectPin;
+
+// simulated radio modules
+uint8_t  sim_reg[2][0x80];              // registers of RM_1 and RM_2
+std::vector<sim_segment> timeline;      // RM_1: level segments of the current transmission
+uint32_t seg_ind;                       // segment at sim_clock
+uint32_t sim_clock;                     // simulated time [poll cycles]
+uint16_t strength_cycles;               // cycles of one signal_strength call
+extern unsigned int strength_lost;      // cf. radio_lib.cpp: strength_calibrate
+volatile uint8_t DDRB, PORTB, DDRD, PORTD;
+
+// recorder return codes and accuracy
+uint32_t rrc_count[NRRC];
+uint32_t full_count;                    // traces recorded in full (all signals that can be recorded, cf. replay_trace)
+uint32_t mismatch_count;                // expected return code, but another number of signals
+uint32_t overflow_count;                // traces with a HIGH overflow (expected rc RRC_3)
+uint32_t collision_count;               // traces with a second transmitter
+uint32_t collision_detected;            // of which aborted with RRC_14
+uint32_t collision_full;                // of which recorded in full (undetected)
+uint32_t value_count[2];                // compared durations: [1]: HIGH, [0]: LOW
+int64_t  error_sum[2];                  // sum of the errors (recorded - transmitted) [cycles]
+int64_t  error_abs[2];                  // sum of the absolute errors [cycles]
+uint32_t error_max[2];                  // maximal absolute error [cycles]
+uint32_t unreliable_sum;                // unreliable signals of the traces recorded in full
+// replay throughput
+uint64_t edge_count;                    // replayed level changes
+uint64_t cycle_count;                   // simulated cycles
+int64_t  host_total;                    // host time of the recorder calls [ns]
+
+// pseudo random numbers (portable linear congruential generator, cf. benchmark.cpp)
+uint32_t lcg_state= 1;
+uint16_t lcg (uint16_t n) {lcg_state= lcg_state * 1103515245UL + 12345UL; return (uint16_t)((lcg_state >> 16) % n);}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+int main (int argc, char *argv[])
+{
+  // ******** //
+  // S.1 main //
+  // ******** //
+  static uint16_t v[DIM_V];   // signal_duration of a trace (the transmission)
+  trace_record t;
+  sim_options o;
+  bool     stress;            // edge rate stress (no trace files)
+  bool     full;
+  uint32_t max_error;
+  uint32_t trace_count;       // number of replayed traces
+  uint32_t error_count;       // number of skipped traces (reader errors)
+  FILE     *in;
+  uint8_t  rc;
+  int      opt;
+  int      arg_ind;
+
+  memset(&o, 0, sizeof(o));
+  strength_cycles= SIM_STRENGTH_CYCLES;
+  stress= false;
+  while ((opt= getopt(argc, argv, "s:d:b:x:f:j:l:e")) != -1) {
+    switch (opt) {
+      case 's': o.spikes=     min(100, atoi(optarg)); break;
+      case 'd': o.drops=      min(100, atoi(optarg)); break;
+      case 'b': o.bounces=    min(16, atoi(optarg)); break;
+      case 'x': o.collisions= min(100, atoi(optarg)); break;
+      case 'f': o.fading=     min(SIM_STRENGTH_HIGH, atoi(optarg)); break;
+      case 'j': o.jitter=     atoi(optarg); break;
+      case 'l': strength_cycles= atoi(optarg); break;
+      case 'e': stress= true; break;
+      default:
+        fprintf(stderr, "usage: %s [-s spikes] [-d drops] [-b bounces] [-x collisions] [-f fading] [-j jitter] [-l cycles] trace_file ...\n", argv[0]);
+        fprintf(stderr, "       %s -e [-b bounces] [-l cycles]\n", argv[0]);
+        return (2);
+    }
+  }
+  if (!stress && (optind >= argc)) {
+    fprintf(stderr, "%s: no trace file\n", argv[0]);
+    return (2);
+  }
+
+  // radio modules: the configuration of the receiver, then the lost cycles of signal_strength
+  // -------------
+  init_radio();
+  printf("signal_strength: %u cycles, calibrated strength_lost: %u cycles\n", strength_cycles, strength_lost);
+  printf("register write: %u cycles, calibrated threshold_lost: %u cycles\n\n", SIM_WRITE_CYCLES, threshold_lost);
+
+  if (stress) {
+    edge_stress(o);
+    return (0);
+  }
+
+  // replay all traces
+  // -----------------
+  trace_count= 0;
+  error_count= 0;
+  for (arg_ind= optind; arg_ind < argc; arg_ind++) {
+    if ((in= fopen(argv[arg_ind], "r")) == NULL) {perror(argv[arg_ind]); return (2);}
+    while ((rc= text_trace_reader(in, v, DIM_V, t)) != TRC_1) {
+      if ((rc == TRC_0) && (t.count > NV)) rc= TRC_4;
+      if (rc != TRC_0) {
+        fprintf(stderr, "%s: trace %u skipped (trace reader return code %u)\n", argv[arg_ind], trace_count + error_count + 1, rc);
+        error_count++;
+        continue;
+      }
+      rrc_count[replay_trace(v, t, o, full, max_error)]++;
+      trace_count++;
+    }
+    fclose(in);
+  }
+  summary(trace_count, error_count, o);
+  return (0);
+
+} // end main
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ************ //
+// S.2 Timeline //
+// ************ //
+
+void transmission (
+  uint16_t v[],                       // I  signal sequence: v[1 .. n], [odd indices]: HIGH, [even indices]: LOW
+  uint16_t n,                         // I  number of transmitted signals (the last one is a HIGH)
+  const sim_options &o,               // I  impairments
+  std::vector<sim_interval> &highs,   // O  HIGH intervals
+  std::vector<uint32_t> &truth        // O  transmitted durations [cycles]: truth[1 .. n]
+) {
+  // -------------------- //
+  // S.2.1 transmission   //  HIGH intervals of a trace with jitter, drops, spikes, bounces and fading
+  // -------------------- //
+  // the edges of the transmitted signals stay where they are: the bounces follow an edge, the drops
+  // and spikes lie in the middle half of a signal, i.e. none of them changes the transmitted durations
+  uint32_t t;           // start of the signal [cycles]
+  uint32_t d;           // duration of the signal [cycles]
+  uint32_t s;           // start of the remaining part of the signal
+  uint32_t p;
+  uint16_t ind;
+  uint8_t  strength;
+  uint8_t  k;
+
+  truth.assign(n + 1, 0);
+  t= SIM_LEAD;
+  for (ind= 1; ind <= n; ind++) {
+    d= 2 * (uint32_t)(v[ind] & MSB);
+    if (o.jitter > 0) d= max(2L, (long)d + lcg(2 * o.jitter + 1) - o.jitter);
+    truth[ind]= d;
+    // fading: linear decrease of the strength, +- 1 of noise
+    strength= SIM_STRENGTH_HIGH - (o.fading * (ind - 1)) / max(1, n - 1) + lcg(3) - 1;
+    s= t;
+    if (ind & 1) {
+      // HIGH: bounces are short drops after the rising edge
+      for (k= 0; k < o.bounces; k++) {
+        p= s + 2 + lcg(SIM_BOUNCE - 1);
+        if (p + SIM_BOUNCE >= t + d / 2) break;
+        highs.push_back({s, p, strength});
+        s= p + 2 + lcg(SIM_BOUNCE - 1);
+      }
+      if ((lcg(100) < o.drops) && (d > 4 * SIM_DROP)) {
+        p= t + d / 4 + lcg(d / 2);
+        highs.push_back({s, p, strength});
+        s= p + 2 + lcg(SIM_DROP - 1);
+      }
+      highs.push_back({s, t + d, strength});
+    } else {
+      // LOW: bounces are short spikes after the falling edge
+      for (k= 0; k < o.bounces; k++) {
+        s+= 2 + lcg(SIM_BOUNCE - 1);
+        p= s + 2 + lcg(SIM_BOUNCE - 1);
+        if (p >= t + d / 2) break;
+        highs.push_back({s, p, SIM_STRENGTH_HIGH});
+        s= p;
+      }
+      if ((lcg(100) < o.spikes) && (d > 4 * SIM_SPIKE)) {
+        p= t + d / 4 + lcg(d / 2);
+        highs.push_back({p, p + 2 + lcg(SIM_SPIKE - 1), SIM_STRENGTH_HIGH});
+      }
+    }
+    t+= d;
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void collision (
+  const std::vector<uint32_t> &truth, // I  transmitted durations of the first transmitter
+  std::vector<sim_interval> &highs    // IO HIGH intervals (the second transmitter is added)
+) {
+  // ----------------- //
+  // S.2.2 collision   //  HIGH intervals of a second transmitter
+  // ----------------- //
+  // after the warm-up, SIM_COLLISION signals of 3/4 of the durations of the first transmitter,
+  // shifted by half a signal and SIM_COLLISION_DB stronger
+  uint32_t t;
+  uint16_t n= truth.size() - 1;
+  uint16_t first;
+  uint16_t ind;
+
+  if (n < WARM_UP + SIM_COLLISION + 2) return;
+  first= WARM_UP + 1 + lcg(n - WARM_UP - SIM_COLLISION);
+  for (t= SIM_LEAD, ind= 1; ind < first; ind++) t+= truth[ind];
+  t+= truth[first] / 2;
+  for (ind= first; ind < first + SIM_COLLISION; ind++) {
+    if (ind & 1) highs.push_back({t, t + 3 * truth[ind] / 4, SIM_STRENGTH_HIGH + SIM_COLLISION_DB});
+    t+= 3 * truth[ind] / 4;
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void timeline_builder (
+  std::vector<sim_interval> &highs,   // I  HIGH intervals (sorted here)
+  std::vector<sim_segment> &timeline  // O  level segments, starting with the lead pause
+) {
+  // ------------------------ //
+  // S.2.3 timeline_builder   //  merge of the HIGH intervals into level segments
+  // ------------------------ //
+  // overlapping intervals (collision) are one HIGH of the strongest transmitter
+  std::vector<std::pair<uint32_t, int> > events;   // (time, +strength: start / -strength - 1: end)
+  uint16_t active[256];       // number of active intervals per strength
+  uint16_t active_count;
+  uint8_t  level;
+  uint8_t  strength;
+  int      s;
+  size_t   ind;
+
+  for (ind= 0; ind < highs.size(); ind++) {
+    if (highs[ind].end <= highs[ind].start) continue;
+    events.push_back(std::make_pair(highs[ind].start, (int)highs[ind].strength));
+    events.push_back(std::make_pair(highs[ind].end, -(int)highs[ind].strength - 1));
+  }
+  // at the same time, an end precedes a start
+  std::sort(events.begin(), events.end());
+
+  memset(active, 0, sizeof(active));
+  active_count= 0;
+  timeline.clear();
+  timeline.push_back({0, LOW, SIM_STRENGTH_LOW});
+  for (ind= 0; ind < events.size(); ind++) {
+    if (events[ind].second >= 0) {active[events[ind].second]++; active_count++;}
+    else {active[-events[ind].second - 1]--; active_count--;}
+    if ((ind + 1 < events.size()) && (events[ind + 1].first == events[ind].first)) continue;
+    // the level after all events of this time
+    if (active_count > 0) {
+      level= HIGH;
+      for (s= 255; active[s] == 0; s--);
+      strength= s;
+    } else {
+      level= LOW;
+      strength= SIM_STRENGTH_LOW + lcg(3) - 1;
+    }
+    if ((level == timeline.back().level) && ((level == LOW) || (strength == timeline.back().strength))) continue;
+    if (timeline.back().start == events[ind].first) timeline.back()= {events[ind].first, level, strength};
+    else timeline.push_back({events[ind].first, level, strength});
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void resolve (
+  std::vector<uint32_t> &truth        // IO transmitted durations: truth[1 .. n] -> expected durations
+) {
+  // ------------- //
+  // S.2.4 resolve //  the transmitted durations as the recorder resolves them
+  // ------------- //
+  // a trace may contain durations below the triggers of the poll kernels (the synthetic corpus does):
+  // such a LOW is a drop, such a HIGH a spike, both are merged with the two signals around them
+  // (the last HIGH is never merged, a first HIGH spike is part of the lead pause)
+  size_t ind;
+
+  while ((truth.size() > 3) && (truth[1] + SIM_LC2 <= SIM_TRIGGER_HIGH)) truth.erase(truth.begin() + 1, truth.begin() + 3);
+  for (ind= 2; ind + 1 < truth.size(); ) {
+    if (truth[ind] + SIM_LC2 <= ((ind & 1) ? SIM_TRIGGER_HIGH : SIM_TRIGGER_LOW)) {
+      truth[ind - 1]+= truth[ind] + truth[ind + 1];
+      truth.erase(truth.begin() + ind, truth.begin() + ind + 2);
+      // the merged signal may be followed by another short one
+      if (ind > 2) ind--;
+    } else ind++;
+  }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// *************************** //
+// S.3 Simulated Radio Modules //
+// *************************** //
+
+inline const sim_segment &sim_segment_now ()
+{
+  // segment of RM_1 at sim_clock (the time only advances)
+  while ((seg_ind + 1 < timeline.size()) && (timeline[seg_ind + 1].start <= sim_clock)) seg_ind++;
+  return (timeline[seg_ind]);
+}
+
+bool sim_high (uint8_t radio_module)
+{
+  // ---------------------------------- //
+  // S.3.1 sim_high / sim_strength      //  (cf. simulator.h)
+  // ---------------------------------- //
+  // the demodulator: RX mode and a strength above the OOK threshold (REG_OOKFIX)
+  sim_clock++;
+  if (radio_module != RM_1) return (false);
+  const sim_segment &s= sim_segment_now();
+  if ((sim_reg[0][REG_OPMODE] & 0x1C) != RF_OPMODE_RECEIVER) return (false);
+  return ((s.level == HIGH) && (2 * s.strength > sim_reg[0][REG_OOKFIX]));
+}
+
+uint8_t sim_strength (uint8_t radio_module)
+{
+  // the strength at the begin of the measurement
+  uint8_t strength= SIM_STRENGTH_LOW;
+  if ((radio_module == RM_1) && !timeline.empty()) strength= sim_segment_now().strength;
+  sim_clock+= strength_cycles;
+  return (strength);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+// --------------------- //
+// S.3.2 RFM69 registers //  the register file of the radio module selected by _slaveSelectPin
+// --------------------- //
+byte *sim_registers () {return (sim_reg[(_slaveSelectPin == SS2) ? 1 : 0]);}
+
+void RFM69writeReg (byte addr, byte value) {sim_registers()[addr & 0x7F]= value; sim_clock+= SIM_WRITE_CYCLES;}
+byte RFM69readReg  (byte addr)             {return (sim_registers()[addr & 0x7F]);}
+void RFM69rcCalibration () {}
+
+void RFM69init (byte rmx_config[][2])
+{
+  for (byte ind= 0; rmx_config[ind][0] != 255; ind++) RFM69writeReg(rmx_config[ind][0], rmx_config[ind][1]);
+}
+
+void RFM69setMode (byte newMode)
+{
+  byte op= RFM69readReg(REG_OPMODE) & 0xE3;
+  switch (newMode) {
+    case RF69_MODE_TX:      op|= RF_OPMODE_TRANSMITTER; break;
+    case RF69_MODE_RX:      op|= RF_OPMODE_RECEIVER; break;
+    case RF69_MODE_SYNTH:   op|= RF_OPMODE_SYNTHESIZER; break;
+    case RF69_MODE_STANDBY: op|= RF_OPMODE_STANDBY; break;
+    case RF69_MODE_SLEEP:   op|= RF_OPMODE_SLEEP; break;
+    case RF69_MODE_LISTEN:  op|= RF_OPMODE_LISTEN_ON | (RFM69readReg(REG_OPMODE) & 0x1C); break;
+    default: return;
+  }
+  RFM69writeReg(REG_OPMODE, op);
+  _mode= newMode;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+// ------------------------- //
+// S.3.3 pins and time       //  1 poll cycle ~ 0.5 us (cf. radio_lib.cpp: capture backend)
+// ------------------------- //
+void pinMode (uint8_t pin, uint8_t mode) {}
+void digitalWrite (uint8_t pin, uint8_t value) {}
+void delay (unsigned long ms) {sim_clock+= 2000 * ms;}
+void delayMicroseconds (unsigned int us) {sim_clock+= 2 * us;}
+unsigned long micros () {return (sim_clock >> 1);}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint8_t replay_trace (        // recorder return code
+  uint16_t v[],               // I  transmitted signal sequence: v[1 .. count + 2] ("ending" included)
+  trace_record &t,            // I  trace header
+  const sim_options &o,       // I  impairments
+  bool     &full,             // O  all signals recorded that can be recorded (rc RRC_0, or RRC_3 at a HIGH overflow)
+  uint32_t &max_error         // O  full: maximal absolute error of a recorded duration [cycles]
+) {
+  // **************** //
+  // S.4 replay_trace //  one reception of the recorder, compared with the transmitted durations
+  // **************** //
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+  static uint8_t  duration_code[DIM_V];
+  static uint8_t  duration_flag[(DIM_V + 7) / 8];
+  duration_seq    duration= {duration_code, duration_flag};
+#else
+  static uint16_t duration[DIM_V];
+#endif
+  static byte     strength[WARM_UP + 1];
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  static uint8_t  transmitter[TRANSMITTER_DIM(NV)];
+#endif
+  std::vector<sim_interval> highs;
+  std::vector<uint32_t> truth;
+  receiver_parameters rp;
+  recorded_signals rs;
+  uint16_t n;                 // number of transmitted signals (the last one is a HIGH), then of the resolved ones
+  uint16_t m;                 // number of signals to be recorded
+  uint16_t ind;
+  uint8_t  expected_rc;
+  long     error;
+  bool     collided;
+  int64_t  start;
+  uint8_t  rc;
+
+  // the transmission ends with the last HIGH: the "ending" (x, CEIL) or the last HIGH before the (0, 0) ending
+  n= (v[t.count + 1] > 0) ? t.count + 1 : t.count - 1;
+  transmission(v, n, o, highs, truth);
+  collided= (o.collisions > 0) && (lcg(100) < o.collisions);
+  if (collided) collision(truth, highs);
+  timeline_builder(highs, timeline);
+  resolve(truth);
+  n= truth.size() - 1;
+
+  // receive
+  // -------
+  rp.radio_module=      RM_1;
+  rp.radio_frequency=   (long)(433.920 * (1 << 14));
+  rp.radio_frequency_2= 0;
+  rp.radio_sensitivity= SIM_SENSITIVITY;
+  rp.max_length=        NV;
+  rp.idle_limit=        SIM_IDLE;
+  rp.stream=            NULL;
+  rp.edge_buffer=       NULL;
+  rs.duration= duration;
+  rs.strength= strength;
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  rs.transmitter= transmitter;
+#endif
+  sim_clock= 0;
+  seg_ind=   0;
+  start= now_ns();
+  rc= recorder(rp, rs);
+  host_total+= now_ns() - start;
+  edge_count+= seg_ind;
+  cycle_count+= sim_clock;
+
+  // compare
+  // -------
+  // a HIGH of CEIL_UI cycles or more cannot be recorded (the corpus may contain such anomalies):
+  // the recorder is expected to stop there with RRC_3, rs.count is the last LOW in front of it (0 up to the first LOW after WARM_UP)
+  // otherwise RRC_0: rs.count is the last LOW, rs.duration[rs.count + 1] the last HIGH
+  // (LOG8_DURATIONS: the errors include the rounding of the 8-bit codes, cf. durations.h)
+  expected_rc= RRC_0;
+  m= n;
+  for (ind= 1; ind <= n; ind+= 2) {
+    if (truth[ind] >= SIM_CEIL_HIGH) {expected_rc= RRC_3; m= (ind > WARM_UP + 1) ? ind - 1 : 0; break;}
+  }
+  if (expected_rc == RRC_3) overflow_count++;
+  full= (rc == expected_rc) && (rs.count + ((rc == RRC_0) ? 1 : 0) == m);
+  max_error= 0;
+  if (collided) {
+    collision_count++;
+    if (rc == RRC_14) collision_detected++;
+    if (full) collision_full++;
+  }
+  if (full) {
+    full_count++;
+    unreliable_sum+= rs.unreliable_count;
+    for (ind= 1; ind <= m; ind++) {
+      error= 2 * (long)(rs.duration[ind] & MSB) - (long)truth[ind];
+      value_count[ind & 1]++;
+      error_sum[ind & 1]+= error;
+      error_abs[ind & 1]+= abs(error);
+      if ((uint32_t)abs(error) > max_error) max_error= abs(error);
+      if ((uint32_t)abs(error) > error_max[ind & 1]) error_max[ind & 1]= abs(error);
+    }
+  } else
+  if (rc == expected_rc) mismatch_count++;
+  return (rc);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void edge_stress (const sim_options &o)
+{
+  // *************** //
+  // S.5 edge_stress //  pulse trains of decreasing width
+  // *************** //
+  // equal HIGH and LOW durations: the highest edge rate recorded in full with errors <= SIM_MAX_ERROR
+  // (the debouncing limits the width to > TRIGGER_HIGH, the strength measurement at each edge costs strength_lost)
+  static const uint16_t width[]= {800, 600, 400, 300, 240, 200, 160, 140, 120, 100, 80, 64, 56, 48, 40, 32};
+  static uint16_t v[DIM_V];
+  trace_record t;
+  uint32_t best;              // narrowest width recorded in full [cycles]
+  uint32_t max_error;
+  bool     full;
+  uint16_t ind;
+  uint8_t  w_ind;
+  uint8_t  rc;
+
+  printf("%10s %12s %8s %8s %12s\n", "width [cy]", "edges/s", "rc", "full", "max |e|");
+  best= 0;
+  for (w_ind= 0; w_ind < sizeof(width) / sizeof(width[0]); w_ind++) {
+    for (ind= 1; ind <= SIM_STRESS_COUNT + 1; ind++) v[ind]= width[w_ind] / 2;
+    v[SIM_STRESS_COUNT + 2]= CEIL;
+    t.count= SIM_STRESS_COUNT;
+    rc= replay_trace(v, t, o, full, max_error);
+    full= full && (max_error <= SIM_MAX_ERROR);
+    if (full) best= width[w_ind];
+    // 1 poll cycle ~ 0.5 us
+    printf("%10u %12.0f   RRC_%-2u %8s %12u\n", width[w_ind], 2e6 / width[w_ind], (rc > RRC_14) ? rc - 1 : rc, full ? "yes" : "no", max_error);
+  }
+  if (best > 0) printf("\nhighest edge rate recorded in full: %.0f edges/s (width %u cycles)\n", 2e6 / best, best);
+  else printf("\nno pulse train recorded in full\n");
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void summary (uint32_t trace_count, uint32_t error_count, const sim_options &o)
+{
+  // *********** //
+  // S.6 summary //  recorder return codes, accuracy and replay throughput
+  // *********** //
+  const char *level_name[2]= {"LOW", "HIGH"};
+  uint8_t rc;
+  uint8_t level;
+
+  printf("traces: %u replayed, %u skipped\n", trace_count, error_count);
+  printf("impairments: spikes %u %%, drops %u %%, bounces %u, collisions %u %%, fading %u, jitter %u cycles\n",
+         o.spikes, o.drops, o.bounces, o.collisions, o.fading, o.jitter);
+  printf("\nrecorder return codes\n");
+  for (rc= 0; rc < NRRC; rc++) {
+    if (rrc_count[rc] == 0) continue;
+    printf("RRC_%-2u %8u %7.2f %%\n", (rc > RRC_14) ? rc - 1 : rc, rrc_count[rc], trace_count ? 100.0 * rrc_count[rc] / trace_count : 0.0);
+  }
+  printf("\nrecorded in full: %u, other number of signals: %u (traces with a HIGH overflow, expected RRC_3: %u)\n",
+         full_count, mismatch_count, overflow_count);
+  if (collision_count > 0)
+    printf("collisions: %u, detected (RRC_14): %u, recorded in full (undetected): %u\n", collision_count, collision_detected, collision_full);
+  // the errors of the traces recorded in full (the kernels add LC2 / LC_EDGE, rs.duration keeps even values)
+  printf("\n%-6s %10s %12s %12s %12s\n", "level", "values", "bias [cy]", "mean |e|", "max |e|");
+  for (level= 2; level-- > 0;) {
+    printf("%-6s %10u %12.2f %12.2f %12u\n", level_name[level], value_count[level],
+           value_count[level] ? (double)error_sum[level] / value_count[level] : 0.0,
+           value_count[level] ? (double)error_abs[level] / value_count[level] : 0.0, error_max[level]);
+  }
+  printf("unreliable signals (recorded in full): %u\n", unreliable_sum);
+  // the host time is dominated by the pauses (one sim_high call per poll cycle)
+  printf("\nreplay: %llu edges, %.3f s simulated, %.3f ms host (%.3f M edges/s, %.1f M polls/s)\n",
+         (unsigned long long)edge_count, cycle_count / 2e6, host_total / 1e6,
+         host_total ? 1e3 * edge_count / host_total : 0.0, host_total ? 1e3 * cycle_count / host_total : 0.0);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+int64_t now_ns ()
+{
+  // ********** //
+  // S.7 now_ns //  monotonic clock [ns]
+  // ********** //
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
@@ -0,0 +1,27 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ===============================
+  = Radio Simulator (Interface) =  DIO2 and RSSI of the simulated radio modules (cf. radio_lib.cpp: HOST_SIMULATION)
+  ===============================
+*/
+
+#include <stdint.h>
+
+// DIO2 level of the radio module: advances the simulated time by one poll cycle
+bool    sim_high (uint8_t radio_module);
+// signal strength of the radio module: advances the simulated time by the cycles of one signal_strength call
+uint8_t sim_strength (uint8_t radio_module);
@@ -0,0 +1,619 @@
+#include <string.h>
+#include <stdlib.h>
+#include "trace_reader.h"
+#include "categorizer.h"
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ================
+  = Trace Reader =  off-line processing of the receiver output (host build, not part of the sketch)
+  ================
+
+  T.1 binary_trace_reader: decode the next binary trace frame (output_option 2)
+  T.2 compressed_trace_reader: decode the next compressed trace (output_option 3, cf. codec.cpp)
+  T.3 text_trace_reader: parse the next text trace (output_option 1)
+  T.4 packed_sequence_reader: decode the next packed categorized sequence (CATEGORIZER_OUTPUT == PACKED_OUTPUT,
+      cf. codec.cpp) and print it as the sequence_printer does
+  T.5 sequence_reader: next text trace from the standard input (cf. categorizer.h)
+  T.6 Helper
+  T.6.1 read_uint16: little endian
+  T.6.2 trace_checksum: Fletcher16
+  T.6.3 read_varint: 7 bits per byte
+  T.6.4 read_bits: bit-packed, most significant bit first
+  T.6.5 read_line: next text line
+  T.6.6 parse_numbers: integers of a text line
+
+*/
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool read_uint16 (FILE *in, uint16_t &val, uint16_t &len);
+bool read_varint (FILE *in, uint32_t &val);
+bool read_bits (FILE *in, uint8_t n, uint32_t &val);
+bool read_line (FILE *in, char line[]);
+uint8_t parse_numbers (const char line[], long val[], uint8_t val_dim);
+
+// bit-packed input (compressed trace)
+int     bit_acc;      // current byte
+uint8_t bit_count;    // number of unread bits in bit_acc
+
+uint8_t binary_trace_reader (  // return code (TRC_0: trace read)
+  FILE     *in,                // I  receiver output (the text between the frames is skipped)
+  uint16_t signal_duration[],  // O  signal sequence: [odd indices]: HIGH-durations, [even indices]: LOW-durations
+  uint16_t duration_dim,       // I  dimension of signal_duration (>= NV + 5)
+  trace_record &t              // O  header and checksum of the frame
+) {
+  // ************************* //
+  // T.1 binary_trace_reader   //  decode the next binary trace frame
+  // ************************* //
+  // frame (cf. receiver.ino: binary_reporting):
+  // '!' 'B' | length | count | unreliable_count | ref_strength_high | ref_strength_low | k | strength[1..k] | duration[1..count+2] | checksum
+
+  int      c;           // current character
+  int      prev_c;      // previous character
+  uint16_t frame_len;   // remaining number of bytes in the frame (checksum excluded)
+  uint16_t n;           // number of durations ("ending" included)
+  uint16_t ind;
+
+  // find the start marker
+  // ---------------------
+  prev_c= EOF;
+  while ((c= fgetc(in)) != EOF) {
+    if ((prev_c == BINARY_MARKER_1) && (c == BINARY_MARKER_2)) break;
+    prev_c= c;
+  }
+  if (c == EOF) return (TRC_1);
+
+  // frame length
+  ind= 2;
+  if (!read_uint16(in, frame_len, ind)) return (TRC_2);
+
+  // header
+  // ------
+  if (!read_uint16(in, t.count, frame_len)) return (TRC_2);
+  if (!read_uint16(in, t.unreliable_count, frame_len)) return (TRC_2);
+  if ((c= fgetc(in)) == EOF) return (TRC_2);
+  t.ref_strength_high= c;
+  if ((c= fgetc(in)) == EOF) return (TRC_2);
+  t.ref_strength_low= c;
+  if ((c= fgetc(in)) == EOF) return (TRC_2);
+  t.strength_count= c;
+  if (frame_len < 3 + t.strength_count) return (TRC_3);
+  frame_len-= 3;
+  if (t.strength_count >= TRACE_STRENGTHS) return (TRC_3);
+  for (ind= 1; ind <= t.strength_count; ind++) {
+    if ((c= fgetc(in)) == EOF) return (TRC_2);
+    t.strength[ind]= c;
+    frame_len--;
+  }
+
+  // durations
+  // ---------
+  n= t.count + 2;
+  if (frame_len != 2 * n) return (TRC_3);
+  if (n >= duration_dim) return (TRC_4);
+  // position 0 is not used
+  signal_duration[0]= 0;
+  for (ind= 1; ind <= n; ind++) {
+    if (!read_uint16(in, signal_duration[ind], frame_len)) return (TRC_2);
+  }
+
+  // checksum
+  // --------
+  frame_len= 2;
+  if (!read_uint16(in, t.checksum, frame_len)) return (TRC_2);
+  if (t.checksum != trace_checksum(signal_duration, n)) return (TRC_5);
+  return (TRC_0);
+
+} // end binary_trace_reader
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+uint8_t compressed_trace_reader (  // return code (TRC_0: trace read)
+  FILE     *in,                    // I  receiver output (the text between the frames is skipped)
+  uint16_t signal_duration[],      // O  signal sequence: [odd indices]: HIGH-durations, [even indices]: LOW-durations
+  uint16_t duration_dim,           // I  dimension of signal_duration (>= NV + 5)
+  trace_record &t                  // O  header and checksum of the frame
+) {
+  // *************************** //
+  // T.2 compressed_trace_reader //  decode the next compressed trace
+  // *************************** //
+  // stream (cf. codec.cpp: trace_encoder):
+  // '!' 'C' | mode | count | unreliable_count | [categories HIGH, LOW] | values[1..count+2] | checksum
+
+  int      c;               // current character
+  int      prev_c;          // previous character
+  uint8_t  mode;            // CODEC_RAW / CODEC_CATEGORY
+  uint8_t  cat_size[2];     // number of categories: [1]: HIGH, [0]: LOW (= escape index)
+  uint8_t  cat_bits[2];     // width of the category index
+  uint16_t cat_center[2][CODEC_CATEGORIES];
+  uint8_t  cat_ind;
+  uint8_t  z_ind;           // signal level index (1: HIGH, 0: LOW)
+  uint8_t  k;               // Rice parameter
+  uint8_t  flag;            // reliability bit
+  uint16_t prev_val[2];     // previous value of the same level (raw mode)
+  uint32_t val;             // varint / bit field
+  uint32_t q;               // Rice quotient
+  int32_t  delta;           // signed difference
+  uint16_t n;               // number of durations ("ending" included)
+  uint16_t len;
+  uint16_t ind;
+
+  // find the start marker
+  // ---------------------
+  prev_c= EOF;
+  while ((c= fgetc(in)) != EOF) {
+    if ((prev_c == CODEC_MARKER_1) && (c == CODEC_MARKER_2)) break;
+    prev_c= c;
+  }
+  if (c == EOF) return (TRC_1);
+
+  // header
+  // ------
+  if ((c= fgetc(in)) == EOF) return (TRC_2);
+  mode= c;
+  if ((mode != CODEC_RAW) && (mode != CODEC_CATEGORY)) return (TRC_6);
+  if (!read_varint(in, val)) return (TRC_2);
+  t.count= val;
+  if (!read_varint(in, val)) return (TRC_2);
+  t.unreliable_count= val;
+  // not transmitted
+  t.ref_strength_high= 0;
+  t.ref_strength_low=  0;
+  t.strength_count=    0;
+
+  n= t.count + 2;
+  if (n >= duration_dim) return (TRC_4);
+  // position 0 is not used
+  signal_duration[0]= 0;
+
+  if (mode == CODEC_RAW) {
+    // zigzag deltas
+    // -------------
+    prev_val[0]= 0;
+    prev_val[1]= 0;
+    for (ind= 1; ind <= n; ind++) {
+      z_ind= ind & 1;
+      if (!read_varint(in, val)) return (TRC_2);
+      delta= (val & 1) ? -(int32_t)((val + 1) >> 1) : (int32_t)(val >> 1);
+      signal_duration[ind]= prev_val[z_ind] + delta;
+      prev_val[z_ind]= signal_duration[ind];
+    }
+    goto CHECKSUM;
+  }
+
+  // categories
+  // ----------
+  for (z_ind= 1; ; z_ind= 0) {
+    if ((c= fgetc(in)) == EOF) return (TRC_2);
+    cat_size[z_ind]= c;
+    if (cat_size[z_ind] > CODEC_CATEGORIES) return (TRC_6);
+    for (cat_bits[z_ind]= 0; (1 << cat_bits[z_ind]) <= cat_size[z_ind]; cat_bits[z_ind]++);
+    for (cat_ind= 0; cat_ind < cat_size[z_ind]; cat_ind++) {
+      if (!read_varint(in, val)) return (TRC_2);
+      cat_center[z_ind][cat_ind]= val << 1;
+    }
+    if (z_ind == 0) break;
+  }
+  if ((c= fgetc(in)) == EOF) return (TRC_2);
+  k= c;
+  if (k > 16) return (TRC_6);
+
+  // bit-packed values
+  // -----------------
+  bit_acc= 0;
+  bit_count= 0;
+  for (ind= 1; ind <= n; ind++) {
+    z_ind= ind & 1;
+    if (!read_bits(in, cat_bits[z_ind], val)) return (TRC_2);
+    cat_ind= val;
+    if (!read_bits(in, 1, val)) return (TRC_2);
+    flag= val;
+    if (cat_ind == cat_size[z_ind]) {
+      // escape
+      if (!read_bits(in, 15, val)) return (TRC_2);
+      signal_duration[ind]= (val << 1) | flag;
+      continue;
+    }
+    if (cat_ind > cat_size[z_ind]) return (TRC_6);
+    // Rice code
+    for (q= 0; ; q++) {
+      if (!read_bits(in, 1, val)) return (TRC_2);
+      if (val == 0) break;
+      if (q >= CODEC_RICE_LIMIT) return (TRC_6);
+    }
+    if (!read_bits(in, k, val)) return (TRC_2);
+    val|= q << k;
+    delta= (val & 1) ? -(int32_t)((val + 1) >> 1) : (int32_t)(val >> 1);
+    signal_duration[ind]= (cat_center[z_ind][cat_ind] + 2 * delta) | flag;
+  }
+
+CHECKSUM:
+  // checksum
+  // --------
+  len= 2;
+  if (!read_uint16(in, t.checksum, len)) return (TRC_2);
+  if (t.checksum != trace_checksum(signal_duration, n)) return (TRC_5);
+  return (TRC_0);
+
+} // end compressed_trace_reader
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+uint8_t text_trace_reader (  // return code (TRC_0: trace read)
+  FILE     *in,              // I  receiver output (the text between the traces is skipped)
+  uint16_t signal_duration[],// O  signal sequence: [odd indices]: HIGH-durations, [even indices]: LOW-durations
+  uint16_t duration_dim,     // I  dimension of signal_duration (>= NV + 5)
+  trace_record &t            // O  strengths and checkout record of the trace
+) {
+  // *********************** //
+  // T.3 text_trace_reader   //  parse the next text trace
+  // *********************** //
+  // text (cf. receiver.ino: reporting):
+  // signal-strength | ind  strength / strength | ...
+  // !TRACE!         | ind  HIGH  LOW | ... (ind = 1, 3, .., count + 1)
+  // checksum  unreliable_count | -1  -1 | blank | ref_strength: high low
+
+  char     line[TEXT_LINE_DIM];
+  long     val[4];        // numbers of the current line
+  uint8_t  val_count;     // number of numbers in the current line
+  bool     strengths;     // the current line belongs to the signal strengths
+  uint16_t n;             // number of durations ("ending" included)
+  int      c;
+
+  // find the start marker (the signal strengths come first)
+  // ---------------------
+  t.strength_count= 0;
+  strengths= false;
+  while (true) {
+    if (!read_line(in, line)) return (TRC_1);
+    if (strncmp(line, TEXT_MARKER, strlen(TEXT_MARKER)) == 0) break;
+    if (strncmp(line, TEXT_STRENGTHS, strlen(TEXT_STRENGTHS)) == 0) {
+      t.strength_count= 0;
+      strengths= true;
+      continue;
+    }
+    if (!strengths) continue;
+    // signal strengths obtained during warm-up: ind  HIGH / LOW
+    val_count= parse_numbers(line, val, 3);
+    if ((val_count < 2) || (val[0] != t.strength_count + 1) || (val[0] + val_count - 2 >= TRACE_STRENGTHS)) {
+      strengths= false;
+      continue;
+    }
+    t.strength[val[0]]= val[1];
+    if (val_count > 2) t.strength[val[0] + 1]= val[2];
+    t.strength_count= val[0] + val_count - 2;
+  }
+
+  // durations: ind  HIGH  LOW (until the checkout record)
+  // ---------
+  // position 0 is not used
+  signal_duration[0]= 0;
+  n= 0;
+  while (true) {
+    if (!read_line(in, line)) return (TRC_2);
+    val_count= parse_numbers(line, val, 3);
+    if (val_count == 0) continue;
+    if (val_count < 3) break;
+    if (val[0] != n + 1) return (TRC_3);
+    if (n + 2 >= duration_dim) return (TRC_4);
+    signal_duration[++n]= val[1];
+    signal_duration[++n]= val[2];
+  }
+  // the "ending" is (0, 0) or (x, CEIL): count is the index of the last LOW
+  if (n < 2) return (TRC_3);
+  t.count= n - 2;
+
+  // checkout record (checksum, unreliable_count) and end-of-data record (-1, -1)
+  // ---------------
+  if ((val_count != 2) || (val[0] < 0)) return (TRC_3);
+  t.checksum= val[0];
+  t.unreliable_count= val[1];
+  if (!read_line(in, line)) return (TRC_2);
+  if ((parse_numbers(line, val, 2) != 2) || (val[0] != -1)) return (TRC_3);
+
+  // reference strengths (optional, blank lines in between)
+  // -------------------
+  t.ref_strength_high= 0;
+  t.ref_strength_low= 0;
+  while ((c= fgetc(in)) == '\n' || c == '\r');
+  if (c != EOF) ungetc(c, in);
+  if (c == TEXT_REFERENCE[0]) {
+    read_line(in, line);
+    if (parse_numbers(line, val, 2) == 2) {
+      t.ref_strength_high= val[0];
+      t.ref_strength_low= val[1];
+    }
+  }
+
+  if (t.checksum != trace_checksum(signal_duration, n)) return (TRC_5);
+  return (TRC_0);
+
+} // end text_trace_reader
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+uint8_t packed_sequence_reader (  // return code (TRC_0: sequence read)
+  FILE     *in,                   // I  receiver output (the text between the packed sequences is skipped)
+  FILE     *out                   // O  printer view of the categorized sequence (cf. categorizer_lib.cpp: sequence_printer)
+) {
+  // ************************** //
+  // T.4 packed_sequence_reader //  decode the next packed categorized sequence
+  // ************************** //
+  // stream (cf. codec.cpp: sequence_encoder):
+  // '!' 'S' | v_length | [clusters, aggregations, centers HIGH, LOW] | symbols[1..v_length] | checksum
+
+  int      c;                          // current character
+  int      prev_c;                     // previous character
+  uint8_t  clu_size[2];                // number of clusters: [1]: HIGH, [0]: LOW
+  uint8_t  agg_size[2];                // number of aggregations
+  uint8_t  cat_size[2];                // number of categories (= first escape code)
+  uint8_t  cat_bits[2];                // width of a symbol
+  uint16_t cat_center[2][CODEC_CATEGORIES];
+  char     sym[PACKED_DIM];            // printer symbol of v[ind]
+  bool     bang[PACKED_DIM];           // v[ind] is unreliable
+  uint8_t  cat_ind;
+  uint8_t  z_ind;                      // signal level index (1: HIGH, 0: LOW)
+  uint16_t v_length;                   // number of printed values
+  uint32_t val;                        // varint / bit field
+  uint16_t sum1;                       // Fletcher16 of the symbols
+  uint16_t sum2;
+  uint16_t checksum;
+  uint16_t len;
+  uint16_t ind;
+  uint16_t j, k;
+
+  // find the start marker
+  // ---------------------
+  prev_c= EOF;
+  while ((c= fgetc(in)) != EOF) {
+    if ((prev_c == SEQUENCE_MARKER_1) && (c == SEQUENCE_MARKER_2)) break;
+    prev_c= c;
+  }
+  if (c == EOF) return (TRC_1);
+
+  // header
+  // ------
+  if (!read_varint(in, val)) return (TRC_2);
+  if (val >= PACKED_DIM) return (TRC_4);
+  v_length= val;
+  for (z_ind= 1; ; z_ind= 0) {
+    if ((c= fgetc(in)) == EOF) return (TRC_2);
+    clu_size[z_ind]= c;
+    if ((c= fgetc(in)) == EOF) return (TRC_2);
+    agg_size[z_ind]= c;
+    cat_size[z_ind]= clu_size[z_ind] + agg_size[z_ind];
+    if (cat_size[z_ind] > CODEC_CATEGORIES) return (TRC_6);
+    for (cat_bits[z_ind]= 0; (1 << cat_bits[z_ind]) < cat_size[z_ind] + SEQUENCE_ESCAPES; cat_bits[z_ind]++);
+    for (cat_ind= 0; cat_ind < cat_size[z_ind]; cat_ind++) {
+      if (!read_varint(in, val)) return (TRC_2);
+      cat_center[z_ind][cat_ind]= val;
+    }
+    if (z_ind == 0) break;
+  }
+
+  // bit-packed symbols
+  // ------------------
+  bit_acc= 0;
+  bit_count= 0;
+  sum1= 0;
+  sum2= 0;
+  for (ind= 1; ind <= v_length; ind++) {
+    z_ind= ind & 1;
+    bang[ind]= false;
+    while (true) {
+      if (!read_bits(in, cat_bits[z_ind], val)) return (TRC_2);
+      sum1= (sum1 + val) % 255;
+      sum2= (sum2 + sum1) % 255;
+      if (val != (uint32_t) cat_size[z_ind] + SEQUENCE_BANG) break;
+      bang[ind]= true;
+    }
+    if      (val <  cat_size[z_ind])                                sym[ind]= (val < 10) ? '0' + val : 87 + val;
+    else if (val == (uint32_t) cat_size[z_ind] + SEQUENCE_TOP)      sym[ind]= '*';
+    else if (val == (uint32_t) cat_size[z_ind] + SEQUENCE_LOWER)    sym[ind]= '-';
+    else if (val == (uint32_t) cat_size[z_ind] + SEQUENCE_NONE)     sym[ind]= '?';
+    else if (val == (uint32_t) cat_size[z_ind] + SEQUENCE_ZERO)     sym[ind]= ' ';
+    else return (TRC_6);
+  }
+
+  // checksum
+  // --------
+  len= 2;
+  if (!read_uint16(in, checksum, len)) return (TRC_2);
+  if (checksum != ((sum2 << 8) | sum1)) return (TRC_5);
+
+  // printer view (cf. sequence_printer)
+  // ============
+  fprintf(out, "Categorized Sequence\n");
+  // sequence index
+  fprintf(out, "ind : 0");
+  k= 0;
+  j= 2;
+  for (ind= 0; ind <= v_length; ind+= 2) {
+    if (j == 10) {
+      if (++k == 10) k= 0;
+      fprintf(out, "%u", k);
+      j= 2;
+    } else {
+      j+= 2;
+      fprintf(out, " ");
+    }
+  }
+  fprintf(out, "\n");
+  // HIGH reliability marking, HIGH / LOW symbols, LOW reliability marking
+  fprintf(out, "    : ");
+  for (ind= 1; ind <= v_length; ind+= 2) fputc(bang[ind] ? '!' : ' ', out);
+  fprintf(out, "\nHIGH: ");
+  for (ind= 1; ind <= v_length; ind+= 2) fputc(sym[ind], out);
+  fprintf(out, "\nLOW : ");
+  for (ind= 2; ind <= v_length; ind+= 2) fputc(sym[ind], out);
+  fprintf(out, "\n    : ");
+  for (ind= 2; ind <= v_length; ind+= 2) fputc(bang[ind] ? '!' : ' ', out);
+  fprintf(out, "\n");
+  // categories (cf. category_table_printer)
+  fprintf(out, "\nCategories\nind : ");
+  for (cat_ind= 0; cat_ind < ((cat_size[1] > cat_size[0]) ? cat_size[1] : cat_size[0]); cat_ind++) fprintf(out, "\t%u", cat_ind);
+  fprintf(out, "\n");
+  for (z_ind= 1; ; z_ind= 0) {
+    fprintf(out, (z_ind == 1) ? "HIGH: " : "LOW : ");
+    for (cat_ind= 0; cat_ind < clu_size[z_ind]; cat_ind++) fprintf(out, "\t%u", cat_center[z_ind][cat_ind]);
+    fprintf(out, ";");
+    for (; cat_ind < cat_size[z_ind]; cat_ind++) fprintf(out, "\t%u", cat_center[z_ind][cat_ind]);
+    fprintf(out, "\n");
+    if (z_ind == 0) break;
+  }
+  return (TRC_0);
+
+} // end packed_sequence_reader
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool sequence_reader (              // true: trace read
+  uint16_t signal_duration[],       // O  signal sequence (NV + 5): [odd indices]: HIGH-durations, [even indices]: LOW-durations
+  uint16_t &sequence_length,        // O  number of signal durations: HIGH- plus LOW-durations without "ending"
+  uint16_t &unreliable_count        // O  number of unreliable (flagged) values
+) {
+  // ********************* //
+  // T.5 sequence_reader   //  next text trace from the standard input (off-line processing, cf. categorizer.h)
+  // ********************* //
+  // traces with errors are skipped
+  trace_record t;
+  uint8_t      rc;
+
+  do {
+    rc= text_trace_reader(stdin, signal_duration, NV + 5, t);
+    if (rc == TRC_1) return (false);
+  } while (rc != TRC_0);
+  sequence_length=  t.count;
+  unreliable_count= t.unreliable_count;
+  return (true);
+
+} // end sequence_reader
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// ********** //
+// T.6 Helper //
+// ********** //
+
+bool read_uint16 (FILE *in, uint16_t &val, uint16_t &len)
+{
+  // ----------------- //
+  // T.6.1 read_uint16 //  little endian, len: remaining frame length
+  // ----------------- //
+  int lo, hi;
+  if (len < 2) return (false);
+  if ((lo= fgetc(in)) == EOF) return (false);
+  if ((hi= fgetc(in)) == EOF) return (false);
+  val= (uint16_t)(lo | (hi << 8));
+  len-= 2;
+  return (true);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint16_t trace_checksum (uint16_t signal_duration[], uint16_t n)
+{
+  // -------------------- //
+  // T.6.2 trace_checksum //  Fletcher16 (cf. categorizer_lib.cpp), summed over the 16-bit durations
+  // -------------------- //
+  uint16_t sum1= 0;
+  uint16_t sum2= 0;
+  uint16_t ind;
+  for (ind= 1; ind <= n; ind++) {
+    sum1= (sum1 + signal_duration[ind]) % 255;
+    sum2= (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool read_varint (FILE *in, uint32_t &val)
+{
+  // ----------------- //
+  // T.6.3 read_varint //  7 bits per byte, least significant group first (cf. codec.cpp: varint_encoder)
+  // ----------------- //
+  int     c;
+  uint8_t shift= 0;
+  val= 0;
+  do {
+    if ((c= fgetc(in)) == EOF) return (false);
+    if (shift > 28) return (false);
+    val|= (uint32_t)(c & 0x7F) << shift;
+    shift+= 7;
+  } while (c & 0x80);
+  return (true);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool read_bits (FILE *in, uint8_t n, uint32_t &val)
+{
+  // --------------- //
+  // T.6.4 read_bits //  bit-packed, most significant bit first (cf. codec.cpp: bit_encoder)
+  // --------------- //
+  val= 0;
+  while (n > 0) {
+    if (bit_count == 0) {
+      if ((bit_acc= fgetc(in)) == EOF) return (false);
+      bit_count= 8;
+    }
+    bit_count--;
+    val= (val << 1) | ((bit_acc >> bit_count) & 1);
+    n--;
+  }
+  return (true);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool read_line (FILE *in, char line[])
+{
+  // --------------- //
+  // T.6.5 read_line //  next text line (TEXT_LINE_DIM), the remainder of longer lines is skipped
+  // --------------- //
+  int c;
+  if (fgets(line, TEXT_LINE_DIM, in) == NULL) return (false);
+  if (strchr(line, '\n') == NULL) {
+    while (((c= fgetc(in)) != EOF) && (c != '\n'));
+  }
+  return (true);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+uint8_t parse_numbers (const char line[], long val[], uint8_t val_dim)
+{
+  // ------------------- //
+  // T.6.6 parse_numbers //  the first val_dim integers of a text line (tabs, blanks and "/" as separators)
+  // ------------------- //
+  uint8_t n= 0;
+  char    *end;
+  while ((*line != '\0') && (n < val_dim)) {
+    if ((*line == '-') || ((*line >= '0') && (*line <= '9'))) {
+      val[n]= strtol(line, &end, 10);
+      if (end == line) return (n);
+      n++;
+      line= end;
+    } else if ((*line == ' ') || (*line == '\t') || (*line == '/') || (*line == '\r') || (*line == '\n')) {
+      line++;
+    } else {
+      // text: the line holds no (more) numbers
+      return (n);
+    }
+  }
+  return (n);
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
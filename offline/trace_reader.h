@@ -0,0 +1,84 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ============================
+  = Trace Reader (Interface) =  off-line processing of the receiver output
+  ============================
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+
+// binary trace frame (cf. receiver.ino: binary_reporting)
+#define BINARY_MARKER_1  '!'
+#define BINARY_MARKER_2  'B'
+#define TRACE_STRENGTHS    9      // WARM_UP + 1 (cf. radio_lib.h)
+
+// compressed trace (cf. codec.h)
+#define CODEC_MARKER_1   '!'
+#define CODEC_MARKER_2   'C'
+#define CODEC_RAW          0      // mode: zigzag varint deltas
+#define CODEC_CATEGORY     1      // mode: category index plus Rice coded residual (bit-packed)
+#define CODEC_CATEGORIES  36      // maximal NC + NA (cf. categorizer.h: dimension constraints)
+#define CODEC_RICE_LIMIT   8      // maximal Rice quotient, larger residuals are escaped
+
+// packed categorized sequence (cf. codec.h)
+#define SEQUENCE_MARKER_1  '!'
+#define SEQUENCE_MARKER_2  'S'
+#define SEQUENCE_TOP       0      // escape codes, following the category indices
+#define SEQUENCE_LOWER     1
+#define SEQUENCE_NONE      2
+#define SEQUENCE_ZERO      3
+#define SEQUENCE_BANG      4      // prefix: the next symbol belongs to an unreliable value
+#define SEQUENCE_ESCAPES   5
+#define PACKED_DIM      1024      // maximal number of values of a packed sequence
+// text trace (cf. receiver.ino: reporting)
+#define TEXT_MARKER      "!TRACE!"
+#define TEXT_STRENGTHS   "signal-strength"
+#define TEXT_REFERENCE   "ref_strength:"
+#define TEXT_LINE_DIM    160      // maximal length of a text line
+
+// trace reader return codes
+// =========================
+#define TRC_0 0       // trace read
+#define TRC_1 1       // end of file: no more trace
+#define TRC_2 2       // frame error: truncated frame
+#define TRC_3 3       // frame error: inconsistent frame length
+#define TRC_4 4       // frame error: trace longer than the buffer
+#define TRC_5 5       // checksum error
+#define TRC_6 6       // frame error: unknown mode or category index
+
+typedef struct {
+  // everything reporting() / binary_reporting() sends along with the durations
+  uint16_t count;                       // rs.count: index of the last LOW (without end-record)
+  uint16_t unreliable_count;            // rs.unreliable_count
+  uint8_t  ref_strength_high;           // rs.ref_strength_high
+  uint8_t  ref_strength_low;            // rs.ref_strength_low
+  uint8_t  strength_count;              // number of warm-up strengths
+  uint8_t  strength[TRACE_STRENGTHS];   // rs.strength[1 .. strength_count]
+  uint16_t checksum;                    // Fletcher16 checksum of the durations
+} trace_record;
+
+// read the next binary trace frame: signal_duration[1 .. count + 2] ("ending" included)
+uint8_t binary_trace_reader (FILE *in, uint16_t signal_duration[], uint16_t duration_dim, trace_record &t);
+// read the next compressed trace: signal_duration[1 .. count + 2] (no strengths)
+uint8_t compressed_trace_reader (FILE *in, uint16_t signal_duration[], uint16_t duration_dim, trace_record &t);
+// read the next text trace (output_option 1): signal_duration[1 .. count + 2] ("ending" included)
+uint8_t text_trace_reader (FILE *in, uint16_t signal_duration[], uint16_t duration_dim, trace_record &t);
+// decode the next packed categorized sequence and print it as the sequence_printer does
+uint8_t packed_sequence_reader (FILE *in, FILE *out);
+// Fletcher16 checksum of signal_duration[1 .. n] (cf. receiver.ino: reporting)
+uint16_t trace_checksum (uint16_t signal_duration[], uint16_t n);
@@ -0,0 +1,65 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ========================
+  = Profiler (Interface) =  cycle counts of the recorder and categorizer stages (cf. radio_lib.cpp: 0.6)
+  ========================
+
+  STAGE_MARK(s) is placed at the stage boundaries: it closes the stage in progress and opens stage s.
+  - PROFILING == CYCLE_PROFILING: Timer1 runs at the CPU clock (prescaler 1), the cycles of each stage
+    are accumulated in profile (printed and reset by receiver.ino: processing)
+  - STAGE_HOOK (host build, cf. offline/Makefile): STAGE_MARK calls the stage_hook of the benchmark
+  - otherwise STAGE_MARK is empty: no code, no RAM
+  The Timer1 overflow interrupt (every 4.1 ms) adds about 50 cycles to the poll loop it interrupts.
+  The capture backend owns Timer1: profiling requires RECORDER_BACKEND == POLL_BACKEND.
+*/
+
+// profiling build
+#define NO_PROFILING       0    // STAGE_MARK is empty
+#define CYCLE_PROFILING    1    // Timer1 cycle counts per stage (ATmega328P)
+#define PROFILING          NO_PROFILING
+
+// stages
+#define STAGE_WARM_UP      0    // recorder:    detected start trigger .. end of warm-up (1.2 - 1.3)
+#define STAGE_RECORDING    1    // recorder:    following signals .. end of reception (1.4 - 1.6)
+#define STAGE_CLUSTERER    2    // categorizer: trusted mask, histogram initialization, post-clustering (2.1)
+#define STAGE_HISTOGRAM    3    // categorizer: histogram pass (2.1.1.2), counted per pass
+#define STAGE_OUTLIERS     4    // corrector:   outlier correction (2.2.1)
+#define STAGE_SUBSEQUENCES 5    // corrector:   untrusted subsequences correction (2.2.2)
+#define STAGE_PRINTER      6    // output stage: sequence_printer (3.5), frame_merger (2.4), protocol_decoder (2.5), ...
+#define STAGE_COUNT        7    // number of stages
+#define STAGE_NONE       255    // no stage: closes the stage in progress
+
+#if defined(STAGE_HOOK)
+  void stage_hook (uint8_t stage);     // defined by the host driver (offline/benchmark.cpp)
+  #define STAGE_MARK(s)  stage_hook(s)
+#elif (PROFILING == CYCLE_PROFILING)
+  typedef struct {
+    uint32_t cycles[STAGE_COUNT];      // accumulated cycles per stage
+    uint16_t count[STAGE_COUNT];       // number of closed stages (histogram: number of passes)
+    uint32_t strength_cycles;          // accumulated cycles of signal_strength()
+    uint16_t strength_max;             // longest signal_strength() [cycles]
+    uint16_t strength_count;           // number of signal_strength() calls
+  } profile_stats;
+  extern profile_stats profile;        // accumulated since the previous profile_reset
+
+  void profile_begin ();               // take over Timer1 (normal mode, prescaler 1, overflow interrupt)
+  void profile_reset ();
+  void profile_mark (uint8_t stage);
+  #define STAGE_MARK(s)  profile_mark(s)
+#else
+  #define STAGE_MARK(s)
+#endif
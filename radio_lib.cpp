@@ -25,35 +25,71 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
 
   ====================
   = 0. Radio Library =  remove glitches/bounces from the current signal and get the strength of the next signal 
   ====================
 
   0. Radio Library
-  0.1 Radio Module 1
-  0.1.1 RM1 Loop While High
-  0.1.1 RM1 Loop While Low
-  0.2 Radio Module 2
-  0.2.1 RM2 Loop While High
-  0.2.2 RM2 Loop While Low  
-  0.3 Poll Selected Radio (Wrapper)
-  0.3.1 Loop While High
-  0.3.2 Loop While Low
+  0.1 Radio Modules
+  0.1.1 RM1 / RM2 DIO2
+  0.1.2 Debounce Constants
+  0.2 Poll Kernel
+  0.2.1 Poll Loop While High
+  0.2.2 Poll Loop While Low  
+  0.3 Poll Selected Radio
+  0.3.1 Select Kernel
+  0.3.2 Dual Wait Start
   0.4 Helper
   0.4.1 Radio Initialization 
-  0.4.2 SPI Begin
+  0.4.2 SPI Begin / Select Radio
   0.4.3 Get Signal Strength
+  0.4.3.1 Fast Signal Strength
+  0.4.3.2 Strength Schedule / Calibrate
   0.4.4 Set Mode
   0.4.5 Set Frequency
   0.4.6 Set Threshold
   0.4.7 Set Power
+  0.4.8 Channel Activity
+  0.5 Capture Backend
+  0.5.1 Capture Begin / End
+  0.5.2 Capture Interrupts
+  0.5.3 Capture Wait
+  0.5.4 CAP Loop While High
+  0.5.5 CAP Loop While Low
+  0.6 Profiler (PROFILING == CYCLE_PROFILING)
+  0.6.1 Profile Begin / Reset
+  0.6.2 Profile Mark
+  0.7 Listen Idle (IDLE_MODE == LISTEN_IDLE)
+  0.7.1 Listen Wait
+  0.7.2 Listen Interrupts
+
+  HOST_SIMULATION (host build, cf. offline/Makefile): the DIO2 levels and the strengths of both radio modules
+  come from the radio simulator (offline/simulator.cpp), the poll kernels and the recorder are compiled unchanged;
+  the SPI access of signal_strength and the capture backend are not part of the simulation.
  */
  
 #include <Arduino.h>
 #include <SPI.h>
 #include "RFM69_registers.h"  
 #include "radio_lib.h" 
+#include "profiler.h"
+#ifdef HOST_SIMULATION
+#include "simulator.h"
+#endif
+#if (IDLE_MODE == LISTEN_IDLE)
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#endif
+
+#if (PROFILING == CYCLE_PROFILING) && (RECORDER_BACKEND == CAPTURE_BACKEND)
+#error "profiling needs Timer1: use the poll backend (cf. profiler.h)"
+#endif
+#if defined(HOST_SIMULATION) && ((RECORDER_BACKEND != POLL_BACKEND) || (IDLE_MODE != BUSY_IDLE) || (PROFILING != NO_PROFILING))
+#error "the radio simulator drives the poll kernels: use the poll backend, the busy idle and no profiling"
+#endif
 
 // durations (number of polling cycles)
 // ---------
@@ -66,9 +102,23 @@
 #define CEIL_UL      4294967000UL       // limit of measured LOW  durations (UL: Unsigned Long ~ 32 bits)  
 #define LC2                   2         // lost cycles
 #define LC25                 25         // lost cycles
-#define LC100               100         // lost cycles
+#define LC_EDGE              20         // lost cycles at the end of a signal (return, recorder, re-entry), without signal_strength
+#define LC_CALIBRATION       64         // number of signal_strength calls timed by strength_calibrate
+#define DUAL_POLL             2         // poll cycles per dual poll cycle (dual_wait_start polls two pins)
 #define RFM69_0X00 0
 
+// capture backend (cf. RECORDER_BACKEND in radio_lib.h)
+// ---------------
+// Timer1 runs with prescaler 8: 1 tick = 0.5 us (16 MHz), which is about the duration of one poll cycle,
+// so that the durations above (SPIKE_HIGH ... CEIL_UL) keep their meaning when counted in ticks
+#define CAPTURE_SIZE         16         // edge ring buffer size (power of 2)
+#define CAPTURE_MASK (CAPTURE_SIZE - 1)
+#define CAP_EDGE              0         // cap_wait: the level has ended (edge consumed)
+#define CAP_TIMEOUT           1         // cap_wait: the level lasts longer than the limit
+// dual edges (RM_DUAL, cf. capture_other_begin): 16 bits per edge, the LSB is the level after the edge
+// bit 15 clear: delta to the previous edge in ticks (< 32768), bit 15 set: in units of 64 ticks (saturates at 0.5 s)
+#define DUAL_DELTA(e) (((e) & 0x8000) ? ((unsigned long)((e) & 0x7FFE) << 5) : (unsigned long)((e) & 0x7FFE))
+
 // RM 1: radio module 1 connection
 // -------------------------------
 // slave select SS1
@@ -77,6 +127,9 @@
 #define RFM69_1_DIO1_PIN  PINB
 #define RFM69_1_DIO1_PORT PORTB         // B (digital pins 8 to 13) 
 #define RFM69_1_DIO1_MASK (1 << 1)      // DIO1 <-- pin 9  (RM1 dclk set)
+// RSSI interrupt --> pin 3 (listen idle)
+#define RFM69_1_DIO0_PIN  PIND
+#define RFM69_1_DIO0_MASK (1 << 3)      // DIO0 --> pin 3  (RM1 RssiIrq, PCINT19)
 // data <-> pin 8
 #define RFM69_1_DIO2_DDR  DDRB
 #define RFM69_1_DIO2_PIN  PINB
@@ -84,6 +137,10 @@
 #define RFM69_1_DIO2_MASK (1 << 0)      // DIO2 <-> pin 8  (RM1 data send/receive)
 #define DATA_1_PIN        8
 
+// slave select SS1 --> pin 10
+#define RFM69_1_NSS_PORT  PORTB
+#define RFM69_1_NSS_MASK  (1 << 2)      // NSS  <-- pin 10 (SS1)
+
 // RM 2: radio module 2 connection
 // -------------------------------
 // slave select SS2
@@ -92,12 +149,30 @@
 #define RFM69_2_DIO1_PIN PIND
 #define RFM69_2_DIO1_PORT PORTD         // D (digital pins 0 to 7) 
 #define RFM69_2_DIO1_MASK (1 << 7)      // DIO1 <-- pin 7  (RM2 dclk set)
+// RSSI interrupt --> pin 2 (listen idle)
+#define RFM69_2_DIO0_PIN PIND
+#define RFM69_2_DIO0_MASK (1 << 2)      // DIO0 --> pin 2  (RM2 RssiIrq, PCINT18)
 // data <-> pin 6
 #define RFM69_2_DIO2_DDR DDRD
 #define RFM69_2_DIO2_PIN PIND
 #define RFM69_2_DIO2_PORT PORTD        
 #define RFM69_2_DIO2_MASK (1 << 6)      // DIO2 <-> pin 6  (RM2 data send/receive)
 #define DATA_2_PIN        6
+// slave select SS2 --> pin 5
+#define RFM69_2_NSS_PORT  PORTD
+#define RFM69_2_NSS_MASK  (1 << 5)      // NSS  <-- pin 5  (SS2)
+
+// strength sampling (cf. STRENGTH_SAMPLES, STRENGTH_SAMPLING in radio_lib.h)
+// -----------------
+#if   (STRENGTH_SAMPLES == 1)
+#define STRENGTH_SHIFT        1         // raw rssi / 2
+#elif (STRENGTH_SAMPLES == 2)
+#define STRENGTH_SHIFT        2         // sum of 2 raw rssi / 4
+#elif (STRENGTH_SAMPLES == 4)
+#define STRENGTH_SHIFT        3         // sum of 4 raw rssi / 8
+#else
+#error "STRENGTH_SAMPLES must be 1, 2 or 4"
+#endif
 
 // RFM69 library
 // -------------
@@ -111,23 +186,130 @@ void RFM69rcCalibration();
 void RFM69writeReg(byte addr, byte value);
 byte RFM69readReg(byte addr);
 
+// capture backend
+// ---------------
+// (also the Timer1 overflow count of the profiler and the PCINT2 handler of the listen idle, cf. 0.5)
+#if !defined(HOST_SIMULATION) && ((RECORDER_BACKEND == CAPTURE_BACKEND) || (IDLE_MODE == LISTEN_IDLE) || (PROFILING == CYCLE_PROFILING))
+volatile unsigned long cap_edge[CAPTURE_SIZE];  // edge timestamps [ticks], LSB: signal level after the edge
+volatile byte cap_head;                 // next ring buffer entry to be written (interrupt)
+volatile byte cap_tail;                 // next ring buffer entry to be read (cap_wait)
+volatile bool cap_lost;                 // ring buffer overflow: at least one edge has been lost
+volatile unsigned int cap_overflow_count;  // Timer1 overflows: upper 16 bits of the timestamps
+volatile byte cap_isr_level;            // RM_2: last level seen by the pin change interrupt
+unsigned long cap_pos;                  // timestamp up to which the signal durations have been accounted
+byte cap_level;                         // level of the accounted signal at cap_pos
+byte cap_tccr1a;                        // saved Timer1 configuration (Arduino PWM on pins 9 / 10)
+byte cap_tccr1b;
+unsigned long cap_now();
+byte cap_source(byte radio_module);
+void dual_push(unsigned long edge);
+// RM_DUAL: the edges of the other radio module, buffered in a free slot during a reception (cf. capture_other_begin)
+volatile uint16_t *dual_edge;           // dual edges (DUAL_DELTA)
+volatile byte dual_capacity;            // number of dual edges of the buffer
+volatile byte dual_head;                // next dual edge to be written (interrupt)
+byte dual_tail;                         // next dual edge to be read (replay)
+volatile byte dual_module;              // the other radio module (0: only the active one is captured)
+volatile bool dual_started;             // a HIGH after a long pause has been captured (a reception to replay)
+volatile unsigned long dual_prev;       // timestamp of the last captured dual edge, as reconstructed [ticks]
+volatile unsigned long dual_base;       // timestamp of the edge in front of dual_edge[dual_tail] [ticks]
+volatile bool cap_replay;               // cap_wait reads the dual edges (replay of the other radio module)
+#endif
+
+// strength sampling
+// -----------------
+unsigned int strength_lost= 100;        // lost poll cycles of one signal_strength call (measured by strength_calibrate)
+unsigned int threshold_lost= 25;        // lost poll cycles of one set_threshold call (measured by strength_calibrate)
+byte strength_interval=      1;         // sample the strength of every strength_interval-th signal
+byte strength_countdown=     1;         // signals until the next sample
+byte strength_default_high;             // strength assumed for a HIGH that is not sampled
+byte strength_default_low;              // strength assumed for a LOW  that is not sampled
+inline bool strength_due();
+inline byte rm1_signal_strength();
+inline byte rm2_signal_strength();
+
+#if (IDLE_MODE == LISTEN_IDLE)
+// listen idle (cf. radio_lib.h: listen_statistics)
+// -----------
+listen_statistics listen_stats;         // wakes, sleep time and wake latency since the start
+#endif
+
+#if (PROFILING == CYCLE_PROFILING)
+// profiler (cf. profiler.h)
+// --------
+profile_stats profile;                  // accumulated cycles per stage
+byte          profile_stage;            // stage in progress (STAGE_NONE: none)
+unsigned long profile_start;            // start of the stage in progress [cycles]
+#endif
+
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-// ****************** //
-// 0.1 Radio Module 1 //  
-// ****************** //
-// 0.1.1 RM1 Loop While High
-// 0.1.1 RM1 Loop While Low
+// ******************* //
+// 0.1 Radio Modules   //  what the poll kernel needs to know about a radio module (compile-time)
+// ******************* //
+// 0.1.1 RM1 / RM2 DIO2
+// 0.1.2 Debounce Constants
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  A radio module is a class with two static inline functions:
+  - high()    : level of the DIO2 pin (a constant port and mask: compiles to a single sbis / sbic)
+  - strength(): signal_strength of the module (constant chip select, cf. 0.4.3.1)
+  The debounce constants are a class of enum values, so that a tuned variant of the kernel 
+  is a new class and one more instantiation (cf. 0.3.1 select_kernel), not a copy of the loops.
+*/
+
+// ---------------------- //
+// 0.1.1 RM1 / RM2 DIO2   //
+// ---------------------- //
+#ifdef HOST_SIMULATION
+// the simulated timeline advances by one poll cycle per DIO2 read (cf. offline/simulator.cpp)
+struct rm1_radio {
+  static inline bool high()     {return sim_high(RM_1);}
+  static inline byte strength() {return rm1_signal_strength();}
+};
+struct rm2_radio {
+  static inline bool high()     {return sim_high(RM_2);}
+  static inline byte strength() {return rm2_signal_strength();}
+};
+#else
+struct rm1_radio {
+  static inline bool high()     {return (RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_1_DIO2_MASK;}
+  static inline byte strength() {return rm1_signal_strength();}
+};
+struct rm2_radio {
+  static inline bool high()     {return (RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_2_DIO2_MASK;}
+  static inline byte strength() {return rm2_signal_strength();}
+};
+#endif
+
+// ------------------------ //
+// 0.1.2 Debounce Constants //
+// ------------------------ //
+struct debounce_default {
+  enum {
+    spike_high=   SPIKE_HIGH,           // high trigger: the spike is a HIGH 
+    drop_low=     DROP_LOW,             // low  trigger: the drop  is a LOW
+    trigger_low=  TRIGGER_LOW,          // min LOW  to trigger the end of a HIGH
+    trigger_high= TRIGGER_HIGH          // min HIGH to trigger the end of a LOW
+  };
+};
 
-//******************************* begin rm1_loop_while_high ************************************************************************
-byte rm1_loop_while_high(unsigned int &duration_high, unsigned long &duration_low, byte &strength_low) 
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// *************** //
+// 0.2 Poll Kernel //  template <class RADIO, class DEBOUNCE>, instantiated per radio module
+// *************** //
+// 0.2.1 Poll Loop While High
+// 0.2.2 Poll Loop While Low
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+//******************************* begin poll_loop_while_high ***********************************************************************
+template <class RADIO, class DEBOUNCE>
+byte poll_loop_while_high(unsigned int &duration_high, unsigned long &duration_low, byte &strength_low) 
 {
-  // ------------------------- //
-  // 0.1.1 RM1 LOOP WHILE HIGH //
-  // ------------------------- //
+  // -------------------------- //
+  // 0.2.1 POLL LOOP WHILE HIGH //
+  // -------------------------- //
   // loop as long as the signal is high 
-  // at beginning:   duration_high >= TRIGGER_HIGH (passed from previous rm1_loop_while_low)
-  // at termination: duration_low  >  TRIGGER_LOW  ("sufficiently" long to start a new LOW) 
+  // at beginning:   duration_high >= DEBOUNCE::trigger_high (passed from previous poll_loop_while_low)
+  // at termination: duration_low  >  DEBOUNCE::trigger_low  ("sufficiently" long to start a new LOW) 
   //                 duration_high :  total HIGH duration 
   //                 strength_low  :  signal strength of the following LOW
   // return codes:
@@ -144,11 +326,11 @@ byte rm1_loop_while_high(unsigned int &duration_high, unsigned long &duration_lo
       strength_low= 0;           
       // begin HIGH-loop
       while(true) {   
-        // continue after a drop ( <= TRIGGER_LOW )
-        //      AND a long HIGH  ( > SPIKE_HIGH )
+        // continue after a drop ( <= DEBOUNCE::trigger_low )
+        //      AND a long HIGH  ( > DEBOUNCE::spike_high )
         
         temp_duration= LC2; 
-        while((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_1_DIO2_MASK) {
+        while(RADIO::high()) {
           // counterbalance bouncing loop, which is slower 
           __asm__ __volatile__ ("nop\n");
           // overflow on HIGH
@@ -157,24 +339,24 @@ byte rm1_loop_while_high(unsigned int &duration_high, unsigned long &duration_lo
         duration_high+= temp_duration;
         // potential low detected
         
-        // bouncing loop : loop as long as the drop duration <= TRIGGER_LOW
+        // bouncing loop : loop as long as the drop duration <= DEBOUNCE::trigger_low
         // expect dozens of bounces at high sensitivity
         // assumption: spike and drop cycles are of about equal duration      
         accumulated_duration= 0;
         do { 
           // is this a genuine LOW or just a drop?
           temp_duration= LC2;
-          while((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_0X00) {
-            if (++temp_duration > TRIGGER_LOW) {goto EOB;}                        // End-Of-Bouncing       -------> EOB 
+          while(!RADIO::high()) {
+            if (++temp_duration > DEBOUNCE::trigger_low) {goto EOB;}                        // End-Of-Bouncing       -------> EOB 
           } 
           accumulated_duration+= temp_duration;         
           // a drop has been detected
           // is the following HIGH a genuine HIGH or just a spike?
-          // (the sensitivity of SPIKE_HIGH is surprisingly small)
+          // (the sensitivity of DEBOUNCE::spike_high is surprisingly small)
           temp_duration= LC2;
-          while((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_1_DIO2_MASK) {
+          while(RADIO::high()) {
             __asm__ __volatile__ ("nop\n");
-            if (++temp_duration > SPIKE_HIGH) {goto CWH;}                         // Continue-With-High    -------> CWH  
+            if (++temp_duration > DEBOUNCE::spike_high) {goto CWH;}                         // Continue-With-High    -------> CWH  
           } 
           accumulated_duration+= temp_duration;          
           // after a drop followed a spike
@@ -185,8 +367,11 @@ byte rm1_loop_while_high(unsigned int &duration_high, unsigned long &duration_lo
 EOB:    // End-Of-Bouncing
         // get signal_strength
         // +++++++++++++++++++
-        strength_low= signal_strength(); 
-        duration_low= accumulated_duration + temp_duration + LC100;
+        if (strength_due()) {
+          strength_low= RADIO::strength(); 
+          temp_duration+= strength_lost;
+        } else strength_low= strength_default_low;
+        duration_low= accumulated_duration + temp_duration + LC_EDGE;
         // end of HIGH
         return RRC_1;                                                             // end of High           -------> return RRC_1 
 
@@ -197,18 +382,19 @@ CWH:    // continue with high
       }  
       // end of loop on HIGH  (while(true))                                       // continue high loop
 }
-//******************************* end rm1_loop_while_high **************************************************************************
+//******************************* end poll_loop_while_high *************************************************************************
 
-//******************************* begin rm1_loop_while_low *************************************************************************
-byte rm1_loop_while_low(unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit) 
+//******************************* begin poll_loop_while_low ************************************************************************
+template <class RADIO, class DEBOUNCE>
+byte poll_loop_while_low(unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit) 
 {
-  // ------------------------ //
-  // 0.1.2 RM1 LOOP WHILE LOW //
-  // ------------------------ //
+  // ------------------------- //
+  // 0.2.2 POLL LOOP WHILE LOW //
+  // ------------------------- //
   // loop as long as the signal is low 
-  // at beginning:   duration_low  >= TRIGGER_LOW  (passed from previous rm1_loop_while_high)
+  // at beginning:   duration_low  >= DEBOUNCE::trigger_low  (passed from previous poll_loop_while_high)
   //                 duration_low_limit : LOW "timeout" duration -> end of reception
-  // at termination: duration_high >  TRIGGER_HIGH ("sufficiently" long to start a new HIGH) 
+  // at termination: duration_high >  DEBOUNCE::trigger_high ("sufficiently" long to start a new HIGH) 
   //                 duration_low   : total LOW duration
   //                 strength_high  : signal strength of following HIGH
   // return code:
@@ -223,11 +409,11 @@ byte rm1_loop_while_low(unsigned int &duration_high, unsigned long &duration_low
       strength_high= 0;           
       // begin LOW-loop
       while(true) {       
-        // continue after a spike  ( <= TRIGGER_HIGH ) 
-        //          AND a long LOW ( >  DROP_LOW ) 
+        // continue after a spike  ( <= DEBOUNCE::trigger_high ) 
+        //          AND a long LOW ( >  DEBOUNCE::drop_low ) 
         
         temp_duration= LC2; 
-        while((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_0X00) {
+        while(!RADIO::high()) {
           // counterbalance bouncing loop, sightly slower 
           __asm__ __volatile__ ("nop\n");
           if (++temp_duration >= CEIL_UI) {
@@ -244,25 +430,25 @@ byte rm1_loop_while_low(unsigned int &duration_high, unsigned long &duration_low
         duration_low+= temp_duration;
         // potential high detected
         
-        // bouncing loop : loop as long as the spike duration <= TRIGGER_HIGH
+        // bouncing loop : loop as long as the spike duration <= DEBOUNCE::trigger_high
         // expect much more bounces than during the HIGH-loop
         // assumption: spike and drop cycles are of about equal duration      
         accumulated_duration= 0;
         do {  
           // is this a genuine HIGH or just a spike?
           temp_duration= LC2;
-          while((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_1_DIO2_MASK) {
+          while(RADIO::high()) {
             __asm__ __volatile__ ("nop\n");
             __asm__ __volatile__ ("nop\n");
-            if (++temp_duration > TRIGGER_HIGH) {goto EOB;}                      // End-Of-Bouncing       -------> EOB
+            if (++temp_duration > DEBOUNCE::trigger_high) {goto EOB;}                      // End-Of-Bouncing       -------> EOB
           } 
           accumulated_duration+= temp_duration; 
           // a spike has been detected
           // is the following LOW a genuine LOW or just a drop?
           temp_duration= LC2;
-          while((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_0X00) {
+          while(!RADIO::high()) {
             __asm__ __volatile__ ("nop\n");
-            if (++temp_duration > DROP_LOW) {goto CWL;}                          // Continue-With-Low     -------> CWL 
+            if (++temp_duration > DEBOUNCE::drop_low) {goto CWL;}                          // Continue-With-Low     -------> CWL 
           }
           accumulated_duration+= temp_duration; 
           // after a spike followed a drop
@@ -273,8 +459,11 @@ byte rm1_loop_while_low(unsigned int &duration_high, unsigned long &duration_low
 EOB:    // End-Of-Bouncing
         // get signal_strength
         // +++++++++++++++++++
-        strength_high= signal_strength();       
-        duration_high= accumulated_duration + temp_duration + LC100; 
+        if (strength_due()) {
+          strength_high= RADIO::strength();       
+          temp_duration+= strength_lost;
+        } else strength_high= strength_default_high;
+        duration_high= accumulated_duration + temp_duration + LC_EDGE; 
         // end of LOW
         return RRC_1;                                                            // end of LOW            -------> return RRC_1 
 
@@ -289,231 +478,135 @@ CWL:    // Continue-With-Low
       }                                                                          // continue low loop
       // end of loop on LOW (while(true))
 }
-//******************************* end rm1_loop_while_low **************************************************************************
+//******************************* end poll_loop_while_low *************************************************************************
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-// ****************** //
-// 0.2 Radio Module 2 //
-// ****************** //
-// 0.2.1 RM2 Loop While High
-// 0.2.1 RM2 Loop While Low
+// *********************** //
+// 0.3 Poll Selected Radio //
+// *********************** //
+// 0.3.1 Select Kernel
+// 0.3.2 Dual Wait Start
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-//******************************* begin rm2_loop_while_high ************************************************************************
-byte rm2_loop_while_high(unsigned int &duration_high, unsigned long &duration_low, byte &strength_low) 
-{
-  // ------------------------- //
-  // 0.2.1 RM2 LOOP WHILE HIGH //
-  // ------------------------- //
-  // loop as long as the signal is high 
-  // at beginning:   duration_high >= TRIGGER_HIGH (passed from previous rm1_loop_while_low)
-  // at termination: duration_low  >  TRIGGER_LOW  ("sufficiently" long to start a new LOW) 
-  //                 duration_high  : total HIGH duration 
-  //                 strength_low   : signal strength of the following LOW
-  // return codes:
-  // RRC_1 : end of HIGH
-  // RRC_3 : duration_high >= CEIL_UI (HIGH overflow)
-  // RRC_4 : too much HIGH bouncing
-  // NB: a duration_high in front of a reception end is often exceptionally short 
-  //     a duration_high >= CEIL_UI is considered as an anomaly -> return RRC_3 
-  
-      unsigned int  accumulated_duration;      // accumulated duration while bouncing
-      unsigned int  temp_duration;             // temp duration 
-  
-      duration_low= 0;
-      strength_low= 0;           
-      // begin HIGH-loop
-      while(true) {   
-        // continue after a drop ( <= TRIGGER_LOW )
-        //      AND a long HIGH  ( > SPIKE_HIGH )
-        
-        temp_duration= LC2; 
-        while((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_2_DIO2_MASK) {
-          // counterbalance bouncing loop, which is slower 
-          __asm__ __volatile__ ("nop\n");
-          if (++temp_duration >= CEIL_UI) return RRC_3;                          // high overflow         -------> return RRC_3
-        }   
-        duration_high+= temp_duration;
-        // potential low detected
-        
-        // bouncing loop : loop as long as the drop duration <= TRIGGER_LOW
-        // expect dozens of bounces at high sensitivity
-        // assumption: spike and drop cycles are of about equal duration      
-        accumulated_duration= 0;
-        do { 
-          // is this a genuine LOW or just a drop?
-          temp_duration= LC2;
-          while((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_0X00) {
-            if (++temp_duration > TRIGGER_LOW) {goto EOB;}                       // End-Of-Bouncing       -------> EOB 
-          } 
-          accumulated_duration+= temp_duration;         
-          // a drop has been detected
-          // is the following HIGH a genuine HIGH or just a spike?
-          // (the sensitivity of SPIKE_HIGH is surprisingly small)
-          temp_duration= LC2;
-          while((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_2_DIO2_MASK) {
-            __asm__ __volatile__ ("nop\n");
-            if (++temp_duration > SPIKE_HIGH) {goto CWH;}                        // Continue-With-High    -------> CWH  
-          } 
-          accumulated_duration+= temp_duration;          
-          // after a drop followed a spike
-        } while (accumulated_duration < CEIL_UI);  
-        // too much bouncing
-        return RRC_4;                                                            // too much bouncing     -------> return RRC_4
-      
-EOB:    // End-Of-Bouncing
-        // get signal_strength
-        // +++++++++++++++++++
-        strength_low= signal_strength(); 
-        duration_low= accumulated_duration + temp_duration + LC100;
-        return RRC_1;                                                            // end of High           -------> return RRC_1 
+// kernel of the active radio module (cf. radio_lib.h: loop_while_high / loop_while_low)
+// ---------------------------------
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+loop_high_kernel loop_while_high= cap_loop_while_high;
+loop_low_kernel  loop_while_low=  cap_loop_while_low;
+#else
+loop_high_kernel loop_while_high= poll_loop_while_high<rm1_radio, debounce_default>;
+loop_low_kernel  loop_while_low=  poll_loop_while_low <rm1_radio, debounce_default>;
+#endif
 
-CWH:    // continue with high     
-        duration_high+= accumulated_duration + temp_duration; 
-        if (duration_high >= CEIL_UI) return RRC_3;                              // high overflow         -------> return RRC_3
-      }  
-      // end of loop on HIGH  (while(true))                                      // continue high loop
+//******************************* begin select_kernel *****************************************************************************
+void select_kernel(byte radio_module)
+{
+  // ------------------- //
+  // 0.3.1 Select Kernel //
+  // ------------------- //
+  // the radio is chosen once per reception (called by select_radio), the recorder calls the kernel 
+  // through loop_while_high / loop_while_low without any further dispatch
+#if (RECORDER_BACKEND == POLL_BACKEND)
+  if (radio_module == RM_1) {
+    loop_while_high= poll_loop_while_high<rm1_radio, debounce_default>;
+    loop_while_low=  poll_loop_while_low <rm1_radio, debounce_default>;
+  }
+  if (radio_module == RM_2) {
+    loop_while_high= poll_loop_while_high<rm2_radio, debounce_default>;
+    loop_while_low=  poll_loop_while_low <rm2_radio, debounce_default>;
+  }
+#endif
 }
-//******************************* end rm2_loop_while_high **************************************************************************
 
-//******************************* begin rm2_loop_while_low *************************************************************************
-byte rm2_loop_while_low (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit) 
+//******************************* begin dual_wait_start ***************************************************************************
+byte dual_wait_start  (unsigned int &duration_high, byte &strength_high, unsigned long &pause_other, unsigned long duration_low_limit)
 {
-  // ------------------------ //
-  // 0.2.2 RM2 LOOP WHILE LOW //
-  // ------------------------ //
-  // loop as long as the signal is low 
-  // at beginning:   duration_low  >= TRIGGER_LOW  (passed from previous rm1_loop_while_high)
-  //                 duration_low_limit : LOW "timeout" duration -> end of reception
-  // at termination: duration_high >  TRIGGER_HIGH ("sufficiently" long to start a new HIGH) 
-  //                 duration_low   : total LOW duration
-  //                 strength_high  : signal strength of following HIGH
+  // --------------------- //
+  // 0.3.2 Dual Wait Start //
+  // --------------------- //
+  // both radio modules in RX mode: poll the DIO2 pins of RM_1 and RM_2 in one loop 
+  // (interleaved port masks) and wait for the first start trigger on either band
+  // a radio is armed by a LOW of at least LONG_PAUSE, spikes (<= TRIGGER_HIGH) do not interrupt the LOW
+  // an armed radio triggers with a HIGH > TRIGGER_HIGH (the end of its long pause)
+  // duration_low_limit  // I : LOW "timeout" duration (idle limit, cf. recorder: rp.idle_limit)
+  // duration_high       // O : HIGH duration so far (continued by loop_while_high)
+  // strength_high       // O : signal strength of the HIGH
+  // pause_other         // O : LOW duration of the other radio module so far (0: HIGH, cf. capture_other_begin)
   // return code:
-  // RRC_0 : duration_low >= duration_low_limit (cf. recorder: INFINITE_PAUSE or LONG_PAUSE)
-  // RRC_1 : end of LOW
-  // RRC_2 : too much LOW bouncing
-      
-      unsigned int accumulated_duration;      // accumulated duration while bouncing
-      unsigned int temp_duration;             // temp duration 
+  // RM_1 / RM_2 : the radio module that triggered, it is now the active one (_slaveSelectPin) 
+  // 0           : duration_low_limit reached (idle timeout)
+  // NB: one dual poll cycle lasts about two poll cycles, the durations advance by DUAL_POLL
   
-      duration_high= 0;
-      strength_high= 0;           
-      // begin LOW-loop
-      while(true) {       
-        // continue after a spike  ( <= TRIGGER_HIGH ) 
-        //          AND a long LOW ( >  DROP_LOW ) 
-        
-        temp_duration= LC2; 
-        while((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_0X00) {
-          // counterbalance bouncing loop, sightly slower 
-          __asm__ __volatile__ ("nop\n");
-          if (++temp_duration >= CEIL_UI) {
-            duration_low+= temp_duration;
-            if (duration_low >= duration_low_limit) {
-              duration_low= min(duration_low_limit, CEIL_UI_X2);
-              strength_high= 0;           
-              return RRC_0;                                                      // End-Of-Reception      -------> return RRC_0
+      unsigned long pause_1= 0;     // RM_1: LOW duration [poll cycles]
+      unsigned long pause_2= 0;     // RM_2: LOW duration [poll cycles]
+      unsigned long idle= 0;        // total waiting duration [poll cycles]
+      unsigned int  high_1= 0;      // RM_1: HIGH duration [poll cycles]
+      unsigned int  high_2= 0;      // RM_2: HIGH duration [poll cycles]
+
+      while (true) {
+        // RM_1
+        if (rm1_radio::high()) {
+          high_1+= DUAL_POLL;
+          if (high_1 > TRIGGER_HIGH) {
+            if (pause_1 >= LONG_PAUSE) {
+              select_radio(RM_1);
+              pause_other= (high_2 > TRIGGER_HIGH) ? 0 : pause_2;
+              strength_high= rm1_signal_strength();
+              duration_high= high_1 + strength_lost + LC_EDGE;
+              return RM_1;                                                       // RM_1 start trigger    -------> return RM_1
             }
-            temp_duration= LC2; 
-          }  
-        }        
-        duration_low+= temp_duration;
-        // potential high detected
-        
-        // bouncing loop : loop as long as the spike duration <= TRIGGER_HIGH
-        // expect much more bounces than during the HIGH-loop
-        // assumption: spike and drop cycles are of about equal duration      
-        accumulated_duration= 0;
-        do {  
-          // is this a genuine HIGH or just a spike?
-          temp_duration= LC2;
-          while((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_2_DIO2_MASK) {
-            __asm__ __volatile__ ("nop\n");
-            __asm__ __volatile__ ("nop\n");
-            if (++temp_duration > TRIGGER_HIGH) {goto EOB;}                      // End-Of-Bouncing       -------> EOB
-          } 
-          accumulated_duration+= temp_duration; 
-          // a spike has been detected
-          // is the following LOW a genuine LOW or just a drop?
-          temp_duration= LC2;
-          while((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_0X00) {
-            __asm__ __volatile__ ("nop\n");
-            if (++temp_duration > DROP_LOW) {goto CWL;}                          // Continue-With-Low     -------> CWL 
+            pause_1= 0;
           }
-          accumulated_duration+= temp_duration; 
-          // after a spike followed a drop
-        } while (accumulated_duration <= CEIL_UI);                               // continue bouncing loop  
-        // too much bouncing
-        return RRC_2;                                                            // too much bouncing     -------> return RRC_2
-        
-EOB:    // End-Of-Bouncing
-        // get signal_strength
-        // +++++++++++++++++++
-        strength_high= signal_strength();       
-        duration_high= accumulated_duration + temp_duration + LC100; 
-        return RRC_1;                                                            // end of LOW            -------> return RRC_1 
-
-CWL:    // Continue-With-Low
-        duration_low+= accumulated_duration + temp_duration; 
-        if (duration_low >= duration_low_limit) {
-          duration_low= min(duration_low_limit, CEIL_UI_X2);
-          strength_high= 0;           
-          return RRC_0;                                                          // End-Of-Reception      -------> return RRC_0
+        } else {
+          // a spike is part of the LOW, a genuine HIGH restarts it
+          if (high_1 > TRIGGER_HIGH) pause_1= 0;
+          else pause_1+= high_1;
+          pause_1+= DUAL_POLL;
+          high_1= 0;
         }
-      }                                                                          // continue low loop
-      // end of loop on LOW (while(true))
+        // RM_2
+        if (rm2_radio::high()) {
+          high_2+= DUAL_POLL;
+          if (high_2 > TRIGGER_HIGH) {
+            if (pause_2 >= LONG_PAUSE) {
+              select_radio(RM_2);
+              pause_other= (high_1 > TRIGGER_HIGH) ? 0 : pause_1;
+              strength_high= rm2_signal_strength();
+              duration_high= high_2 + strength_lost + LC_EDGE;
+              return RM_2;                                                       // RM_2 start trigger    -------> return RM_2
+            }
+            pause_2= 0;
+          }
+        } else {
+          if (high_2 > TRIGGER_HIGH) pause_2= 0;
+          else pause_2+= high_2;
+          pause_2+= DUAL_POLL;
+          high_2= 0;
+        }
+        // idle timeout
+        idle+= DUAL_POLL;
+        if (idle >= duration_low_limit) return 0;                                // idle timeout          -------> return 0
+        // a never ending HIGH (no signal on this band) must not overflow
+        if (high_1 >= CEIL_UI) high_1= TRIGGER_HIGH + 1;
+        if (high_2 >= CEIL_UI) high_2= TRIGGER_HIGH + 1;
+      }
 }
-//******************************* end rm2_loop_while_low **************************************************************************
-
-// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-// *********************** //
-// 0.3 Poll Selected Radio //
-// *********************** //
-// 0.3.1 Loop While High
-// 0.3.2 Loop While LOW
-// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-//******************************* begin Polling Selected Radio ********************************************************************
-byte loop_while_high  (unsigned int &duration_high, unsigned long &duration_low, byte &strength_low)
-{
-  // --------------------- //
-  // 0.3.1 Loop While High //
-  // --------------------- //
-  if(_slaveSelectPin == SS1) {
-    return rm1_loop_while_high(duration_high, duration_low, strength_low);
-  }
-  if(_slaveSelectPin == SS2) {
-    return rm2_loop_while_high(duration_high, duration_low, strength_low);
-  }
-  return (RRC_15);
-}  
-//******************************* begin Polling Selected Radio ********************************************************************
-byte loop_while_low   (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit)  
-{
-  // -------------------- //
-  // 0.3.2 Loop While LOW //
-  // -------------------- //
-  if(_slaveSelectPin == SS1) {
-    return rm1_loop_while_low(duration_high, duration_low, strength_high, duration_low_limit);  
-  }
-  if(_slaveSelectPin == SS2) {
-    return rm2_loop_while_low(duration_high, duration_low, strength_high, duration_low_limit);  
-  }
-  return (RRC_15);
-}  
-//******************************* end Polling Selected Radio **********************************************************************
+//******************************* end dual_wait_start *****************************************************************************
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 // ********** //
 // 0.4 Helper //
 // ********** //
 // 0.4.1 Radio Initialization 
-// 0.4.2 SPI Begin
+// 0.4.2 SPI Begin / Select Radio
 // 0.4.3 Get Signal Strength
+// 0.4.3.1 Fast Signal Strength
+// 0.4.3.2 Strength Schedule / Calibrate
 // 0.4.4 Set Mode
 // 0.4.5 Set Frequency
 // 0.4.6 Set Threshold
 // 0.4.7 Set Power
+// 0.4.8 Channel Activity
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 //*********************************************************************************************************************************
@@ -573,6 +666,8 @@ void init_radio()
   RFM69init(rmx_config);     
   RFM69setMode(RF69_MODE_STANDBY); 
   RFM69rcCalibration();
+  // lost cycles of signal_strength (the same for both radio modules)
+  strength_calibrate();
   SPI.end();
   delay(100);    
 
@@ -598,34 +693,119 @@ void SPI_begin(byte radio_module)
   SPI.setClockDivider(SPI_CLOCK_DIV2); // max speed, except on Due which can run at system clock speed
   SPI.begin();
   // set the _slaveSelectPin for the active radio module
+  select_radio(radio_module);
+  }
+
+void select_radio(byte radio_module)
+{
+  // the wrappers (loop_while_*, set_*) address the active radio module
   if (radio_module == RM_1) _slaveSelectPin= SS1;
   if (radio_module == RM_2) _slaveSelectPin= SS2;
-  }
+  select_kernel(radio_module);
+}
 //*********************************************************************************************************************************
 inline byte signal_strength() 
 {
   // ------------------------- //
   // 0.4.3 Get Signal Strength //
   // ------------------------- //
-  // Several measurements are required to obtain reproducible results. 
-  // Each measurement consumes a rather large amount of time compared to short signal durations.
+  // Several measurements are required to obtain reproducible results (STRENGTH_SAMPLES). 
+  // Each measurement consumes time that is lost for the poll loops, it is measured by strength_calibrate
+  // and added to the duration of the signal that ends (strength_lost).
   // Note that RSSI measurement is also required for collision detection
+  if (_slaveSelectPin == SS2) return rm2_signal_strength();
+  return rm1_signal_strength();
+}
+//*********************************************************************************************************************************
+#ifdef HOST_SIMULATION
+// the simulated strength measurement advances the timeline by the cycles of a signal_strength call
+inline byte rm1_signal_strength() {return sim_strength(RM_1);}
+inline byte rm2_signal_strength() {return sim_strength(RM_2);}
+#else
+inline byte fast_signal_strength(volatile uint8_t &nss_port, byte nss_mask) 
+{
+  // ---------------------------- //
+  // 0.4.3.1 Fast Signal Strength //
+  // ---------------------------- //
+  // nss_port, nss_mask  // I : slave select of the radio module (constants: the chip select compiles to cbi / sbi)
+  // the SPI registers are accessed directly: the previous raw rssi is accumulated while the next one is shifted in
 
-  int reg_rssi_sum= 4;  // Raw RSSI (rounding of 4 measurements)  
-  int strength;         // - RSSI [dBm] (dB per milliwatt)
+  int  reg_rssi_sum= STRENGTH_SAMPLES;  // Raw RSSI (rounding of STRENGTH_SAMPLES measurements)  
+  byte reg_rssi= 0;                     // Raw RSSI of the last measurement
+  int  strength;                        // - RSSI [dBm] (dB per milliwatt)
+#if (PROFILING == CYCLE_PROFILING)
+  unsigned long t= cap_now();
+#endif
 
-  // avg of 4 raw rssi measurements
-  for (int i=0; i<4; i++) {    
-    digitalWrite(_slaveSelectPin, LOW);
-    SPI.transfer(REG_RSSIVALUE & 0x7F);
-    reg_rssi_sum+= SPI.transfer(0);
-    digitalWrite(_slaveSelectPin, HIGH);          
+  // sum of STRENGTH_SAMPLES raw rssi measurements
+  for (byte i= 0; i < STRENGTH_SAMPLES; i++) {    
+    nss_port&= ~nss_mask;
+    SPDR= REG_RSSIVALUE & 0x7F;
+    while (!(SPSR & _BV(SPIF)));
+    SPDR= 0;
+    reg_rssi_sum+= reg_rssi;
+    while (!(SPSR & _BV(SPIF)));
+    reg_rssi= SPDR;
+    nss_port|= nss_mask;          
   }
-  // map raw rsssi -> strength (non-optimized)
+  reg_rssi_sum+= reg_rssi;
+  // map raw rsssi -> strength
   // RSSI (dBm)    = (RawRSSI – 256) / 2   =  - (128 - (RawRSSI / 2))
-  strength= 128 - (reg_rssi_sum >> 3);  // half of 4 measurements
+  strength= 128 - (reg_rssi_sum >> STRENGTH_SHIFT);  // half of the average
+#if (PROFILING == CYCLE_PROFILING)
+  // cycles stolen from the poll loop
+  t= cap_now() - t;
+  profile.strength_cycles+= t;
+  profile.strength_count++;
+  if (t > profile.strength_max) profile.strength_max= (t > 0xFFFF) ? 0xFFFF : t;
+#endif
   return (strength);
 }
+
+inline byte rm1_signal_strength() {return fast_signal_strength(RFM69_1_NSS_PORT, RFM69_1_NSS_MASK);}
+inline byte rm2_signal_strength() {return fast_signal_strength(RFM69_2_NSS_PORT, RFM69_2_NSS_MASK);}
+#endif
+//*********************************************************************************************************************************
+inline bool strength_due()
+{
+  // ------------------------------------- //
+  // 0.4.3.2 Strength Schedule / Calibrate //
+  // ------------------------------------- //
+  // is the strength of the signal that ends to be sampled?
+#if (STRENGTH_SAMPLING == SAMPLE_INTERVAL)
+  if (--strength_countdown) return false;
+  strength_countdown= strength_interval;
+#endif
+  return true;
+}
+
+void strength_schedule(byte interval, byte default_high, byte default_low)
+{
+  // interval      // I : sample the strength of every interval-th signal (1: every signal)
+  // default_high  // I : strength returned for a HIGH that is not sampled
+  // default_low   // I : strength returned for a LOW  that is not sampled
+  strength_interval=     interval;
+  strength_countdown=    interval;
+  strength_default_high= default_high;
+  strength_default_low=  default_low;
+}
+
+void strength_calibrate()
+{
+  // measure the poll cycles lost in one signal_strength call (1 poll cycle ~ 0.5 us, cf. capture backend)
+  // micros() has a resolution of 4 us: LC_CALIBRATION calls are timed together
+  unsigned long t= micros();
+  for (byte i= 0; i < LC_CALIBRATION; i++) signal_strength();
+  t= micros() - t;
+  strength_lost= (2 * t + (LC_CALIBRATION >> 1)) / LC_CALIBRATION;
+  // the same for one set_threshold call (OOK_THRESHOLD != FIXED_THRESHOLD: LC_THRESHOLD of the poll backend),
+  // the configured threshold is written back (the recorder sets its own at each start)
+  byte threshold= RFM69readReg(REG_OOKFIX);
+  t= micros();
+  for (byte i= 0; i < LC_CALIBRATION; i++) set_threshold(threshold);
+  t= micros() - t;
+  threshold_lost= (2 * t + (LC_CALIBRATION >> 1)) / LC_CALIBRATION;
+}
 //*********************************************************************************************************************************
 void set_mode(byte mode)
 { 
@@ -686,5 +866,654 @@ void set_power(byte power_level)
   // --------------- //
   RFM69writeReg(REG_PALEVEL, (RFM69readReg(REG_PALEVEL) & 0xE0) | power_level);  
 }
+//*********************************************************************************************************************************
+byte channel_activity(byte radio_module, long frequency, byte samples)
+{
+  // ---------------------- //
+  // 0.4.8 Channel Activity //
+  // ---------------------- //
+  // radio_module, frequency  // I : channel to be checked
+  // samples                  // I : number of strength measurements (about 30 us each, RSSI sample period ~ 25 us)
+  // returns the maximal strength measured on the channel (the radio is left in standby)
+  // a quick check of a scanned channel: much shorter than the LONG_PAUSE needed by the recorder to detect a start
+  byte strength;
+  byte max_strength= 0;
+
+  SPI_begin(radio_module);
+  set_frequency(frequency);
+  set_mode(RF69_MODE_RX);
+  delayMicroseconds(100);
+  while (samples-- > 0) {
+    strength= signal_strength();
+    if (strength > max_strength) max_strength= strength;
+    delayMicroseconds(20);
+  }
+  set_mode(RF69_MODE_STANDBY);
+  SPI.end();
+  return max_strength;
+}
 
+// Timer1 and PCINT2 are only taken over by their users: the sketch keeps them otherwise (Servo, SoftwareSerial, ...)
+#if !defined(HOST_SIMULATION) && ((RECORDER_BACKEND == CAPTURE_BACKEND) || (IDLE_MODE == LISTEN_IDLE) || (PROFILING == CYCLE_PROFILING))
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// ******************* //
+// 0.5 Capture Backend //  timestamp the DIO2 edges, debounce afterwards on the stored edges
+// ******************* //
+// 0.5.1 Capture Begin / End
+// 0.5.2 Capture Interrupts
+// 0.5.3 Capture Wait
+// 0.5.4 CAP Loop While High
+// 0.5.5 CAP Loop While Low
+// 0.5.6 Dual Capture (RM_DUAL)
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  The poll loops measure a duration by counting spin cycles, the MCU is blocked during the whole reception 
+  and every interruption (signal_strength, interrupts) shows up as lost cycles (LC2, LC_EDGE, strength_lost).
+  The capture backend lets the hardware timestamp each DIO2 edge with Timer1 (1 tick = 0.5 us):
+  - RM_1: DIO2 is connected to pin 8 = ICP1, the input capture unit latches TCNT1 at the edge
+  - RM_2: DIO2 is connected to pin 6 (PCINT22), the pin change interrupt reads TCNT1
+  The edges are buffered in a ring buffer (cap_edge). The cap_loop_while_* functions replay the edges
+  through the same debouncing as the poll loops (SPIKE_HIGH, DROP_LOW, TRIGGER_LOW, TRIGGER_HIGH).
+  The durations are therefore exact, independent of the loop timing and of the time spent in signal_strength.
+  The ring buffer only needs to bridge the time between two cap_wait calls; if it overflows, 
+  edges are lost and the reception is aborted as excessive bouncing (RRC_2 / RRC_4).
+  The backend improves the accuracy only, it does not free the CPU: cap_wait spins on the pending edges and the
+  timer for the whole reception (the ring buffer of CAPTURE_SIZE edges would not bridge a categorization),
+  the receiver categorizes in the idle gaps between the receptions as with the poll backend (cf. receiver.ino).
+  RM_DUAL: both edge sources run at once. While the band that triggered first is recorded, the edges of the other
+  band are buffered in a free slot (dual edges, 2 bytes each); once the first reception has ended, the recorder
+  replays the buffered one through cap_wait into that slot, and catches up with its edges still coming in.
+  The strengths of the replayed band cannot be measured afterwards: its signals get nominal strengths.
+*/
+
+//*********************************************************************************************************************************
+unsigned long cap_now()
+{
+  // current timestamp [ticks] (Timer1 extended by the overflow count)
+  unsigned int  t;
+  unsigned int  ovf;
+  noInterrupts();
+  t=   TCNT1;
+  ovf= cap_overflow_count;
+  // overflow pending, not yet counted by the interrupt
+  if ((TIFR1 & _BV(TOV1)) && (t < 0x8000)) ovf++;
+  interrupts();
+  return ((unsigned long)ovf << 16) | t;
+}
+//*********************************************************************************************************************************
+void cap_push(unsigned long edge)
+{
+  // add an edge to the ring buffer (called by the interrupts)
+  byte next= (cap_head + 1) & CAPTURE_MASK;
+  if (next == cap_tail) {
+    // ring buffer full: the edge is lost
+    cap_lost= true;
+    return;
+  }
+  cap_edge[cap_head]= edge;
+  cap_head= next;
+}
+//*********************************************************************************************************************************
+void capture_begin(byte radio_module)
+{
+  // ------------------------- //
+  // 0.5.1 Capture Begin / End //
+  // ------------------------- //
+  // take over Timer1 (normal mode, prescaler 8) and enable the edge interrupt of the selected radio module
+  cap_tccr1a= TCCR1A;
+  cap_tccr1b= TCCR1B;
+  noInterrupts();
+  TCCR1A= 0;
+  TCCR1B= _BV(CS11);
+  TCNT1=  0;
+  cap_overflow_count= 0;
+  cap_head= 0;
+  cap_tail= 0;
+  cap_lost= false;
+  cap_replay= false;
+  dual_module= 0;
+  dual_started= false;
+  TIFR1=  _BV(TOV1);
+  TIMSK1= _BV(TOIE1);
+  cap_level= cap_source(radio_module);
+  interrupts();
+  cap_pos= cap_now();
+}
+
+byte cap_source(byte radio_module)
+{
+  // enable the edge interrupt of a radio module (interrupts disabled, Timer1 running)
+  // returns the current level of its DIO2 pin
+  byte level;
+  if (radio_module == RM_1) {
+    // input capture on pin 8 (ICP1): capture the edge leaving the current level
+    level= ((RFM69_1_DIO2_PIN & RFM69_1_DIO2_MASK) == RFM69_1_DIO2_MASK) ? HIGH : LOW;
+    if (level == LOW) TCCR1B|= _BV(ICES1);
+    else TCCR1B&= ~_BV(ICES1);
+    TIFR1=   _BV(ICF1);
+    TIMSK1|= _BV(ICIE1);
+  } else {
+    // pin change interrupt on pin 6 (PCINT22)
+    level= ((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_2_DIO2_MASK) ? HIGH : LOW;
+    cap_isr_level= level;
+    PCMSK2|= _BV(PCINT22);
+    PCIFR=   _BV(PCIF2);
+    PCICR|=  _BV(PCIE2);
+  }
+  return level;
+}
+//*********************************************************************************************************************************
+void capture_end()
+{
+  // disable the edge interrupts and give Timer1 back to the Arduino core
+  noInterrupts();
+  TIMSK1= 0;
+  PCMSK2&= ~_BV(PCINT22);
+  PCICR&=  ~_BV(PCIE2);
+  TCCR1A= cap_tccr1a;
+  TCCR1B= cap_tccr1b;
+  cap_replay= false;
+  dual_module= 0;
+  dual_started= false;
+  interrupts();
+}
+//*********************************************************************************************************************************
+ISR(TIMER1_OVF_vect)
+{
+  // ------------------------ //
+  // 0.5.2 Capture Interrupts //
+  // ------------------------ //
+  cap_overflow_count++;
+}
+
+ISR(TIMER1_CAPT_vect)
+{
+  // RM_1: edge on ICP1, the timestamp has been latched into ICR1
+  unsigned int t= ICR1;
+  unsigned int ovf= cap_overflow_count;
+  byte level;
+  // a rising edge has been captured -> HIGH
+  level= (TCCR1B & _BV(ICES1)) ? HIGH : LOW;
+  // capture the opposite edge next (changing the edge requires clearing ICF1)
+  TCCR1B^= _BV(ICES1);
+  TIFR1=   _BV(ICF1);
+  if ((TIFR1 & _BV(TOV1)) && (t < 0x8000)) ovf++;
+  if (dual_module == RM_1) dual_push(((((unsigned long)ovf << 16) | t) & ~1UL) | level);
+  else cap_push(((((unsigned long)ovf << 16) | t) & ~1UL) | level);
+}
+
+ISR(PCINT2_vect)
+{
+  // RM_2: pin change on pin 6
+  unsigned int t= TCNT1;
+  unsigned int ovf= cap_overflow_count;
+  byte level;
+  level= ((RFM69_2_DIO2_PIN & RFM69_2_DIO2_MASK) == RFM69_2_DIO2_MASK) ? HIGH : LOW;
+  // a bounce shorter than the interrupt latency shows no level change
+  if (level == cap_isr_level) return;
+  cap_isr_level= level;
+  if ((TIFR1 & _BV(TOV1)) && (t < 0x8000)) ovf++;
+  if (dual_module == RM_2) dual_push(((((unsigned long)ovf << 16) | t) & ~1UL) | level);
+  else cap_push(((((unsigned long)ovf << 16) | t) & ~1UL) | level);
+}
+//*********************************************************************************************************************************
+inline bool cap_peek(unsigned long &edge)
+{
+  // the next captured edge (timestamp, LSB: level after the edge), false if none is pending
+  byte e_ind;
+  uint16_t e;
+  if (cap_replay) {
+    e_ind= dual_tail;
+    if (e_ind == dual_head) return false;
+    e= dual_edge[e_ind];
+    edge= ((dual_base + DUAL_DELTA(e)) & ~1UL) | (e & 1);
+    return true;
+  }
+  if (cap_tail == cap_head) return false;
+  edge= cap_edge[cap_tail];
+  return true;
+}
+
+inline void cap_pop(unsigned long edge)
+{
+  // the edge returned by cap_peek has been consumed
+  if (cap_replay) {
+    dual_base= edge & ~1UL;
+    dual_tail++;
+  } else cap_tail= (cap_tail + 1) & CAPTURE_MASK;
+}
+//*********************************************************************************************************************************
+byte cap_wait(byte level, unsigned int limit, unsigned int &elapsed)
+{
+  // ------------------ //
+  // 0.5.3 Capture Wait //
+  // ------------------ //
+  // the capture counterpart of a poll loop "while (pin == level) if (++temp_duration > limit) ..."
+  // wait as long as the accounted signal keeps its level, at most limit ticks after cap_pos
+  // return codes:
+  // CAP_EDGE    : the level has ended after elapsed ticks (cap_pos and cap_level move to the edge)
+  // CAP_TIMEOUT : the level lasts longer than limit (elapsed= limit + 1, cap_pos moves accordingly)
+  // (cap_replay: the edges are read from the dual edges)
+  unsigned long edge;
+  unsigned long delta;
+
+  if (cap_level != level) {
+    // the level has already ended
+    elapsed= 0;
+    return CAP_EDGE;
+  }
+  while (true) {
+    if (cap_peek(edge)) {
+      if ((byte)(edge & 1) == cap_level) {
+        // no level change (edge pair lost): skip
+        cap_pop(edge);
+        continue;
+      }
+      delta= (edge & ~1UL) - cap_pos;
+      // the edge may precede cap_pos by the timestamp LSB
+      if ((long)delta < 0) delta= 0;
+      if (delta > limit) break;
+      // the level has ended
+      cap_pop(edge);
+      cap_pos+= delta;
+      cap_level= (byte)(edge & 1);
+      elapsed= delta;
+      return CAP_EDGE;
+    }
+    // no pending edge: the level is still going on
+    if ((cap_now() - cap_pos) > limit) break;
+  }
+  elapsed= limit + 1;
+  cap_pos+= elapsed;
+  return CAP_TIMEOUT;
+}
+//******************************* begin cap_loop_while_high ************************************************************************
+byte cap_loop_while_high(unsigned int &duration_high, unsigned long &duration_low, byte &strength_low) 
+{
+  // ------------------------- //
+  // 0.5.4 CAP LOOP WHILE HIGH //
+  // ------------------------- //
+  // same interface and debouncing as poll_loop_while_high, replayed on the captured edges
+  // durations are counted in ticks, no lost cycles have to be compensated
+  // return codes:
+  // RRC_1 : end of HIGH
+  // RRC_3 : overflow on HIGH (duration_high >= CEIL_UI)
+  // RRC_4 : excessive bouncing on HIGH (or lost edges)
+
+      unsigned int  accumulated_duration;   // accumulated duration while bouncing
+      unsigned int  temp_duration;          // temp duration 
+
+      duration_low= 0;
+      strength_low= 0;           
+      // begin HIGH-loop
+      while(true) {   
+        // continue after a drop ( <= TRIGGER_LOW )
+        //      AND a long HIGH  ( > SPIKE_HIGH )
+        if (cap_lost) return RRC_4;                                              // lost edges            -------> return RRC_4
+        if (cap_wait(HIGH, CEIL_UI - 1, temp_duration) == CAP_TIMEOUT) return RRC_3;  // high overflow    -------> return RRC_3
+        duration_high+= temp_duration;
+        // potential low detected
+
+        // bouncing loop : loop as long as the drop duration <= TRIGGER_LOW
+        accumulated_duration= 0;
+        do { 
+          // is this a genuine LOW or just a drop?
+          if (cap_wait(LOW, TRIGGER_LOW, temp_duration) == CAP_TIMEOUT) {goto EOB;}  // End-Of-Bouncing  -------> EOB 
+          accumulated_duration+= temp_duration;         
+          // a drop has been detected
+          // is the following HIGH a genuine HIGH or just a spike?
+          if (cap_wait(HIGH, SPIKE_HIGH, temp_duration) == CAP_TIMEOUT) {goto CWH;}  // Continue-With-High -----> CWH  
+          accumulated_duration+= temp_duration;          
+          // after a drop followed a spike
+        } while (accumulated_duration < CEIL_UI);  
+        // excessive bouncing on HIGH
+        return RRC_4;                                                            // too much bouncing     -------> return RRC_4
+
+EOB:    // End-Of-Bouncing
+        // get signal_strength (the LOW goes on being timestamped meanwhile; replay: not measurable afterwards)
+        // +++++++++++++++++++
+        strength_low= (!cap_replay && strength_due()) ? signal_strength() : strength_default_low; 
+        duration_low= accumulated_duration + temp_duration;
+        // end of HIGH
+        return RRC_1;                                                            // end of High           -------> return RRC_1 
+
+CWH:    // continue with high     
+        duration_high+= accumulated_duration + temp_duration; 
+        // overflow on HIGH
+        if (duration_high >= CEIL_UI) return RRC_3;                              // high overflow         -------> return RRC_3
+      }  
+      // end of loop on HIGH  (while(true))                                      // continue high loop
+}
+//******************************* end cap_loop_while_high **************************************************************************
+
+//******************************* begin cap_loop_while_low *************************************************************************
+byte cap_loop_while_low(unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit) 
+{
+  // ------------------------ //
+  // 0.5.5 CAP LOOP WHILE LOW //
+  // ------------------------ //
+  // same interface and debouncing as poll_loop_while_low, replayed on the captured edges
+  // return code:
+  // RRC_0 : end of Reception: (duration_low >= duration_low_limit, cf. recorder: INFINITE_PAUSE or LONG_PAUSE)
+  // RRC_1 : end of LOW
+  // RRC_2 : excessive bouncing on LOW (or lost edges)
+
+     unsigned int accumulated_duration;      // accumulated duration while bouncing
+     unsigned int temp_duration;             // temp duration 
+
+      duration_high= 0;
+      strength_high= 0;           
+      // begin LOW-loop
+      while(true) {       
+        // continue after a spike  ( <= TRIGGER_HIGH ) 
+        //          AND a long LOW ( >  DROP_LOW ) 
+        if (cap_lost) return RRC_2;                                              // lost edges            -------> return RRC_2
+        while (cap_wait(LOW, CEIL_UI - 1, temp_duration) == CAP_TIMEOUT) {
+          duration_low+= temp_duration;
+          if (duration_low >= duration_low_limit) {
+            duration_low= min(duration_low_limit, CEIL_UI_X2);
+            strength_high= 0;
+            // end of Reception           
+            return RRC_0;                                                        // End-Of-Reception      -------> return RRC_0
+          }
+        }        
+        duration_low+= temp_duration;
+        // potential high detected
+
+        // bouncing loop : loop as long as the spike duration <= TRIGGER_HIGH
+        accumulated_duration= 0;
+        do {  
+          // is this a genuine HIGH or just a spike?
+          if (cap_wait(HIGH, TRIGGER_HIGH, temp_duration) == CAP_TIMEOUT) {goto EOB;}  // End-Of-Bouncing -------> EOB
+          accumulated_duration+= temp_duration; 
+          // a spike has been detected
+          // is the following LOW a genuine LOW or just a drop?
+          if (cap_wait(LOW, DROP_LOW, temp_duration) == CAP_TIMEOUT) {goto CWL;}       // Continue-With-Low -----> CWL 
+          accumulated_duration+= temp_duration; 
+          // after a spike followed a drop
+        } while (accumulated_duration <= CEIL_UI);                               // continue bouncing loop  
+        // excessive bouncing on LOW
+        return RRC_2;                                                            // too much bouncing     -------> return RRC_2
+
+EOB:    // End-Of-Bouncing
+        // get signal_strength (the HIGH goes on being timestamped meanwhile; replay: not measurable afterwards)
+        // +++++++++++++++++++
+        strength_high= (!cap_replay && strength_due()) ? signal_strength() : strength_default_high;       
+        duration_high= accumulated_duration + temp_duration; 
+        // end of LOW
+        return RRC_1;                                                            // end of LOW            -------> return RRC_1 
+
+CWL:    // Continue-With-Low
+        duration_low+= accumulated_duration + temp_duration; 
+        if (duration_low >= duration_low_limit) {
+          duration_low= min(duration_low_limit, CEIL_UI_X2);
+          strength_high= 0;           
+          // end of Reception           
+          return RRC_0;                                                          // End-Of-Reception      -------> return RRC_0
+        }
+      }                                                                          // continue low loop
+      // end of loop on LOW (while(true))
+}
+//******************************* end cap_loop_while_low **************************************************************************
+
+//*********************************************************************************************************************************
+void capture_other_begin(byte radio_module, unsigned long pause, uint16_t *buffer, byte capacity)
+{
+  // ---------------------------- //
+  // 0.5.6 Dual Capture (RM_DUAL) //
+  // ---------------------------- //
+  // timestamp the edges of the other radio module as well (after capture_begin of the active one)
+  // radio_module  // I : the other radio module
+  // pause         // I : its LOW duration so far [ticks] (0: HIGH, cf. dual_wait_start)
+  // buffer        // I : a free slot, capacity dual edges
+  unsigned long t= cap_now();
+  noInterrupts();
+  dual_edge=     buffer;
+  dual_capacity= capacity;
+  dual_head=     0;
+  dual_tail=     0;
+  dual_started=  false;
+  dual_prev=     (t - pause) & ~1UL;
+  dual_module=   radio_module;
+  cap_source(radio_module);
+  interrupts();
+}
+//*********************************************************************************************************************************
+void dual_push(unsigned long edge)
+{
+  // add an edge of the other radio module to the dual edges (called by the interrupts)
+  unsigned long delta= (edge & ~1UL) - dual_prev;
+  byte     level= edge & 1;
+  uint16_t e;
+
+  if (!cap_replay && (level == HIGH) && (delta >= LONG_PAUSE)) {
+    // a HIGH after a long pause: a reception may start, the older edges are dropped
+    // (the replay starts 2 ticks in front of the first edge, cf. capture_replay)
+    dual_prev=    edge & ~1UL;
+    dual_base=    dual_prev - 2;
+    dual_edge[0]= 2 | level;
+    dual_head=    1;
+    dual_tail=    0;
+    dual_started= true;
+    return;
+  }
+  if (delta < 0x8000) e= delta & 0x7FFE;
+  else e= 0x8000 | ((delta < (0x4000UL << 6)) ? ((delta >> 5) & 0x7FFE) : 0x7FFE);
+  // the reconstructed timestamp: the rounding of the long deltas does not accumulate
+  dual_prev+= DUAL_DELTA(e);
+  if (dual_head >= dual_capacity) {
+    // buffer full: the replay is aborted as lost edges, a reception not yet replayed is dropped
+    if (cap_replay) cap_lost= true;
+    else dual_started= false;
+    return;
+  }
+  dual_edge[dual_head]= e | level;
+  dual_head++;
+}
+//*********************************************************************************************************************************
+bool capture_hand_over(byte radio_module)
+{
+  // the reception of radio_module has ended: if the other radio module has started one meanwhile,
+  // stop the edges of radio_module only, the other one goes on being captured (returns true, replayed next)
+  if (!dual_started) return false;
+  noInterrupts();
+  if (radio_module == RM_1) TIMSK1&= ~_BV(ICIE1);
+  else {
+    PCMSK2&= ~_BV(PCINT22);
+    PCICR&=  ~_BV(PCIE2);
+  }
+  interrupts();
+  return true;
+}
+//*********************************************************************************************************************************
+byte capture_pending()
+{
+  // radio module of a reception handed over by capture_hand_over (0: none)
+  if (dual_module == 0) return 0;
+  if (dual_started) return dual_module;
+  // dropped meanwhile (buffer full)
+  capture_end();
+  return 0;
+}
+//*********************************************************************************************************************************
+void capture_replay()
+{
+  // cap_wait reads the dual edges from now on: the accounted signal is the LOW just in front of the first edge
+  // (the long pause has been checked by dual_push), the edges still coming in are appended (cap_lost: buffer full)
+  noInterrupts();
+  cap_replay= true;
+  cap_lost=   false;
+  cap_pos=    dual_base;
+  cap_level=  LOW;
+  interrupts();
+}
+#endif
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#if (PROFILING == CYCLE_PROFILING)
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// ************ //
+// 0.6 Profiler //  cycle counts per stage (cf. profiler.h: STAGE_MARK)
+// ************ //
+// 0.6.1 Profile Begin / Reset
+// 0.6.2 Profile Mark
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Timer1 counts the CPU cycles (prescaler 1, 1 tick = 62.5 ns at 16 MHz), the overflow interrupt of the
+  capture backend (0.5.2) extends the count to 32 bits: cap_now() wraps after 268 s.
+  A stage is closed by the next STAGE_MARK, its cycles include the interrupts (Timer0, Timer1) and,
+  for the recorder stages, the calls of signal_strength() that are also accounted separately.
+*/
+
+//*********************************************************************************************************************************
+void profile_begin()
+{
+  // --------------------------- //
+  // 0.6.1 Profile Begin / Reset //
+  // --------------------------- //
+  // take over Timer1: normal mode, prescaler 1, overflow interrupt
+  noInterrupts();
+  TCCR1A= 0;
+  TCCR1B= _BV(CS10);
+  TCNT1=  0;
+  cap_overflow_count= 0;
+  TIFR1=  _BV(TOV1);
+  TIMSK1= _BV(TOIE1);
+  interrupts();
+  profile_stage= STAGE_NONE;
+  profile_reset();
+}
+
+void profile_reset()
+{
+  // clear the accumulated cycles (the stage in progress goes on)
+  memset(&profile, 0, sizeof(profile));
+}
+//*********************************************************************************************************************************
+void profile_mark(uint8_t stage)
+{
+  // ------------------ //
+  // 0.6.2 Profile Mark //
+  // ------------------ //
+  // close the stage in progress and open the next one
+  unsigned long now= cap_now();
+  if (profile_stage < STAGE_COUNT) {
+    profile.cycles[profile_stage]+= now - profile_start;
+    profile.count[profile_stage]++;
+  }
+  profile_stage= stage;
+  profile_start= now;
+}
+//******************************* end profiler ************************************************************************************
+#endif
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#if (IDLE_MODE == LISTEN_IDLE)
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// *************** //
+// 0.7 Listen Idle //  duty-cycled RX between the receptions, the MCU sleeps until the radio detects a signal
+// *************** //
+// 0.7.1 Listen Wait
+// 0.7.2 Listen Interrupts
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  The busy idle keeps the radio in RX (~ 16 mA) and the MCU polling DIO2 (~ 7 mA) while waiting for a start trigger.
+  The listen mode of the RFM69 cycles on its own between an idle period (RC oscillator only, LISTEN_IDLE_COEF x 4.1 ms)
+  and an RX window (LISTEN_RX_COEF x 64 us). An RSSI above the threshold ends the listen mode: the radio stays in RX
+  (ListenEnd 00) and raises RssiIrq on DIO0, whose pin change wakes the MCU from power-down.
+  - a start is detected up to one idle period late, plus the wake latency: the oscillator start-up (LISTEN_STARTUP_US)
+    and leaving the listen mode (listen_stats.wake_latency); the recorder polls DIO2 right after,
+    the lost part of a transmission is at most the first frame, the recorder records the following repetitions
+  - the quiet period before the wake replaces the long pause of the start criteria (cf. recorder 1.2)
+  - Timer0 stops in power-down: millis() counts the awake time only, the watchdog counts the sleep time
+    (LISTEN_TICK_MS per tick, the tick in progress at the wake is not counted)
+  - the pin change interrupt PCINT2 serves pins 2, 3 and 6: its handler is the one of the capture backend (0.5.2),
+    which ignores a change of pin 2 or 3 (no level change of pin 6)
+  - DIO0 mapping 10 of the continuous mode in RX (RFM69 datasheet, table 22): Rssi
+*/
+
+#if   (LISTEN_TICK_MS == 250)
+#define LISTEN_TICK_WDP      (_BV(WDP2))
+#elif (LISTEN_TICK_MS == 1000)
+#define LISTEN_TICK_WDP      (_BV(WDP2) | _BV(WDP1))
+#elif (LISTEN_TICK_MS == 8000)
+#define LISTEN_TICK_WDP      (_BV(WDP3) | _BV(WDP0))
+#else
+#error "LISTEN_TICK_MS must be 250, 1000 or 8000"
+#endif
+
+//*********************************************************************************************************************************
+void listen_wait(byte sensitivity)
+{
+  // ----------------- //
+  // 0.7.1 Listen Wait //
+  // ----------------- //
+  // sensitivity   // I : min strength that ends the listen mode (rp.radio_sensitivity, cf. recorder 1.2)
+  // the selected radio module is configured by the recorder (frequency, threshold, power);
+  // returns with the radio in RX and a signal above the sensitivity (DIO0 HIGH)
+  byte dio0_mask;                 // DIO0 pin of the selected radio module (RM_1 and RM_2: both on PIND)
+  byte adcsra;
+  unsigned long wake_us;
+  unsigned int  latency;
+
+  dio0_mask= (_slaveSelectPin == SS1) ? RFM69_1_DIO0_MASK : RFM69_2_DIO0_MASK;
+  // radio: RSSI threshold (strength= 128 - raw rssi / 2, cf. 0.4.3.1), listen timing, DIO0 -> Rssi
+  set_mode(RF69_MODE_STANDBY);
+  RFM69writeReg(REG_RSSITHRESH, 2 * (128 - sensitivity));
+  RFM69writeReg(REG_LISTEN1, RF_LISTEN1_RESOL_4100 | RF_LISTEN1_CRITERIA_RSSI | RF_LISTEN1_END_00);
+  RFM69writeReg(REG_LISTEN2, LISTEN_IDLE_COEF);
+  RFM69writeReg(REG_LISTEN3, LISTEN_RX_COEF);
+  RFM69writeReg(REG_DIOMAPPING1, (RFM69readReg(REG_DIOMAPPING1) & 0x3F) | RF_DIOMAPPING1_DIO0_10);
+  set_mode(RF69_MODE_LISTEN);
+  // MCU: the UART and the ADC stop in power-down
+  Serial.flush();
+  adcsra= ADCSRA;
+  ADCSRA&= ~_BV(ADEN);
+  noInterrupts();
+  // pin change interrupt of DIO0, watchdog in interrupt mode (no reset)
+  PCMSK2|= dio0_mask;
+  PCIFR=   _BV(PCIF2);
+  PCICR|=  _BV(PCIE2);
+  wdt_reset();
+  WDTCSR=  _BV(WDCE) | _BV(WDE);
+  WDTCSR=  _BV(WDIE) | LISTEN_TICK_WDP;
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+  while ((RFM69_1_DIO0_PIN & dio0_mask) != dio0_mask) {
+    // sleep (the instruction after sei is executed before a pending interrupt: no wake is missed)
+    sleep_enable();
+    sleep_bod_disable();
+    interrupts();
+    sleep_cpu();
+    sleep_disable();
+    // woken by DIO0 or by the watchdog tick
+    noInterrupts();
+  }
+  wdt_disable();
+  PCMSK2&= ~dio0_mask;
+  if ((PCMSK2 & _BV(PCINT22)) == 0) PCICR&= ~_BV(PCIE2);
+  interrupts();
+  wake_us= micros();
+  ADCSRA= adcsra;
+  // radio: the listen mode has ended in RX, abort it (ListenOn= 0 and ListenAbort= 1 in the same write)
+  RFM69writeReg(REG_OPMODE, RF_OPMODE_SEQUENCER_ON | RF_OPMODE_LISTEN_OFF | RF_OPMODE_LISTENABORT | RF_OPMODE_RECEIVER);
+  RFM69writeReg(REG_OPMODE, RF_OPMODE_SEQUENCER_ON | RF_OPMODE_LISTEN_OFF | RF_OPMODE_RECEIVER);
+  _mode= RF69_MODE_RX;
+  // statistics
+  latency= micros() - wake_us;
+  listen_stats.wake_count++;
+  listen_stats.wake_latency= latency;
+  if (latency > listen_stats.wake_latency_max) listen_stats.wake_latency_max= latency;
+}
+//*********************************************************************************************************************************
+ISR(WDT_vect)
+{
+  // ----------------------- //
+  // 0.7.2 Listen Interrupts //
+  // ----------------------- //
+  // watchdog tick: the MCU sleeps on (cf. listen_wait)
+  listen_stats.sleep_ticks++;
+}
+//******************************* end listen idle *********************************************************************************
+#endif
@@ -11,15 +11,21 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
 
   =============================
   = Radio Library (Interface) =
   =============================
 */
 
+#include "durations.h"   // duration_seq: storage of the signal durations (DURATION_STORAGE)
+
 // radio_modules
 #define RM_1  1   // radio module 1
 #define RM_2  2   // radio module 2
+#define RM_DUAL 3 // both radio modules: the first start trigger selects the band (cf. dual_wait_start),
+                  // CAPTURE_BACKEND: a reception of the other band meanwhile is buffered and replayed (rp.edge_buffer)
 #define SS1  SS   // slave select RM_1
 #define SS2   5   // slave select RM_2
 
@@ -28,7 +34,54 @@
 #define RF69_MODE_SYNTH       2         // PLL ON
 #define RF69_MODE_RX          3         // RX MODE
 #define RF69_MODE_TX          4         // TX MODE
-#define RF69_MODE_LISTEN      5         // LISTEN ON 
+#define RF69_MODE_LISTEN      5         // LISTEN ON
+
+// recorder backends
+#define POLL_BACKEND          0         // busy-poll loops on DIO2, durations in poll cycles (poll_loop_while_*)
+#define CAPTURE_BACKEND       1         // Timer1 timestamps of DIO2 edges, durations in timer ticks (cap_loop_while_*)
+#define RECORDER_BACKEND      POLL_BACKEND
+
+// signal strength (RSSI) sampling
+#define STRENGTH_SAMPLES      4         // raw rssi measurements averaged per strength (1, 2 or 4)
+#define SAMPLE_EVERY_SIGNAL   0         // the strength of every signal is sampled (reliability check of each signal)
+#define SAMPLE_INTERVAL       1         // after WARM_UP: only every STRENGTH_INTERVAL-th signal (collision check)
+#define STRENGTH_SAMPLING     SAMPLE_EVERY_SIGNAL
+#define STRENGTH_INTERVAL     8         // SAMPLE_INTERVAL: signals per strength sample (the others get the reference strength)
+
+// OOK threshold (REG_OOKFIX, in units of strength: 2 x dB)
+#define FIXED_THRESHOLD       0         // 2 * rp.radio_sensitivity during the whole reception
+#define ADAPTED_THRESHOLD     1         // after WARM_UP: ref_strength_high + ref_strength_low (midway between the levels)
+#define TRACKED_THRESHOLD     2         // adapted, then following the exponential averages of the reliable strengths
+#define OOK_THRESHOLD         FIXED_THRESHOLD
+#define THRESHOLD_SHIFT       3         // TRACKED_THRESHOLD: weight of a new strength = 1 / 2^THRESHOLD_SHIFT
+#define THRESHOLD_HYSTERESIS  2         // TRACKED_THRESHOLD: min change of the threshold that is written to the radio
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+#define LC_THRESHOLD          0         // the edges are timestamped meanwhile
+#else
+#define LC_THRESHOLD          threshold_lost  // lost poll cycles of set_threshold (SPI write, measured by strength_calibrate)
+#endif
+// streaming: the time spent in rp.stream is measured (micros) and added to the signal in progress like LC_THRESHOLD
+// (poll backend); a signal that ends meanwhile is merged into the next one: keep the consumer short
+
+// collisions: reliable HIGHs outside ref_strength_high +- DELTA_STRENGTH (a second transmitter, or a signal loss)
+#define COLLISION_ABORT       0         // more than three consecutive collisions end the reception (RRC_14)
+#define COLLISION_SEPARATE    1         // the reception goes on, each HIGH is tagged with its strength bucket (rs.transmitter)
+                                        // and the categorizer splits the trace per transmitter (cf. categorizer.cpp: separator)
+#define COLLISION_MODE        COLLISION_ABORT
+
+// idle mode: waiting for the start trigger while no frame is pending (rp.idle_limit == INFINITE_PAUSE)
+#define BUSY_IDLE             0         // the radio in RX, the MCU polls DIO2 for the long pause and the start trigger
+#define LISTEN_IDLE           1         // the radio in listen mode, the MCU sleeps until the RSSI interrupt (DIO0) wakes it
+#define IDLE_MODE             BUSY_IDLE
+#define LISTEN_IDLE_COEF      5         // LISTEN_IDLE: idle period = 5 x 4.1 ms (a start is detected up to 20.5 ms late)
+#define LISTEN_RX_COEF       16         // LISTEN_IDLE: RX window   = 16 x 64 us (RSSI detection, ~ 5 % duty cycle)
+#define LISTEN_TICK_MS     1000         // LISTEN_IDLE: watchdog period counting the sleep time (WDT oscillator: +- 10 %)
+#define LISTEN_STARTUP_US  1000         // LISTEN_IDLE: oscillator start-up after power-down (16K CK, fuses of the Pro Mini)
+// current consumption [uA] of the listen statistics (datasheet typical values, the board adds regulator and LED)
+#define CURRENT_RADIO_RX  16000         // RFM69 RX
+#define CURRENT_RADIO_IDLE    2         // RFM69 idle of the listen mode (sleep, RC oscillator on)
+#define CURRENT_MCU_ACTIVE 7000         // ATmega328P active
+#define CURRENT_MCU_SLEEP     5         // ATmega328P power-down, watchdog on
 
 // pauses (long LOW durations)
 #define INFINITE_PAUSE 4294967000UL     // a "never ending" pause that preceds the start pulse   
@@ -59,8 +112,10 @@
 #define RRC_11 11  // less than three consecutive reliable signals (detected on LOW)
 #define RRC_12 12  // more than three consecutive unreliable signals (detected on HIGH)
 #define RRC_13 13  // more than three consecutive unreliable signals (detected on LOW)
-#define RRC_14 14  // more than three (reliable) consecutive collisions, or signal attenuation/loss
+#define RRC_14 14  // more than three (reliable) consecutive collisions, or signal attenuation/loss (COLLISION_ABORT)
 #define RRC_15 16  // program error
+#define RRC_16 17  // idle timeout: no start trigger within rp.idle_limit (pipeline: process the filled slots)
+#define RRC_17 18  // streaming: re-clustering requested by rp.stream (the buffer holds the most recent values)
                                           
   // recorded signals : rs
   // ================
@@ -69,47 +124,107 @@
   // [even indices]: LOW-durations  / LOW-strengths 
   typedef struct 
   {
-    unsigned int *duration;   // signal_duration[NV + 5]      : (measured signal duration [polls]) / 2
+    duration_seq duration;    // signal_duration[NV + 5]      : (measured signal duration [polls]) / 2 (cf. durations.h)
     byte         *strength;   // signal_strength[WARM_UP + 1] : signal strength [dBm]  (WARM_UP >= 8 !!!)
     int          count;       // number of recorded signals (index of the last LOW before end-record)
     byte ref_strength_high;   // reference= (rs.strength[5] + rs.strength[7]) >> 1
     byte ref_strength_low;    // reference= (rs.strength[6] + rs.strength[8]) >> 1
     int  unreliable_count;    // total number of unreliable signals
+    byte radio_module;        // radio module that recorded the signals (RM_1 or RM_2)
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+    byte *transmitter;        // transmitter[TRANSMITTER_DIM(NV)]: packed transmitter tags of the HIGHs (cf. durations.h)
+                              // 0: within ref_strength_high +- DELTA_STRENGTH, 1: other transmitter
+    int  collision_count;     // number of HIGHs tagged as other transmitter (0: nothing to separate)
+    byte other_strength;      // mean strength of the HIGHs tagged as other transmitter
+#endif
   } recorded_signals;
   
   // receiver parameters : rp
   // ===================
   typedef struct 
   {
-    byte radio_module;        // RM_1 or RM_2 depending on frequency to receive
-    long radio_frequency;     // frequency
+    byte radio_module;        // RM_1 or RM_2 depending on frequency to receive (RM_DUAL: both)
+    long radio_frequency;     // frequency (RM_DUAL: frequency of RM_1)
+    long radio_frequency_2;   // RM_DUAL: frequency of RM_2
     byte radio_sensitivity;   // min strength to start reception (REG_OOKFIX)
     int  max_length;          // limitation on the number of signals to receive (count < limit)
+    unsigned long idle_limit; // LOW "timeout" while waiting for the start trigger (INFINITE_PAUSE: wait forever)
+    bool (*stream)(unsigned int duration, byte level);
+                              // streaming: consumer of each value recorded after WARM_UP, returns true to stop (RRC_17)
+                              // the buffer becomes a ring of max_length values (NULL: reception ends at max_length)
+    uint16_t *edge_buffer;    // RM_DUAL, CAPTURE_BACKEND: a free slot buffering the edges of the other band during a
+    byte edge_capacity;       // reception, which is then replayed into it (capacity in edges; NULL: the other band is deaf)
   } receiver_parameters;
   
   byte recorder(receiver_parameters rp, recorded_signals &rs);
 
-  // Poll Selected Radio (Wrapper)
+  // listen statistics (IDLE_MODE == LISTEN_IDLE) : listen_stats
+  // =================
+  // accumulated since the start (the awake time is millis(): Timer0 stops in power-down)
+  typedef struct
+  {
+    unsigned long wake_count;       // wakes by the RSSI interrupt (DIO0)
+    unsigned long false_wakes;      // of which without a start trigger within LONG_PAUSE (noise, cf. recorder 1.2)
+    unsigned long sleep_ticks;      // watchdog periods slept (LISTEN_TICK_MS each)
+    unsigned int  wake_latency;     // last wake: from the wake-up to the radio back in RX [us]
+    unsigned int  wake_latency_max; // maximal wake latency [us]
+  } listen_statistics;
+  extern listen_statistics listen_stats;
+  // Poll Selected Radio (Kernels)
   // ===================
-  byte     loop_while_high  (unsigned int &duration_high, unsigned long &duration_low, byte &strength_low);
-  byte     loop_while_low   (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit);  
+  // set once per reception by select_radio: the poll kernel of the active radio module (cf. radio_lib.cpp: 0.2)
+  // or the capture backend
+  typedef byte (*loop_high_kernel) (unsigned int &duration_high, unsigned long &duration_low, byte &strength_low);
+  typedef byte (*loop_low_kernel)  (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit);
+  extern loop_high_kernel loop_while_high;
+  extern loop_low_kernel  loop_while_low;
+  void     select_kernel    (byte radio_module);
+  // RM_DUAL: wait for the first start trigger of either radio module (returns RM_1, RM_2 or 0: idle timeout)
+  byte     dual_wait_start  (unsigned int &duration_high, byte &strength_high, unsigned long &pause_other, unsigned long duration_low_limit);
 
   // Helper
   // ======
-  byte rm1_loop_while_high  (unsigned int &duration_high, unsigned long &duration_low, byte &strength_low);
-  byte rm1_loop_while_low   (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit);  
-  byte rm2_loop_while_high  (unsigned int &duration_high, unsigned long &duration_low, byte &strength_low);
-  byte rm2_loop_while_low   (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit);
+  // streaming: rotate the ring so that the oldest value is at index 1
+  void ring_unwrap          (recorded_signals &rs, int ind, int ring_length);
+  // streaming: pass a recorded value to rp.stream, lost: poll cycles spent there (0 with the capture backend)
+  bool stream_value         (const receiver_parameters &rp, unsigned int val, byte level, unsigned int &lost);
+
+  // Capture Backend (RECORDER_BACKEND == CAPTURE_BACKEND)
+  // ===============
+  // start / stop the edge timestamping of the DIO2 pin of the selected radio module
+  void capture_begin(byte radio_module);
+  void capture_end();
+  // RM_DUAL: capture the other radio module as well, hand its reception over, replay it (cf. radio_lib.cpp: 0.5.6)
+  void capture_other_begin(byte radio_module, unsigned long pause, uint16_t *buffer, byte capacity);
+  bool capture_hand_over(byte radio_module);
+  byte capture_pending();
+  void capture_replay();
+  byte cap_loop_while_high  (unsigned int &duration_high, unsigned long &duration_low, byte &strength_low);
+  byte cap_loop_while_low   (unsigned int &duration_high, unsigned long &duration_low, byte &strength_high, unsigned long duration_low_limit);
+
+  // Listen Idle (IDLE_MODE == LISTEN_IDLE)
+  // ===========
+  // sleep until the selected radio module detects a signal (RSSI above the sensitivity), the radio is left in RX
+  void listen_wait(byte sensitivity);
 
   // initiate both radio modules to standby
   void init_radio();
   // setup SPI for both radio modules and set the 
   // _slaveSelectPin for the active radio module
   void SPI_begin(byte radio_module);
+  // set the _slaveSelectPin and the kernel for the active radio module
+  void select_radio(byte radio_module);
   // get the strength of a signal
   inline byte signal_strength();
+  // sample the strength of every interval-th signal only, the others get the default strengths
+  void strength_schedule(byte interval, byte default_high, byte default_low);
+  // measure the poll cycles lost in signal_strength and set_threshold (called by init_radio)
+  void strength_calibrate();
+  extern unsigned int threshold_lost;
   // wrappers: set ... of the active radio module
   void set_mode(byte mode);
   void set_frequency(long frequency);
   void set_threshold(byte threshold);
   void set_power(byte power_level);
+  // scan: tune the radio module and return the maximal strength of a few measurements
+  byte channel_activity(byte radio_module, long frequency, byte samples);
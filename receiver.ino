@@ -1,19 +1,25 @@
 // !!! Arduino 1.8.8                       !!!
 // !!! Board: "Arduino Pro or Pro Mini"    !!!
 // !!! Processor: "ATmega328P (5V, 16MHz)" !!!
-// !!! SERIAL_BAUD  9600                   !!!
+// !!! SERIAL_BAUD  9600 (default)         !!!
 // !!! Radios: see "radio_lib.cpp"         !!!
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 /*
   reception parameters (rp)
   --------------------
-  output_option           1: output with trace; 0: output without trace 
-  rp.radio_module         1: RM1 (433MHz);      2: RM2 (868MHz)
-  rp.radio_frequency      in function of the selected radio module
+  output_option           1: output with trace; 0: output without trace; 2: output with binary trace;
+                          3: output with compressed trace; 4: streaming (continuous reception, serial_baud >= 115200)
+  rp.radio_module         1: RM1 (433MHz);      2: RM2 (868MHz);      3: both (dual radio, first start trigger wins)
+                          3 with the capture backend: both bands at once, a reception of the other band during one
+                          is buffered in a free slot and replayed after it (nominal strengths, cf. recorder.cpp)
+                          4: scan the channel table (frequencies and sensitivities of the table, cf. scan_channel)
+  rp.radio_frequency      in function of the selected radio module (3: frequency of RM1)
   rp.radio_sensitivity    threshold >=  ~18dBm
-  rp.max_length           cutoff length < buffer size
+  rp.max_length           cutoff length < slot size (NV_SLOT= NV / NS)
   rp_min_length           overruling length <= cutoff length
+  serial_baud             optional: baud rate after the parameter printout (e.g. 115200)
+  rp.radio_frequency_2    optional: dual radio, frequency of RM2 (default 868.240)
   
   When asked to enter the reception parameters, you may 
   copy/paste your own or one of the following parameter lines:
@@ -22,6 +28,40 @@
   1 1 433.920 30  32 32
   1 2 868.210 40  32 32
   1 2 868.970 17  32 32
+  1 3 433.864 18 200 32 9600 868.240
+  1 4 433.864 18 200 32
+
+  categorizer parameters (cp, PARAMETER_MODE == TUNABLE_PARAMETERS only, cf. categorizer.h)
+  ----------------------
+  asked for after the reception parameters; the values default to those of categorizer.h:
+  cp.border_width         border width (warm-up / cool-down) 2 .. 16         (BORDER_WIDTH)
+  cp.start_val            histogram start value                               (START_VAL)
+  cp.max_holes            tolerated empty bins within a cluster               (MAX_HOLES)
+  cp.first_hits           recorded first bin hits 1 .. 2                      (FIRST_HITS)
+  cp.min_size             minimum cluster size >= 1                           (MIN_SIZE)
+  cp.outlier_option       classifier option of the outlier separation 1 .. 7  (C_OPT_2)
+  cp.resorber_option      classifier option of the resorber 1 .. 7            (C_OPT_4)
+  e.g. the defaults:
+  8 50 1 2 3 2 4
+
+  listen idle (IDLE_MODE == LISTEN_IDLE, cf. radio_lib.h)
+  -----------
+  while no frame is pending, the radio listens duty-cycled and the MCU sleeps (not with the dual radio or the scan);
+  each processing prints the wakes, the sleep / awake times, the wake latency and the estimated current:
+  choose LISTEN_IDLE_COEF (idle period: the start is detected up to one period late) and LISTEN_RX_COEF from them
+
+  collision separation (COLLISION_MODE == COLLISION_SEPARATE, cf. radio_lib.h)
+  --------------------
+  a collision no longer ends the reception (RRC_14): the HIGHs are tagged by strength, the trace is reported as
+  recorded, then categorized per transmitter (the other transmitter first, "transmitter 2", then the reference one);
+  each sub-sequence shorter than rp_min_length is skipped
+
+  stored state (STORE_MODE == EEPROM_STORE, cf. store.h)
+  ------------
+  the parameters of the previous boot are used without the parameter wait: to enter new ones, send a character at any
+  time, it is noticed at the next return of the recorder (a reception or noise) and re-enters setup (the stored
+  parameters are the defaults, the counters and the boot count are kept); the per-channel counters are printed
+  at boot and written every STORE_PERIOD, the category cache (CATEGORY_CACHE) is seeded with the stored profiles
 */ 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 /*
@@ -37,6 +77,8 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
  
   *************************
   * OOK RAW DATA RECEIVER *
@@ -49,6 +91,13 @@
   - categorizer.cpp
   - categorizer.h
   - categorizer_lib.cpp
+  - codec.cpp
+  - codec.h
+  - profiler.h
+  - arena.h
+  - durations.h
+  - store.cpp
+  - store.h
   - recorder.cpp
   - radio_lib.cpp
   - radio_lib.h
@@ -60,12 +109,38 @@
   The following defines the interface to the TRACE if you want to run the categorizer off-line:
   - !TRACE!: start marker
   - rs.duration[1] contains the first HIGH duration (at index position 1 not zero!)
+    (LOG8_DURATIONS: the TRACE holds the decoded values, cf. durations.h)
   - rs.count is without end-record, it is the index of the last LOW
   - end-record is either a pause (x, CEIL) or a zero duration (0, 0) 
     x is the terminating HIGH duration AFTER the last LOW
   - the following records will be appended after the end of the TRACE (see reporting):  
     - checkout record   : (checksum, rs.unreliable_count)
     - end-of-data record: (-1, -1)
+
+  Binary TRACE (output_option 2): a length-prefixed frame of little-endian integers
+  - start marker  : '!' 'B'
+  - frame length  : uint16, number of bytes between the frame length and the checksum
+  - rs.count, rs.unreliable_count                  : 2 x uint16
+  - rs.ref_strength_high, rs.ref_strength_low      : 2 x byte
+  - strength count k, rs.strength[1 .. k]          : byte, k x byte
+  - rs.duration[1 .. rs.count + 2], "ending" incl. : uint16 each, reliability LSB intact
+  - checksum      : uint16, Fletcher16 of the durations (the same as in the checkout record)
+  the off-line decoder is offline/trace_reader.cpp
+
+  Compressed TRACE (output_option 3): see codec.cpp, decoded by offline/trace_reader.cpp
+  - category index plus residual, using the categories of the previous successful reception
+  - zigzag varint deltas (raw mode), as long as no categories are known
+
+  Packed categorized sequence (CATEGORIZER_OUTPUT == PACKED_OUTPUT, cf. categorizer.h): see codec.cpp,
+  decoded by offline/trace_reader.cpp (offline: benchmark -p) into the view of the sequence_printer
+
+  Structured result (CATEGORIZER_OUTPUT == RESULT_OUTPUT, cf. categorizer.h: categorizer_result): nothing is printed
+  by the categorizer, one code per position (category index, RESULT_* flags) replaces the durations of the slot,
+  a consumer (e.g. a decoder) reads it in memory; the receiver prints the counts of the flags
+
+  Decoded frames (CATEGORIZER_OUTPUT == BIT_OUTPUT, cf. categorizer.cpp: 2.5 protocol_decoder):
+  per reception the recognized protocol (PWM, PPM, Manchester) and the data levels, then per data run
+  the repeat count, the number of bits and the payload in hex (most significant bit first)
     
   rs: recorded_signals (cf. radio_lib.h)
 */
@@ -75,6 +150,10 @@
 #include <SPI.h>
 #include "radio_lib.h"  
 #include "categorizer.h"  
+#include "codec.h"
+#include "profiler.h"
+#include "arena.h"
+#include "store.h"
 
 // interaction
 #define LED            13
@@ -82,6 +161,9 @@
 
 // default values
 #define TRACE_OUTPUT               1     // 1: output with trace; 0: output without trace   
+#define BINARY_OUTPUT              2     // 2: output with binary trace (cf. binary_reporting)
+#define COMPRESSED_OUTPUT          3     // 3: output with compressed trace (cf. codec.cpp)
+#define STREAM_OUTPUT              4     // 4: streaming: values classified on the fly once categories are known
 #define RADIO_MODULE_1          RM_1     
 #define RADIO_FREQUENCY_1    433.864      
 #define RADIO_MODULE_2          RM_2     
@@ -92,9 +174,22 @@
 
 #define FRQ(x) ((long) ( x * (1<<14) ))  // floating to long conversion used for frequencies
 
-byte output_option;       // 0: blinks only, 1: long printout, 2: short printout
+// pipeline: recording and categorization of different slots (NS, NV_SLOT: cf. arena.h)
+#define PENDING_DEADLINE  250UL          // a filled slot is categorized at the latest this long after its reception [ms]
+#define IDLE_PER_MS      1600UL          // start trigger wait per ms [poll cycles] (the timeout up to the deadline)
+
+// scan: frequency hopping over a table of channels
+#define RM_SCAN            4             // rp.radio_module: scan the channel table
+#define NCH                4             // number of scanned channels
+#define SCAN_SAMPLES      16             // strength measurements of the activity check (~ 1 ms)
+#define SCAN_DWELL   200000UL            // start trigger timeout on an active channel [poll cycles] (~ 0.1 s)
+#define SCAN_LOCK   4000000UL            // start trigger timeout once locked onto a channel [poll cycles] (~ 2 s)
+
+byte output_option;       // 0: without trace, 1: with trace, 2: with binary trace, 3: with compressed trace, 4: streaming
+long serial_baud;         // baud rate after the parameter printout
 int  rp_min_length;       // minimal length in case of abort
 receiver_parameters rp;   // receiver parameters
+categorizer_parameters cp= CATEGORIZER_DEFAULTS;   // categorizer parameters (FIXED_PARAMETERS: the compiled-in defaults)
 
 // RFM69 library
 volatile byte _mode;
@@ -103,25 +198,80 @@ bool _isRFM69HW;
 byte _slaveSelectPin;
 
 void reporting(recorded_signals &rs);
+void binary_reporting(recorded_signals &rs);
+void write_uint16(unsigned int val);
+void processing(recorded_signals &rs, byte return_code);
+void process_oldest(recorded_signals rs[]);
+byte free_slot(byte busy_slot);
+bool stream_consumer(unsigned int duration, byte level);
+void profile_reporting();
+void listen_reporting();
+void categorizer_output(duration_seq v, uint16_t v_length);
 void blink_led(byte pin, int delay_high, int delay_low, int rep);
+int  free_ram();
 
 // HIGH/LOW duration-categories:   [odd indices]: HIGH-durations, [even indices]: LOW-durations
 // ----------------------------
 categories  duration_category[2]; 
+bool        category_known;   // duration_category holds the categories of the previous successful categorization
+byte        category_radio;   // radio module of the known categories (dual radio: the bands have different protocols)
+stream_state stream_counters; // streaming: counters of the stream classifier (since the previous processing)
 
 // accumulated noise between two receptions (recorder return codes)
 //------------------
-byte acc_err[NR];
+byte acc_err[2][NR];            // per radio module: [RM_1 - 1], [RM_2 - 1]
 byte acc_ind;
 
-// buffers
+// pipeline
+// --------
+byte rec_slot;                  // slot being recorded (producer)
+byte pending[NS];               // filled slots in order of reception (consumer)
+byte pending_code[NS];          // recorder return codes of the filled slots
+byte pending_count;             // number of filled slots
+unsigned long pending_millis[NS]; // reception times of the filled slots [ms] (-> PENDING_DEADLINE)
+byte edge_slot;                 // dual radio, capture backend: free slot buffering the edges of the other band
+unsigned int dropped_count;     // frames dropped because all other slots were busy
+unsigned int screened_count;    // receptions predicted unclusterable by the pre-screen (cf. categorizer.h: PRESCREEN_MODE)
+unsigned int screened_false;    // PRESCREEN_VERIFY: of which categorized successfully (false predictions)
+
+// scan
+// ----
+typedef struct {
+  byte radio_module;            // RM_1 or RM_2
+  long radio_frequency;         // FRQ(MHz)
+  byte radio_sensitivity;       // min strength to start reception (REG_OOKFIX)
+  unsigned int hit_count;       // start triggers that passed the strength check
+} scan_channel;
+scan_channel channel[NCH]= {
+  {RM_1, FRQ(433.864), 18, 0},
+  {RM_1, FRQ(433.920), 30, 0},
+  {RM_2, FRQ(868.210), 40, 0},
+  {RM_2, FRQ(868.970), 17, 0}
+};
+bool scan_mode;                 // rp.radio_module == RM_SCAN
+bool scan_locked;               // a start trigger passed: stay on the channel until the next idle timeout
+byte scan_ind;                  // current channel
+
+#if (STORE_MODE == EEPROM_STORE)
+// stored state
+// ------------
+bool stored_entry;              // the stored parameters are used: a character sent re-enters setup (cf. loop)
+bool parameter_entry;           // setup re-entered: ask for new parameters (the store is already loaded)
+#endif
+
+// buffers: recorder slots and categorizer scratch (cf. arena.h)
 // -------
-uint8_t  uint8buf32[DIM_32];    // uint8_t  buffer
-uint16_t uint16buf64[DIM_64];   // uint16_t buffer
+scratch_arena arena;
 
 // ========================================================================================================
 
 void setup() {
+  byte ind;
+#if (STORE_MODE == EEPROM_STORE)
+  store_parameters sp;     // stored parameters (cf. store.h)
+  bool stored;             // the parameters of the previous boot are used
+#endif
+
   pinMode(LED, OUTPUT); 
   Serial.begin(SERIAL_BAUD);
   
@@ -134,9 +284,39 @@ void setup() {
   output_option=         TRACE_OUTPUT; 
   rp.radio_module=       RADIO_MODULE_1; 
   rp.radio_frequency=    FRQ(RADIO_FREQUENCY_1);
+  rp.radio_frequency_2=  FRQ(RADIO_FREQUENCY_2);
   rp.radio_sensitivity=  RADIO_SENSITIVITY;
-  rp.max_length=     min(RECEPTION_MAX_LENGTH, NV);         
+  rp.max_length=     min(RECEPTION_MAX_LENGTH, NV_SLOT);         
   rp_min_length=     min(RECEPTION_MIN_LENGTH, rp.max_length);
+  rp.idle_limit=     INFINITE_PAUSE;
+  rp.edge_buffer=    NULL;
+  serial_baud=       SERIAL_BAUD;
+#if (STORE_MODE == EEPROM_STORE)
+  // stored parameters: no parameter wait (they become the defaults, if new parameters are asked for)
+  // -----------------
+  if (!parameter_entry) switch (store_begin()) {
+    case STORE_FORMATTED: Serial.println(F("store formatted")); break;
+    case STORE_TOO_SMALL: Serial.println(F("store disabled: the layout exceeds the EEPROM")); break;
+  }
+  stored= store_get_parameters(sp);
+  if (stored) {
+    output_option=        sp.output_option;
+    rp.radio_module=      sp.radio_module;
+    rp.radio_frequency=   sp.radio_frequency;
+    rp.radio_frequency_2= sp.radio_frequency_2;
+    rp.radio_sensitivity= sp.radio_sensitivity;
+    rp.max_length=    min(sp.max_length, NV_SLOT);
+    rp_min_length=        sp.min_length;
+    serial_baud=          sp.serial_baud;
+    cp=                   sp.cp;
+    if (parameter_entry) stored= false;
+    else Serial.println(F("stored parameters (send a character to enter new ones)"));
+  }
+  // the first reception does not wait on the serial line: loop polls for the character
+  stored_entry= stored;
+  parameter_entry= false;
+  if (!stored) {
+#endif
   
   // get reception parameters
   // ------------------------
@@ -148,12 +328,20 @@ void setup() {
   if (Serial.available() > 1) rp.radio_sensitivity= Serial.parseInt();
   if (Serial.available() > 1) {
     rp.max_length= Serial.parseInt(); 
-    rp.max_length= min(rp.max_length, NV); 
+    rp.max_length= min(rp.max_length, NV_SLOT); 
   }
   if (Serial.available() > 1) {
     rp_min_length= Serial.parseInt();
   }
+  if (Serial.available() > 1) serial_baud= Serial.parseInt();
+  if (Serial.available() > 1) rp.radio_frequency_2= FRQ(Serial.parseFloat());
+#if (STORE_MODE == EEPROM_STORE)
+  }
+#endif
   rp_min_length= min(rp_min_length, rp.max_length);
+  scan_mode= (rp.radio_module == RM_SCAN);
+  scan_locked= false;
+  scan_ind= NCH - 1;
   
   // print reception parameters
   Serial.print(F("output option    :\t"));
@@ -162,21 +350,122 @@ void setup() {
   Serial.println(rp.radio_module);  
   Serial.print(F("radio frequency  :\t"));
   Serial.println( 10*((100*rp.radio_frequency)>>4)>>10 ); 
+  if (rp.radio_module == RM_DUAL) {
+    Serial.print(F("radio frequency 2:\t"));
+    Serial.println( 10*((100*rp.radio_frequency_2)>>4)>>10 ); 
+  }
   Serial.print(F("radio sensitivity:\t"));
   Serial.println(rp.radio_sensitivity);
   Serial.print(F("reception max. length:\t"));
   Serial.println(rp.max_length);
   Serial.print(F("reception min. length:\t"));
   Serial.println(rp_min_length);
+  Serial.print(F("serial baud      :\t"));
+  Serial.println(serial_baud);
+#if (PARAMETER_MODE == TUNABLE_PARAMETERS)
+  // get categorizer parameters
+  // --------------------------
+  #if (STORE_MODE == EEPROM_STORE)
+  if (!stored) {
+  #endif
+  Serial.println(F("paste/enter categorizer parameters within 3 seconds:"));
+  delay(3000);
+  if (Serial.available() > 1) cp.border_width= constrain(Serial.parseInt(), 2, BORDER_WIDTH_MAX);
+  if (Serial.available() > 1) cp.start_val= Serial.parseInt();
+  if (Serial.available() > 1) cp.max_holes= constrain(Serial.parseInt(), 0, NB);
+  if (Serial.available() > 1) cp.first_hits= constrain(Serial.parseInt(), 1, 2);
+  if (Serial.available() > 1) cp.min_size= constrain(Serial.parseInt(), 1, 255);
+  if (Serial.available() > 1) cp.outlier_option= constrain(Serial.parseInt(), 1, C_OPT_MAX);
+  if (Serial.available() > 1) cp.resorber_option= constrain(Serial.parseInt(), 1, C_OPT_MAX);
+  #if (STORE_MODE == EEPROM_STORE)
+  }
+  #endif
+  // print categorizer parameters
+  Serial.print(F("border width     :\t"));
+  Serial.println(cp.border_width);
+  Serial.print(F("start value      :\t"));
+  Serial.println(cp.start_val);
+  Serial.print(F("max. holes       :\t"));
+  Serial.println(cp.max_holes);
+  Serial.print(F("first hits       :\t"));
+  Serial.println(cp.first_hits);
+  Serial.print(F("min. cluster size:\t"));
+  Serial.println(cp.min_size);
+  Serial.print(F("outlier option   :\t"));
+  Serial.println(cp.outlier_option);
+  Serial.print(F("resorber option  :\t"));
+  Serial.println(cp.resorber_option);
+#endif
+  // RAM report [bytes] (cf. arena.h)
+  Serial.print(F("RAM profile      :\t"));
+  Serial.println(MEMORY_PROFILE);
+  Serial.print(F("RAM arena        :\t"));
+  Serial.print(ARENA_RECORDER);
+  Serial.print(F(" recorder + "));
+  Serial.print(ARENA_CATEGORIZER);
+  Serial.println(F(" categorizer"));
+  Serial.print(F("RAM categorizer  :\t"));
+  Serial.println(CATEGORIZER_STATIC);
+  Serial.print(F("RAM free         :\t"));
+  Serial.println(free_ram());
+#if (STORE_MODE == EEPROM_STORE)
+  // keep the parameters for the next boot (unchanged bytes are not written), print the stored counters
+  sp.output_option=     output_option;
+  sp.radio_module=      rp.radio_module;
+  sp.radio_frequency=   rp.radio_frequency;
+  sp.radio_frequency_2= rp.radio_frequency_2;
+  sp.radio_sensitivity= rp.radio_sensitivity;
+  sp.max_length=        rp.max_length;
+  sp.min_length=        rp_min_length;
+  sp.serial_baud=       serial_baud;
+  sp.cp=                cp;
+  store_put_parameters(sp);
+  store_flush(true);
+  Serial.print(F("stored boots     :\t"));
+  Serial.println(stored_counters.boot_count);
+  Serial.println(F("stored channels [kHz: receptions, categorized, noise]:"));
+  for (ind= 0; ind < STORE_CHANNELS; ind++) {
+    if (stored_counters.channel[ind].frequency == 0) continue;
+    Serial.print(10*((100*stored_counters.channel[ind].frequency)>>4)>>10);
+    Serial.print(F(": "));
+    Serial.print(stored_counters.channel[ind].reception_count);
+    Serial.print(F(", "));
+    Serial.print(stored_counters.channel[ind].category_count);
+    Serial.print(F(", "));
+    Serial.println(stored_counters.channel[ind].noise_count);
+  }
+#endif
+  if (scan_mode) {
+    Serial.println(F("scanned channels [kHz, sensitivity]:"));
+    for (ind= 0; ind < NCH; ind++) {
+      Serial.print(10*((100*channel[ind].radio_frequency)>>4)>>10);
+      Serial.print(F("\t"));
+      Serial.println(channel[ind].radio_sensitivity);
+    }
+  }
   Serial.println();
+  if (serial_baud != SERIAL_BAUD) {
+    // switch the baud rate once the printout has been sent
+    Serial.flush();
+    Serial.begin(serial_baud);
+  }
 
   // initiate both radio modules to standby (cf. radio_lib.cpp)
   // --------------------------------------
   init_radio();
+#if (PROFILING == CYCLE_PROFILING)
+  // Timer1 counts cycles (cf. profiler.h)
+  profile_begin();
+#endif
 
   // reset accumulated recorder return codes
   // ---------------------------------------
-  for (acc_ind= 0; acc_ind < NR; acc_ind++) acc_err[acc_ind]= 0;
+  memset(acc_err, 0, sizeof(acc_err));
+  dropped_count= 0;
+  screened_count= 0;
+  screened_false= 0;
+  category_known= false;
+  memset(&stream_counters, 0, sizeof(stream_counters));
 
   // ready-signal: 3 blinks 
   // ======================
@@ -188,35 +477,138 @@ void setup() {
 
 void loop() {
   byte return_code;  
+  byte ind;  
+  unsigned long elapsed;   // since the reception of the oldest filled slot [ms]
 
   // recorded signals (cf. radio_lib.cpp)
   // ================
-  recorded_signals rs;
+  // pool of NS slots: the recorder fills one slot while the filled slots wait for the categorizer
+  // (the recorder busy-waits during a reception with either backend: the categorizer runs in the idle gaps)
+  recorded_signals rs[NS];
   
-  // allocate buffers (first index = 1 = index of the first HIGH, position 0 is not used)
+  // allocate signals: the slots of the arena (first index = 1 = index of the first HIGH, position 0 is not used)
   // ----------------
-  byte signal_strength[WARM_UP + 1]; // signal strengths of the first WARM_UP signals
-                                     // signal strengths: [odd indices]: HIGH-strengths, [even indices]: LOW-strengths 
-  uint16_t signal_duration[NV + 5];  // signal sequence : [odd indices]: HIGH-durations, [even indices]: LOW-durations
-                                     // LSB flagged: 0: reliable, 1: unreliable value
-                                     // 2 records appended at the end plus 1 (unused position 0) gives 5
- 
-  // allocate signals 
-  // ----------------
-  rs.duration= signal_duration;
-  rs.strength= signal_strength;
+  // durations: LSB flagged: 0: reliable, 1: unreliable value
+  // strengths: [odd indices]: HIGH-strengths, [even indices]: LOW-strengths 
+  for (ind= 0; ind < NS; ind++) {
+#if (DURATION_STORAGE == LOG8_DURATIONS)
+    rs[ind].duration.code= arena.duration[ind];
+    rs[ind].duration.flag= arena.reliability[ind];
+#else
+    rs[ind].duration= arena.duration[ind];
+#endif
+    rs[ind].strength= arena.strength[ind];
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+    rs[ind].transmitter= arena.transmitter[ind];
+#endif
+  }
+  // all slots are free, record into slot 0
+  rec_slot= 0;
+  pending_count= 0;
 
   while (true) {
+
+#if (STORE_MODE == EEPROM_STORE)
+    // stored parameters: a character sent re-enters setup for new parameters (the pending frames are dropped)
+    if (stored_entry && (Serial.available() > 0)) {
+      while (Serial.available() > 0) Serial.read();
+      parameter_entry= true;
+      setup();
+      return;
+    }
+#endif
+
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+    // dual radio: a reception of the other band has been buffered in edge_slot, it is replayed there without delay
+    if ((rp.radio_module == RM_DUAL) && (capture_pending() != 0)) {
+      rec_slot= edge_slot;
+      rp.edge_buffer= NULL;
+      return_code= recorder(rp, rs[rec_slot]);
+      goto RECORDED;
+    }
+#endif
+
+    // deadline: repeats and noise keep restarting the recorder, the oldest filled slot does not wait longer
+    if ((pending_count > 0) && (millis() - pending_millis[0] >= PENDING_DEADLINE)) {
+      process_oldest(rs);
+      continue;
+    }
     
+    if (scan_mode && !scan_locked) {
+      // ==== //
+      // scan //   hop to the next channel, stay there only if the channel is active
+      // ==== //
+      scan_ind= (scan_ind + 1) % NCH;
+      rp.radio_module=      channel[scan_ind].radio_module;
+      rp.radio_frequency=   channel[scan_ind].radio_frequency;
+      rp.radio_sensitivity= channel[scan_ind].radio_sensitivity;
+      // the categories belong to the previous channel
+      category_known= false;
+      if (channel_activity(rp.radio_module, rp.radio_frequency, SCAN_SAMPLES) < rp.radio_sensitivity) {
+        // quiet channel: use the gap for a pending frame
+        if (pending_count > 0) process_oldest(rs);
+        continue;
+      }
+    }
+
     // ======== //
-    // recorder //   record HIGH- / LOW- signal durations
+    // recorder //   record HIGH- / LOW- signal durations (producer)
     // ======== //
+    // while frames are pending, give up waiting for a start trigger at the deadline of the oldest one
+    if (pending_count > 0) {
+      elapsed= millis() - pending_millis[0];
+      rp.idle_limit= (elapsed < PENDING_DEADLINE) ? (PENDING_DEADLINE - elapsed) * IDLE_PER_MS : 1;
+    }
+    else rp.idle_limit= INFINITE_PAUSE;
+    // scan: dwell on the channel (longer once locked)
+    if (scan_mode) rp.idle_limit= min(rp.idle_limit, scan_locked ? SCAN_LOCK : SCAN_DWELL);
+    // streaming: classify on the fly with the learned categories (the slot becomes a ring)
+    // (not with the dual radio or the scan: the channel, hence the categories, may change with each reception)
+    if ((output_option == STREAM_OUTPUT) && category_known && (rp.radio_module != RM_DUAL) && !scan_mode) rp.stream= stream_consumer;
+    else rp.stream= NULL;
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+    // dual radio: lend a free slot to the other band (the recorder buffers its edges during the reception)
+    rp.edge_buffer= NULL;
+    if ((rp.radio_module == RM_DUAL) && ((edge_slot= free_slot(rec_slot)) < NS)) {
+      rp.edge_buffer=   (uint16_t *) arena.duration[edge_slot];
+      rp.edge_capacity= min(sizeof(arena.duration[0]) / 2, 255);
+    }
+#endif
     // return_code: see radio_lib.h
-    return_code= recorder(rp, rs);    
+    return_code= recorder(rp, rs[rec_slot]);    
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+RECORDED:
+#endif
+
+    if (return_code == RRC_16) {
+      // scan: no start trigger within the dwell time, continue hopping
+      scan_locked= false;
+      // idle gap: categorize the oldest filled slot (consumer)
+      if (pending_count > 0) process_oldest(rs);
+      continue;
+    }
+
+    if (return_code == RRC_17) {
+      // ========== //
+      // processing //   streaming: re-cluster the most recent values without delay
+      // ========== //
+      Serial.println();
+      Serial.println(F("***** stream: outlier rate too high, re-clustering"));
+      processing(rs[rec_slot], return_code);
+      continue;
+    }
     
     // accumulated recorder return codes (-> noise)
     // ---------------------------------
-    if ((return_code < NR) && (acc_err[return_code] < 100)) acc_err[return_code]++;
+    // (per radio module: the band of the slot)
+    ind= rs[rec_slot].radio_module - 1;
+    if ((return_code < NR) && (acc_err[ind][return_code] < 100)) acc_err[ind][return_code]++;
+
+    if (scan_mode && (return_code != RRC_5) && (return_code != RRC_6)) {
+      // scan: a start trigger passed, lock onto the channel
+      if (channel[scan_ind].hit_count < 60000U) channel[scan_ind].hit_count++;
+      scan_locked= true;
+    }
 
     // check the start signal 
     if (return_code == RRC_6) {
@@ -225,63 +617,383 @@ void loop() {
       // ----------------------------
       Serial.println();
       Serial.print(F("***** signal too strong: "));
-      Serial.print(rs.ref_strength_high);
+      Serial.print(rs[rec_slot].ref_strength_high);
       Serial.println(F(" dBm"));
       blink_led (LED, 600, 600, 1);
       continue;
     }
-    if ((return_code > 1) && (rs.count < rp_min_length)) {
+    if ((return_code > 1) && (rs[rec_slot].count < rp_min_length)) {
       // recorder ended with error
       // -------------------------
       continue;
     }
-    if (output_option == TRACE_OUTPUT) {
-      // *********** //
-      // print trace //
-      // *********** //
-      reporting(rs);
+
+#if (PRESCREEN_MODE == PRESCREEN)
+    // pre-screen: a reception predicted unclusterable (noise) is neither reported nor categorized,
+    // -----------  the slot is recorded again (the accumulated return codes are reported with the next reception)
+    if (!prescreener(rs[rec_slot].duration, rs[rec_slot].count, rs[rec_slot].unreliable_count, arena.uint8buf32)) {
+      if (screened_count < 60000U) screened_count++;
+      continue;
     }
+#endif
 
-    // accumulated noise since previous reception
-    // ------------------------------------------
-    Serial.println();
-    Serial.println(F("accumulated recorder return codes:"));
-    for (acc_ind= 0; acc_ind < NR; acc_ind++) {
-      if (acc_err[acc_ind] > 0) {
-        Serial.print(acc_ind);
-        Serial.print("\t");
-        Serial.println(acc_err[acc_ind]);
-      }
+    // hand-off: the recorded slot becomes a filled slot
+    // --------
+    // the recorder needs a free slot for the next reception, the filled slots wait for the next idle gap
+    // (at the latest PENDING_DEADLINE: a burst of up to NS - 1 frames is held)
+    if (pending_count >= NS - 1) {
+      // all other slots are busy: the frame is dropped, the slot is recorded again
+      if (dropped_count < 60000U) dropped_count++;
+      continue;
     }
+    pending[pending_count]= rec_slot;
+    pending_millis[pending_count]= millis();
+    pending_code[pending_count++]= return_code;
+    // find a free slot for the recorder
+    rec_slot= free_slot(NS);
+  }
+} // end void loop()
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+byte free_slot(byte busy_slot) {
+  // the first slot that is neither filled nor busy_slot (NS: none)
+  byte slot;
+  byte ind;
 
-    // reception summery
-    // -----------------
-    Serial.print(F("recorder return_code: "));   
-    Serial.print(return_code);   
-    Serial.print(F(", count: "));   
-    Serial.print(rs.count);   
-    Serial.print(F(", unreliables: "));   
-    Serial.println(rs.unreliable_count);
+  for (slot= 0; slot < NS; slot++) {
+    if (slot == busy_slot) continue;
+    for (ind= 0; ind < pending_count; ind++) {
+      if (pending[ind] == slot) break;
+    }
+    if (ind == pending_count) break;
+  }
+  return slot;
+}
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+void process_oldest(recorded_signals rs[]) {
+  // ********** //
+  // processing //   idle gap: categorize the oldest filled slot (consumer) and release it
+  // ********** //
+  byte ind;
+
+  processing(rs[pending[0]], pending_code[0]);
+  // release the slot
+  pending_count--;
+  for (ind= 0; ind < pending_count; ind++) {
+    pending[ind]= pending[ind + 1];
+    pending_millis[ind]= pending_millis[ind + 1];
+    pending_code[ind]= pending_code[ind + 1];
+  }
+}
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+void processing(recorded_signals &rs, byte return_code) {
+  // ********** //
+  // processing //   print and categorize a filled slot
+  // ********** //
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  uint16_t s_length[2];       // separated sub-sequences: [0]: other, [1]: reference transmitter (cf. separator)
+  uint16_t s_unreliable[2];
+  byte     s_ind;
+#endif
+#if (STORE_MODE == EEPROM_STORE)
+  unsigned int noise;         // accumulated recorder return codes (cf. store_count)
+#endif
+#if (PRESCREEN_MODE == PRESCREEN_VERIFY)
+  // debug: the prediction of the pre-screen, checked against the categorizer below
+  // (before the reporting: the categorizer corrects the slot in place)
+  bool clusterable= prescreener(rs.duration, rs.count, rs.unreliable_count, arena.uint8buf32);
+  if (!clusterable && (screened_count < 60000U)) screened_count++;
+#endif
+
+  if (output_option == TRACE_OUTPUT) {
+    // *********** //
+    // print trace //
+    // *********** //
+    reporting(rs);
+  } else
+  if (output_option == BINARY_OUTPUT) {
+    // ************ //
+    // binary trace //
+    // ************ //
+    binary_reporting(rs);
+  } else
+  if (output_option == COMPRESSED_OUTPUT) {
+    // **************** //
+    // compressed trace //   categories of the previous reception (the trace is not yet categorized)
+    // **************** //
+    trace_encoder (duration_category, (category_known && (category_radio == rs.radio_module)) ? CODEC_CATEGORY : CODEC_RAW,
+                   rs.duration, rs.count, rs.unreliable_count);
+  }
+
+  // accumulated noise since previous reception
+  // ------------------------------------------
+  Serial.println();
+  Serial.print(F("accumulated recorder return codes, radio module "));
+  Serial.print(rs.radio_module);
+  Serial.println(F(":"));
+  for (acc_ind= 0; acc_ind < NR; acc_ind++) {
+    if (acc_err[rs.radio_module - 1][acc_ind] > 0) {
+      Serial.print(acc_ind);
+      Serial.print("\t");
+      Serial.println(acc_err[rs.radio_module - 1][acc_ind]);
+    }
+  }
+
+  // reception summery
+  // -----------------
+  Serial.print(F("recorder return_code: "));   
+  Serial.print(return_code);   
+  Serial.print(F(", count: "));   
+  Serial.print(rs.count);   
+  Serial.print(F(", unreliables: "));   
+  Serial.println(rs.unreliable_count);
+  Serial.print(F("dropped frames (slots busy): "));   
+  Serial.println(dropped_count);
+#if (PRESCREEN_MODE != NO_PRESCREEN)
+  Serial.print(F("pre-screened receptions (predicted unclusterable): "));   
+  Serial.print(screened_count);
+  #if (PRESCREEN_MODE == PRESCREEN_VERIFY)
+  Serial.print(F(", false predictions: "));   
+  Serial.print(screened_false);
+  Serial.print(F(", this reception: "));   
+  Serial.print(clusterable ? F("clusterable") : F("unclusterable"));
+  #endif
+  Serial.println();
+#endif
+  if (scan_mode) {
+    // start triggers per scanned channel
+    Serial.print(F("scan hits [kHz: count]:"));
+    for (acc_ind= 0; acc_ind < NCH; acc_ind++) {
+      Serial.print(F("  "));
+      Serial.print(10*((100*channel[acc_ind].radio_frequency)>>4)>>10);
+      Serial.print(F(": "));
+      Serial.print(channel[acc_ind].hit_count);
+    }
     Serial.println();
-    
-    // =========== //
-    // categorizer //   map the signal durations into duration levels
-    // =========== //      
-    // return_code: see categorizer.h
-    return_code= 0;
-    categorizer (duration_category, signal_duration, rs.count, rs.unreliable_count, return_code,
-                 uint8buf32, uint16buf64);
-    Serial.print(F("categorizer return_code: "));   
-    Serial.println(return_code);   
-    
-    // reset the accumulated recorder return codes
-    for (acc_ind= 0; acc_ind < NR; acc_ind++) acc_err[acc_ind]= 0;
-    
-    // successful reception: 1 short blink
-    // ====================
-    if (return_code == CRC_0) blink_led (LED, 300, 300, 1);
   }
-} // end void loop()
+  if (output_option == STREAM_OUTPUT) {
+    // streaming summary
+    Serial.print(F("streamed values: "));   
+    Serial.print(stream_counters.value_count);   
+    Serial.print(F(", outliers: "));   
+    Serial.print(stream_counters.outlier_count);   
+    Serial.print(F(", re-clusterings: "));   
+    Serial.println(stream_counters.recluster_count);
+    memset(&stream_counters, 0, sizeof(stream_counters));
+  }
+  Serial.println();
+  
+  // =========== //
+  // categorizer //   map the signal durations into duration levels
+  // =========== //      
+  // return_code: see categorizer.h
+  return_code= 0;
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  if ((rs.collision_count > 0) && separator(rs.duration, rs.count, rs.transmitter, s_length, s_unreliable)) {
+    // two transmitters: the other one first, then the reference transmitter (its categories are kept)
+    for (s_ind= 0; s_ind < 2; s_ind++) {
+      if (s_ind == 1) separator_shift(rs.duration, s_length[0] + 2, s_length[1] + 2);
+      Serial.print(F("transmitter "));
+      Serial.print(2 - s_ind);
+      Serial.print(F(", strength: "));
+      Serial.print((s_ind == 0) ? rs.other_strength : rs.ref_strength_high);
+      Serial.print(F(", count: "));
+      Serial.println(s_length[s_ind]);
+      if (s_length[s_ind] < rp_min_length) continue;
+      return_code= 0;
+      categorizer (duration_category, rs.duration, s_length[s_ind], s_unreliable[s_ind],
+                   CACHE_KEY(((rp.radio_module == RM_DUAL) && (rs.radio_module == RM_2)) ? rp.radio_frequency_2 : rp.radio_frequency,
+                             (s_ind == 0) ? rs.other_strength : rs.ref_strength_high),
+                   cp, return_code, arena.uint8buf32, arena.uint16buf64, arena.trusted);
+      if (return_code == CRC_0) categorizer_output(rs.duration, s_length[s_ind]);
+      STAGE_MARK(STAGE_NONE);
+      Serial.print(F("categorizer return_code: "));   
+      Serial.println(return_code);   
+    }
+  } else {
+#endif
+  categorizer (duration_category, rs.duration, rs.count, rs.unreliable_count,
+               CACHE_KEY(((rp.radio_module == RM_DUAL) && (rs.radio_module == RM_2)) ? rp.radio_frequency_2 : rp.radio_frequency,
+                         rs.ref_strength_high),
+               cp, return_code, arena.uint8buf32, arena.uint16buf64, arena.trusted);
+  if (return_code == CRC_0) categorizer_output(rs.duration, rs.count);
+  STAGE_MARK(STAGE_NONE);
+  Serial.print(F("categorizer return_code: "));   
+  Serial.println(return_code);   
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  }
+#endif
+#if (PRESCREEN_MODE == PRESCREEN_VERIFY)
+  if (!clusterable && (return_code == CRC_0)) {
+    // the pre-screen would have lost this reception
+    if (screened_false < 60000U) screened_false++;
+    Serial.println(F("***** pre-screen: false prediction (unclusterable)"));
+  }
+#endif
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  Serial.print(F("category cache hits: "));   
+  Serial.print(cache_counters.hit_count);   
+  Serial.print(F(", misses: "));   
+  Serial.println(cache_counters.miss_count);
+#endif
+#if (PROFILING == CYCLE_PROFILING)
+  profile_reporting();
+#endif
+#if (IDLE_MODE == LISTEN_IDLE)
+  listen_reporting();
+#endif
+  category_known= (return_code == CRC_0);
+  category_radio= rs.radio_module;
+#if (STORE_MODE == EEPROM_STORE)
+  // persistent counters of the channel (the processed reception is one of the accumulated return codes)
+  noise= 0;
+  for (acc_ind= 0; acc_ind < NR; acc_ind++) noise+= acc_err[rs.radio_module - 1][acc_ind];
+  store_count(((rp.radio_module == RM_DUAL) && (rs.radio_module == RM_2)) ? rp.radio_frequency_2 : rp.radio_frequency,
+              return_code == CRC_0, (noise > 0) ? noise - 1 : 0);
+  store_flush(false);
+#endif
+  
+  // reset the accumulated recorder return codes (of this radio module)
+  for (acc_ind= 0; acc_ind < NR; acc_ind++) acc_err[rs.radio_module - 1][acc_ind]= 0;
+  
+  // successful reception: 1 short blink
+  // ====================
+  if (return_code == CRC_0) blink_led (LED, 300, 300, 1);
+}
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+void categorizer_output(duration_seq v, uint16_t v_length) {
+  // ****************** //
+  // categorizer_output //   consumer of a successful categorization (categorizer() prints nothing)
+  // ****************** //
+  // CATEGORIZER_OUTPUT == RESULT_OUTPUT: the structured result in place of the durations (v is overwritten),
+  // summarized by its flags; otherwise the printed output (cf. categorizer.cpp: categorizer_printer)
+#if (CATEGORIZER_OUTPUT == RESULT_OUTPUT)
+  categorizer_result result;
+  unsigned int count[5];    // categorized, unreliable, top, below, unclassified
+  unsigned int ind;
+
+  STAGE_MARK(STAGE_PRINTER);
+  result_builder (duration_category, v, v_length, RESULT_STORAGE(v), result);
+  memset(count, 0, sizeof(count));
+  for (ind= 1; ind <= result.length; ind++) {
+    if (RESULT_CATEGORY(result.code[ind])) count[0]++;
+    if (result.code[ind] & RESULT_UNRELIABLE) count[1]++;
+    if (result.code[ind] & RESULT_TOP) count[2]++;
+    else if (result.code[ind] & RESULT_BELOW) count[3]++;
+    else if ((result.code[ind] & RESULT_INDEX) == RESULT_NONE) count[4]++;
+  }
+  Serial.println();
+  Serial.print(F("result positions: "));
+  Serial.print(result.length);
+  Serial.print(F(", categorized: "));
+  Serial.print(count[0]);
+  Serial.print(F(", unreliable: "));
+  Serial.print(count[1]);
+  Serial.print(F(", top: "));
+  Serial.print(count[2]);
+  Serial.print(F(", below: "));
+  Serial.print(count[3]);
+  Serial.print(F(", unclassified: "));
+  Serial.println(count[4]);
+#else
+  categorizer_printer (duration_category, v, v_length, arena.uint8buf32, arena.uint16buf64);
+#endif
+}
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+#if (PROFILING == CYCLE_PROFILING)
+void profile_reporting() {
+  // ****************** //
+  // profile_reporting  //   cycles per stage since the previous processing (cf. profiler.h)
+  // ****************** //
+  // recorder stages: all receptions since the previous processing, categorizer stages: this processing
+  byte s_ind;
+
+  Serial.println();
+  Serial.println(F("profile [cycles]: stage, count, total, mean"));
+  for (s_ind= 0; s_ind < STAGE_COUNT; s_ind++) {
+    if (profile.count[s_ind] == 0) continue;
+    switch (s_ind) {
+      case STAGE_WARM_UP:      Serial.print(F("warm-up        ")); break;
+      case STAGE_RECORDING:    Serial.print(F("recording      ")); break;
+      case STAGE_CLUSTERER:    Serial.print(F("clusterer      ")); break;
+      case STAGE_HISTOGRAM:    Serial.print(F("histogram pass ")); break;
+      case STAGE_OUTLIERS:     Serial.print(F("corrector 2.2.1")); break;
+      case STAGE_SUBSEQUENCES: Serial.print(F("corrector 2.2.2")); break;
+      case STAGE_PRINTER:      Serial.print(F("sequence_printer")); break;
+    }
+    Serial.print("\t");
+    Serial.print(profile.count[s_ind]);
+    Serial.print("\t");
+    Serial.print(profile.cycles[s_ind]);
+    Serial.print("\t");
+    Serial.println(profile.cycles[s_ind] / profile.count[s_ind]);
+  }
+  Serial.print(F("signal_strength\t"));
+  Serial.print(profile.strength_count);
+  Serial.print("\t");
+  Serial.print(profile.strength_cycles);
+  Serial.print(F("\tmax: "));
+  Serial.println(profile.strength_max);
+  profile_reset();
+}
+#endif
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+#if (IDLE_MODE == LISTEN_IDLE)
+void listen_reporting() {
+  // ***************** //
+  // listen_reporting  //   duty cycle of the listen idle since the start (cf. radio_lib.cpp: 0.7)
+  // ***************** //
+  // the current is an estimate: the measured sleep / awake times weighted with the datasheet currents of radio_lib.h
+  // (asleep: the radio in listen mode, idle or RX window; awake: MCU active and the radio in RX)
+  unsigned long awake_ms=  millis();     // Timer0 stops in power-down
+  unsigned long asleep_ms= listen_stats.sleep_ticks * LISTEN_TICK_MS;
+  float rx_share=       (float)(LISTEN_RX_COEF * 64UL) / (LISTEN_RX_COEF * 64UL + LISTEN_IDLE_COEF * 4100UL);
+  float current_asleep= CURRENT_MCU_SLEEP + CURRENT_RADIO_IDLE + rx_share * (CURRENT_RADIO_RX - CURRENT_RADIO_IDLE);
+  float current_awake=  CURRENT_MCU_ACTIVE + CURRENT_RADIO_RX;
+
+  Serial.print(F("listen wakes: "));
+  Serial.print(listen_stats.wake_count);
+  Serial.print(F(", false wakes: "));
+  Serial.print(listen_stats.false_wakes);
+  Serial.print(F(", asleep [s]: "));
+  Serial.print(asleep_ms / 1000);
+  Serial.print(F(", awake [s]: "));
+  Serial.println(awake_ms / 1000);
+  Serial.print(F("listen wake latency [us]: "));
+  Serial.print(listen_stats.wake_latency);
+  Serial.print(F(", max: "));
+  Serial.print(listen_stats.wake_latency_max);
+  Serial.print(F(" (+ start-up "));
+  Serial.print(LISTEN_STARTUP_US);
+  Serial.print(F(", + detection <= "));
+  Serial.print(LISTEN_IDLE_COEF * 4100UL);
+  Serial.println(F(")"));
+  Serial.print(F("estimated current [uA]: "));
+  Serial.print((current_asleep * asleep_ms + current_awake * awake_ms) / (asleep_ms + awake_ms), 0);
+  Serial.print(F(" (asleep: "));
+  Serial.print(current_asleep, 0);
+  Serial.print(F(", awake: "));
+  Serial.print(current_awake, 0);
+  Serial.println(F(")"));
+}
+#endif
 
 // ========================================================================================================
 //*********************************************************************************************************
@@ -375,6 +1087,81 @@ void reporting(recorded_signals &rs) {
 
 //*********************************************************************************************************
 
+void binary_reporting(recorded_signals &rs) {
+  // ************ //
+  // binary trace //
+  // ************ //
+  // the same content as reporting() in a length-prefixed frame (cf. Binary TRACE above)
+  // a 512-value trace takes about 1 KB instead of several KB of decimal text
+  
+  int  ind;  
+  int  k;
+  int  n;
+  // Fletcher16 Checksum (cf. categorizer_lib.cpp)
+  unsigned int sum1;  
+  unsigned int sum2; 
+
+  // number of warm-up strengths and number of durations ("ending" included)
+  k= min(WARM_UP + 1, rs.count); 
+  if (k < 1) k= 1;
+  n= rs.count + 2;
+  if (n < 0) n= 0;
+
+  // start marker and frame length
+  // -----------------------------
+  Serial.println();
+  Serial.write('!');
+  Serial.write('B');
+  write_uint16(2 + 2 + 1 + 1 + 1 + (k - 1) + 2 * n);
+
+  // header
+  // ------
+  write_uint16(rs.count);
+  write_uint16(rs.unreliable_count);
+  Serial.write(rs.ref_strength_high);
+  Serial.write(rs.ref_strength_low);
+  // signal strengths obtained during warm-up
+  Serial.write((byte)(k - 1));
+  for (ind= 1; ind < k; ind++) Serial.write(rs.strength[ind]);
+
+  // durations (reliability LSB intact)
+  // ---------
+  sum1= 0;
+  sum2= 0;
+  for (ind= 1; ind <= n; ind++) {
+    write_uint16(rs.duration[ind]);
+    sum1= (sum1 + rs.duration[ind]) % 255;
+    sum2= (sum2 + sum1) % 255;
+  }
+  
+  // checksum
+  // --------
+  write_uint16((sum2 << 8) | sum1);
+  Serial.println();
+}
+
+//*********************************************************************************************************
+
+void write_uint16(unsigned int val)
+{
+  // little endian
+  Serial.write((byte)(val & 0xFF));
+  Serial.write((byte)(val >> 8));
+}
+
+//*********************************************************************************************************
+
+int free_ram()
+{
+  // free RAM between the heap and the stack
+  extern char __heap_start;
+  extern char *__brkval;
+  char top;
+  return (&top - ((__brkval == 0) ? &__heap_start : __brkval));
+}
+
+//*********************************************************************************************************
+
 void blink_led(byte pin, int delay_high, int delay_low, int rep)
 {
   pinMode(pin, OUTPUT);
@@ -388,3 +1175,13 @@ void blink_led(byte pin, int delay_high, int delay_low, int rep)
 }
 
 //*********************************************************************************************************
+
+// ========================================================================================================
+//*********************************************************************************************************
+
+bool stream_consumer(unsigned int duration, byte level) {
+  // *************** //
+  // stream consumer //   rp.stream: classify a recorded value with the learned categories (cf. categorizer.cpp)
+  // *************** //
+  return stream_classifier(duration_category, stream_counters, duration, level);
+}
@@ -14,6 +14,8 @@
   1. Recorder
   2. Categorizer
   3. Categorizer Library
+  4. Codec
+  5. Store
 
   ===============
   = 1. Recorder =
@@ -28,6 +30,8 @@
   1.6 detect end of reception
   1.6.1 process nomal end
   1.6.2 process forced end 
+  1.7 streaming: unwrap the ring
+  1.8 streaming: pass a value to the consumer
 
   TRACE:
   - rs.count is without end-record, it is the index of the last LOW
@@ -42,6 +46,11 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include "radio_lib.h" 
+#include "profiler.h"
+
+#if (COLLISION_MODE == COLLISION_SEPARATE) && (STRENGTH_SAMPLING != SAMPLE_EVERY_SIGNAL)
+#error "the collision separation tags every HIGH by its strength: use SAMPLE_EVERY_SIGNAL"
+#endif
  
 byte recorder(receiver_parameters rp, recorded_signals &rs) 
 {   
@@ -50,9 +59,15 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   // rp       : input  only  :   reception parameters
   // signal   : output only  :   signal durations and strengths (strengths for first WARM_UP signals only)
   // returns  : ret_code    0:   end reached; 1: limit reached; >1: aborted 
-  //                      6-9:   start; 10-13: unreliable; 14: collision/loss (cf. radio_lib.h)
+  //                      6-9:   start; 10-13: unreliable; 14: collision/loss; 17: idle timeout; 18: re-clustering (cf. radio_lib.h)
   // reception start criteria: - after a sufficiently long pause (LONG_PAUSE)
   //                           - followed by a sufficiently strong signal (rp.radio_sensitivity)
+  //                           - rp.radio_module == RM_DUAL: on either radio module, the first one to trigger
+  //                             records the reception (rs.radio_module); CAPTURE_BACKEND with rp.edge_buffer:
+  //                             the edges of the other band are buffered meanwhile, a reception started there is
+  //                             replayed by the next call into the slot of rp.edge_buffer (nominal strengths)
+  //                           - IDLE_MODE == LISTEN_IDLE, no frame pending (rp.idle_limit == INFINITE_PAUSE):
+  //                             the MCU sleeps until the radio detects a signal, the quiet period replaces the long pause
   // reception end   criteria: - sufficiently long pause (duration_low_limit= LONG_PAUSE) OR 
   //                           - number of received signals (rs.count >= rp.max_length) OR 
   //                           - reception aborted (rs.count includes last reliable LOW)
@@ -60,6 +75,18 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   //              if followed by at least three consecutive reliable signals 
   //            - the reception ends (return code RRC_14) if more than three (reliable) consecutive collisions, 
   //              or a signal attenuation/loss is detected (same return code for collision and signal loss)
+  //            - COLLISION_MODE == COLLISION_SEPARATE: the reception goes on, each HIGH after WARM_UP is tagged
+  //              with its strength bucket (rs.transmitter), the categorizer separates the transmitters;
+  //              a signal loss is not detected (the weakened HIGHs are tagged as another transmitter)
+  //            - STRENGTH_SAMPLING == SAMPLE_INTERVAL: after WARM_UP only the sampled signals are checked
+  // streaming: - rp.stream != NULL: each value after WARM_UP is passed to rp.stream (e.g. the stream classifier),
+  //              the buffer is recorded as a ring of rp.max_length values, i.e. the memory is constant
+  //              regardless of the transmission length; the reception ends on a pause, an error, or
+  //              when rp.stream requests a re-clustering (RRC_17)
+  //            - the time spent in rp.stream belongs to the signal in progress (stream_value: lost poll cycles)
+  //            - RRC_17 ends the reception: the caller re-clusters the ring, the next reception starts after the
+  //              next long pause, i.e. the values between the request and that pause are not recorded
+  //            - on return, the ring is unwrapped: rs.duration holds the most recent values, oldest first
 
   // note     : - rs.count is without end-record, it is the index of the last LOW
   //            - end-record is either a pause (x, CEIL) or a zero duration (0, 0) 
@@ -79,27 +106,79 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   int  ind;   
   byte strength_upper_lim;
   byte strength_lower_lim;
+  int  ring_length;                // streaming: number of values in the ring (0: not yet wrapped)
+  unsigned int stream_lost;        // streaming: poll cycles spent in rp.stream
+  unsigned long pause_other;       // RM_DUAL: LOW duration of the other band at the start trigger
+  byte replay_module;              // RM_DUAL: radio module of the replayed reception (0: live reception)
+  bool handed_over;                // RM_DUAL: the other band goes on being captured after this reception
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  unsigned long other_sum;         // sum of the strengths of the HIGHs tagged as other transmitter
+#endif
+#if (OOK_THRESHOLD == TRACKED_THRESHOLD)
+  unsigned int avg_strength_high;  // exponential average of the reliable HIGH strengths (x 2^THRESHOLD_SHIFT)
+  unsigned int avg_strength_low;   // exponential average of the reliable LOW  strengths (x 2^THRESHOLD_SHIFT)
+  byte threshold;                  // current threshold of the radio (REG_OOKFIX)
+  byte next_threshold;
+#endif
  
   // ****************** //
   // 1.1 start receiver //
   // ****************** //
-  // setup SPI for both radio modules and
-  // set the _slaveSelectPin for the active radio 
-  SPI_begin(rp.radio_module);
-  // set frequency 
-  set_frequency(rp.radio_frequency);
-  // set threshold (double of sensitivity in dBm)
-  // +++++++++++++ 
-  strength_high= 2 * rp.radio_sensitivity;
-  set_threshold(strength_high);
-  // set power
-  set_power(MAX_POWER);
-  // set mode RX
-  set_mode(RF69_MODE_RX);
-  delayMicroseconds(100);
+  replay_module= 0;
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+  // RM_DUAL: a reception of the other band has been buffered during the previous one (into rs): replay it
+  if (rp.radio_module == RM_DUAL) replay_module= capture_pending();
+#endif
+  if (replay_module != 0) {
+    // both radio modules are still in RX, the strengths cannot be measured afterwards: nominal strengths
+    rs.radio_module= replay_module;
+    SPI_begin(rs.radio_module);
+    strength_high= rp.radio_sensitivity;
+    strength_schedule(1, rp.radio_sensitivity, 0);
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+    capture_replay();
+#endif
+  } else {
+    // live reception
+    if (rp.radio_module == RM_DUAL) {
+      // dual radio: RM_2 listens as well, RM_1 is configured below
+      SPI_begin(RM_2);
+      set_frequency(rp.radio_frequency_2);
+      set_threshold(2 * rp.radio_sensitivity);
+      set_power(MAX_POWER);
+      set_mode(RF69_MODE_RX);
+      rs.radio_module= RM_1;
+    } else rs.radio_module= rp.radio_module;
+    // setup SPI for both radio modules and
+    // set the _slaveSelectPin for the active radio 
+    SPI_begin(rs.radio_module);
+    // set frequency 
+    set_frequency(rp.radio_frequency);
+    // set threshold (double of sensitivity in dBm)
+    // +++++++++++++ 
+    strength_high= 2 * rp.radio_sensitivity;
+    set_threshold(strength_high);
+    // set power
+    set_power(MAX_POWER);
+    // sample the strength of every signal until the end of WARM_UP 
+    strength_schedule(1, 0, 0);
+    // set mode RX
+    set_mode(RF69_MODE_RX);
+    delayMicroseconds(100);
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+    // start timestamping the DIO2 edges of the active radio (RM_DUAL: once the band is known)
+    if (rp.radio_module != RM_DUAL) capture_begin(rp.radio_module);
+#endif
+  }
   // set number of received signals
   rs.count= 1;  // not zero!
   rs.unreliable_count=  0;
+  ring_length= 0;
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  rs.collision_count= 0;
+  rs.other_strength=  0;
+  other_sum= 0;
+#endif
 
   // ***************************** //
   // 1.2 detect begin of reception //   first HIGH after a LONG_PAUSE
@@ -108,6 +187,66 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   // RRC_0 : duration_low >= LONG_PAUSE, end of Reception
   // RRC_1 : end of HIGH / end of LOW / end of buffer (limit= NV)
   
+  if (replay_module != 0) {
+    // replay: the long pause has been checked by the interrupt, the start signal follows within LONG_PAUSE
+    // ------
+    duration_low_limit= LONG_PAUSE;
+    duration_low= 0;
+    while (RRC_1 != (ret_code= loop_while_low(duration_high, duration_low, strength_high, duration_low_limit))) {  // LOW   <----- 
+      if (ret_code == RRC_0) {
+        // no start signal
+        ret_code= RRC_16;
+        goto EOR;                                                                              // EOR   --->  no start trigger
+      }
+    }
+    goto SOR;                                                                                  // SOR   --->  start of reception
+  }
+
+  if (rp.radio_module == RM_DUAL) {
+    // dual radio: long pause and start signal on either band
+    // ----------
+    rs.radio_module= dual_wait_start(duration_high, strength_high, pause_other, rp.idle_limit);
+    if (rs.radio_module == 0) {
+      // idle timeout (RM_1 is reported)
+      rs.radio_module= RM_1;
+      ret_code= RRC_16;
+      goto EOR;                                                                                // EOR   --->  no start trigger
+    }
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+    capture_begin(rs.radio_module);
+    // the other band goes on being captured into the free slot (replayed after this reception)
+    if (rp.edge_buffer != NULL) {
+      capture_other_begin((rs.radio_module == RM_1) ? RM_2 : RM_1, pause_other, rp.edge_buffer, rp.edge_capacity);
+    }
+#endif
+    goto SOR;                                                                                  // SOR   --->  start of reception
+  }
+
+#if (IDLE_MODE == LISTEN_IDLE)
+  if (rp.idle_limit == INFINITE_PAUSE) {
+    // listen idle: sleep until the radio detects a signal (cf. radio_lib.cpp: 0.7 listen_wait)
+    // -----------  the quiet period before the wake replaces the long pause, the start trigger must follow within LONG_PAUSE
+  #if (RECORDER_BACKEND == CAPTURE_BACKEND)
+    // Timer1 stops in power-down
+    capture_end();
+  #endif
+    duration_low_limit= LONG_PAUSE;
+    while (true) {
+      listen_wait(rp.radio_sensitivity);
+  #if (RECORDER_BACKEND == CAPTURE_BACKEND)
+      capture_begin(rs.radio_module);
+  #endif
+      duration_low= 0;
+      if (RRC_1 == (ret_code= loop_while_low(duration_high, duration_low, strength_high, duration_low_limit))) goto SOR;  // SOR   --->  start of reception
+      // false wake (noise, bouncing): sleep again
+      listen_stats.false_wakes++;
+  #if (RECORDER_BACKEND == CAPTURE_BACKEND)
+      capture_end();
+  #endif
+    }
+  }
+#endif
+
   // wait for a long pause
   // ---------------------
   duration_low_limit= LONG_PAUSE;
@@ -117,10 +256,19 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
 
   // wait for the end of the ongoing long pause == wait for the start signal
   // ------------------------------------------
-  duration_low_limit= INFINITE_PAUSE;
+  // (rp.idle_limit < INFINITE_PAUSE: give up after an idle period, so that the caller can process pending frames)
+  duration_low_limit= rp.idle_limit;
   duration_low= 0;
-  while (RRC_1 != loop_while_low(duration_high, duration_low, strength_high, duration_low_limit));   // LOW   <------------------ 
+  while (RRC_1 != (ret_code= loop_while_low(duration_high, duration_low, strength_high, duration_low_limit))) {  // LOW   <----- 
+    if (ret_code == RRC_0) {
+      // idle timeout
+      ret_code= RRC_16;
+      goto EOR;                                                                                // EOR   --->  no start trigger
+    }
+  }
   // ret_code is equal to RRC_1: the LOW has now ended, the reception start is detected 
+SOR:
+  STAGE_MARK(STAGE_WARM_UP);
   
   // the LOW has ended: strength_high = strength of start trigger (first HIGH)
   // -----------------
@@ -163,6 +311,10 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
       rs.duration[ind++]= (duration_high >> 1) | LSB;
       goto EOR;
     }
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+    // the warm-up signals define the reference transmitter
+    TRANSMITTER_CLEAR(rs.transmitter, ind);
+#endif
     // current HIGH duration = duration_high;
  
     // check edge in front of HIGH
@@ -215,6 +367,7 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   // ****************************************** //
   // 1.4 prepare reception of following signals //
   // ****************************************** //
+  STAGE_MARK(STAGE_RECORDING);
   // initialize consecutive signals counters
   cons_collision_count=  0;  
   cons_unreliable_count= 0;
@@ -223,15 +376,27 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   // !!! WARM_UP >= 8 !!!
   rs.ref_strength_high= (rs.strength[5] + rs.strength[7]) >> 1;
   rs.ref_strength_low=  (rs.strength[6] + rs.strength[8]) >> 1; 
-  /*
-  // set adapted threshold (sensitivity in dBm)
-  // $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$
-  set_threshold(rs.ref_strength_high + rs.ref_strength_low);
-  duration_high+= 25;
-  */
+#if (OOK_THRESHOLD != FIXED_THRESHOLD)
+  // set adapted threshold (midway between the reference strengths)
+  // $$$$$$$$$$$$$$$$$$$$$
+  // the next HIGH is in progress: its duration goes on while the threshold is written
+  // (replay: the nominal strengths say nothing about the radio, its threshold is kept)
+  if (replay_module == 0) set_threshold(rs.ref_strength_high + rs.ref_strength_low);
+  duration_high+= LC_THRESHOLD;
+#endif
+#if (OOK_THRESHOLD == TRACKED_THRESHOLD)
+  threshold= rs.ref_strength_high + rs.ref_strength_low;
+  avg_strength_high= rs.ref_strength_high << THRESHOLD_SHIFT;
+  avg_strength_low=  rs.ref_strength_low  << THRESHOLD_SHIFT;
+#endif
   // set boundaries for collision detection
   strength_upper_lim= rs.ref_strength_high + DELTA_STRENGTH;
   strength_lower_lim= rs.ref_strength_high - DELTA_STRENGTH;
+#if (STRENGTH_SAMPLING == SAMPLE_INTERVAL)
+  // from now on, sample only every STRENGTH_INTERVAL-th strength (collision check), 
+  // the signals in between get the reference strengths, i.e. they are considered as reliable
+  strength_schedule(STRENGTH_INTERVAL, rs.ref_strength_high, rs.ref_strength_low);
+#endif
 
   
   // **************************** //
@@ -249,6 +414,14 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
       rs.duration[ind++]= (duration_high >> 1) | LSB;
       goto EOR;
     }
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+    // strength bucket: the reference transmitter or another one (the unreliable HIGHs included)
+    if ((curr_strength_high > strength_upper_lim) || (curr_strength_high < strength_lower_lim)) {
+      TRANSMITTER_SET(rs.transmitter, ind);
+      rs.collision_count++;
+      other_sum+= curr_strength_high;
+    } else TRANSMITTER_CLEAR(rs.transmitter, ind);
+#endif
     // current HIGH duration = duration_high;
 
     // check edge in front of HIGH
@@ -262,6 +435,7 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
         if (cons_reliable_count < 3) cons_reliable_count++;
 
         cons_unreliable_count= 0;       
+#if (COLLISION_MODE == COLLISION_ABORT)
         // collision detection
         if ((curr_strength_high > strength_upper_lim) || (curr_strength_high < strength_lower_lim)) {
           if (++cons_collision_count > 3) {
@@ -272,6 +446,7 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
         } else {
             cons_collision_count= 0;        
         }
+#endif
     } else {
       // mark HIGH "unreliabel" (set least significant bit)
       rs.duration[ind++]= (duration_high >> 1) | LSB;  
@@ -290,6 +465,15 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
         goto EOR;
       }     
     }
+    if (rp.stream != NULL) {
+      // streaming: the LOW is in progress
+      if (stream_value(rp, rs.duration[ind - 1], HIGH, stream_lost)) {
+        // re-clustering requested
+        ret_code= RRC_17;
+        goto EOR;
+      }
+      duration_low+= stream_lost;
+    }
    
     // even indices: LOW
     // =================
@@ -302,10 +486,20 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
         // 1.6.1 process nomal end //
         // *********************** //
         // the last LOW is sufficiently long: duration_low == PAUSE
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+        // (replay: stop the edges first, they are buffered in rs.duration;
+        //  RM_DUAL: a reception of the other band that started meanwhile goes on being captured)
+        if ((replay_module != 0) || !capture_hand_over(rs.radio_module)) capture_end();
+#endif
 
         rs.duration[ind++]= (duration_low >> 1) & MSB;
         // cut the ending pause
         rs.count= ind - 2;       
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+        if (rs.collision_count > 0) rs.other_strength= other_sum / rs.collision_count;
+#endif
+        if (ring_length > 0) ring_unwrap(rs, ind, ring_length);
+        STAGE_MARK(STAGE_NONE);
         // set active radio to standby
         set_mode(RF69_MODE_STANDBY);
         SPI.end(); 
@@ -326,6 +520,19 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
         rs.count= ind;
         if (cons_reliable_count < 3) cons_reliable_count++;
         cons_unreliable_count= 0;
+#if (OOK_THRESHOLD == TRACKED_THRESHOLD)
+        // track the threshold (both edges of the LOW are reliable)
+        // $$$$$$$$$$$$$$$$$$$
+        avg_strength_high+= curr_strength_high - (avg_strength_high >> THRESHOLD_SHIFT);
+        avg_strength_low+=  strength_low       - (avg_strength_low  >> THRESHOLD_SHIFT);
+        next_threshold= (avg_strength_high + avg_strength_low) >> THRESHOLD_SHIFT;
+        if (abs(next_threshold - threshold) >= THRESHOLD_HYSTERESIS) {
+          // the next HIGH is in progress
+          threshold= next_threshold;
+          if (replay_module == 0) set_threshold(threshold);
+          duration_high+= LC_THRESHOLD;
+        }
+#endif
     } else {
       // mark LOW "unreliabel" (set least significant bit)
       rs.duration[ind++]= (duration_low >> 1) | LSB;  
@@ -344,6 +551,20 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
         goto EOR;
       }     
     } 
+    if (rp.stream != NULL) {
+      // streaming: the next HIGH is in progress
+      if (stream_value(rp, rs.duration[ind - 1], LOW, stream_lost)) {
+        // re-clustering requested
+        ret_code= RRC_17;
+        goto EOR;
+      }
+      duration_high+= stream_lost;
+    }
+    if ((rp.stream != NULL) && (ind >= rp.max_length)) {
+      // streaming: continue at the begin of the buffer (ring)
+      ring_length= ind - 1;
+      ind= 1;
+    }
   } while (ind < rp.max_length);
   // end of Buffer (NV) or limitation (option)
   ret_code= RRC_1;
@@ -355,11 +576,90 @@ byte recorder(receiver_parameters rp, recorded_signals &rs)
   // - the reception limit is reached or
   // - the reception was aborted
 EOR:
+  handed_over= false;
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+  // (replay: stop the edges first, they are buffered in rs.duration)
+  if (replay_module != 0) capture_end();
+  else if ((rp.radio_module != RM_DUAL) || (ret_code != RRC_16)) {
+    // RM_DUAL: a reception of the other band that started meanwhile goes on being captured
+    handed_over= capture_hand_over(rs.radio_module);
+    if (!handed_over) capture_end();
+  }
+#endif
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  if (rs.collision_count > 0) rs.other_strength= other_sum / rs.collision_count;
+#endif
+  if (ring_length > 0) ring_unwrap(rs, ind, ring_length);
   // add two zeros, similar as pause: (0, CEIL)
   rs.duration[rs.count]= rs.duration[rs.count+1]= 0;
+  STAGE_MARK(STAGE_NONE);
   // set active radio to standby
   set_mode(RF69_MODE_STANDBY);
+  if ((rp.radio_module == RM_DUAL) && !handed_over) {
+    // and the other one
+    select_radio((rs.radio_module == RM_1) ? RM_2 : RM_1);
+    set_mode(RF69_MODE_STANDBY);
+    select_radio(rs.radio_module);
+  }
   SPI.end();
   rs.count--;
   return ret_code;  
 }
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void ring_unwrap(recorded_signals &rs, int ind, int ring_length) 
+{
+  // ****************************** //
+  // 1.7 streaming: unwrap the ring //   the oldest value moves to index 1, the most recent one to ring_length
+  // ****************************** //
+  // ind        : next write position (the oldest value, if ind <= ring_length)
+  //              even after an abort on HIGH: the oldest LOW follows the most recent HIGH, but lies behind rs.count
+  // ring_length: even, the rotation is even: HIGH-/LOW- parity is preserved
+  // rs.count is moved along with the values, rs.unreliable_count is recounted
+  // COLLISION_SEPARATE: the separation is given up (rs.collision_count= 0)
+  int rot;    // left rotation
+  int i, j;
+  unsigned int val;
+
+  rot= (ind & ~1) % ring_length;
+  if (rs.count <= ind) rs.count+= ring_length - rot;
+  else rs.count-= rot;
+  if (rot > 0) {
+    // rotation by three reversals: [1 .. rot], [rot+1 .. ring_length], [1 .. ring_length]
+    for (i= 1, j= rot; i < j; i++, j--) {val= rs.duration[i]; rs.duration[i]= rs.duration[j]; rs.duration[j]= val;}
+    for (i= rot + 1, j= ring_length; i < j; i++, j--) {val= rs.duration[i]; rs.duration[i]= rs.duration[j]; rs.duration[j]= val;}
+    for (i= 1, j= ring_length; i < j; i++, j--) {val= rs.duration[i]; rs.duration[i]= rs.duration[j]; rs.duration[j]= val;}
+  }
+  rs.unreliable_count= 0;
+  for (i= 1; i < rs.count; i++) rs.unreliable_count+= rs.duration[i] & LSB;
+#if (COLLISION_MODE == COLLISION_SEPARATE)
+  // the transmitter tags are not rotated: the unwrapped trace is categorized as one sequence
+  rs.collision_count= 0;
+#endif
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+bool stream_value(const receiver_parameters &rp, unsigned int val, byte level, unsigned int &lost)
+{
+  // ******************************************* //
+  // 1.8 streaming: pass a value to the consumer //   returns true, if rp.stream requests a re-clustering
+  // ******************************************* //
+  // val  : flagged value (as recorded)
+  // lost : poll cycles spent in rp.stream, to be added to the signal in progress
+  //        (CAPTURE_BACKEND: 0, the edges are timestamped meanwhile)
+  bool stop;
+#if (RECORDER_BACKEND == CAPTURE_BACKEND)
+  stop= rp.stream(val, level);
+  lost= 0;
+#else
+  unsigned long t= micros();
+  stop= rp.stream(val, level);
+  // 1 poll cycle ~ 0.5 us (cf. strength_calibrate), micros() has a resolution of 4 us
+  t= micros() - t;
+  // (a consumer blocking for more than 16 ms: the signal in progress overflows)
+  lost= (t < 0x4000) ? 2 * t : 0x7FFF;
+#endif
+  return stop;
+}
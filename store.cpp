@@ -0,0 +1,292 @@
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "radio_lib.h"
+#include "categorizer.h"
+#include "store.h"
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  ============
+  = 5. Store =  persistent receiver state in the EEPROM (STORE_MODE == EEPROM_STORE)
+  ============
+
+  5.1 store_begin: check the layout (otherwise format), load the counters and the profiles
+  5.2 store_get_parameters / store_put_parameters: the reception and categorizer parameters
+  5.3 store_count: count a processed reception of a channel (RAM copy)
+  5.4 store_flush: write the counters and the changed profiles, at most every STORE_PERIOD
+  5.5 Helper
+  5.5.1 store_read : read a record, check its checksum
+  5.5.2 store_write: write a record and its checksum (changed bytes only)
+
+EEPROM Layout
+=============
+Each record is followed by its Fletcher16 checksum (uint16). A checksum byte is at most 254,
+hence 0xFFFF (erased or formatted) never matches: the record is invalid.
+- header     : magic, format and size of the layout (another layout, e.g. other NK or NC: format)
+- parameters : store_parameters
+- counters   : STORE_RING x store_counters, in rotation (the valid record with the highest sequence is current)
+- profiles   : NK x cache_entry (CATEGORY_CACHING == CATEGORY_CACHE)
+
+Wear
+====
+The EEPROM bytes endure ~ 100000 writes, a write takes 3.3 ms per byte.
+- EEPROM.update writes the changed bytes only: the parameters of an unchanged boot cost no write
+- the counters are counted in RAM and flushed at most every STORE_PERIOD (and once per boot),
+  each flush writes the next record of the ring: ~ 100 / STORE_RING writes of a byte per day
+- a profile is written only when its signature changes (channel key, number of clusters, rounded centers),
+  i.e. a new device, not at each repeated transmission
+power loss: the counters since the previous flush are lost, an interrupted write invalidates one record
+*/
+
+#if (STORE_MODE == EEPROM_STORE)
+
+typedef struct {
+  uint16_t magic;                 // STORE_MAGIC
+  uint16_t format;                // STORE_FORMAT
+  uint16_t size;                  // STORE_END
+} store_header;
+
+// addresses of the records (each followed by its checksum)
+#define STORE_HEADER_ADDR      0
+#define STORE_PARAMETER_ADDR   (STORE_HEADER_ADDR + sizeof(store_header) + 2)
+#define STORE_COUNTER_ADDR(r)  (STORE_PARAMETER_ADDR + sizeof(store_parameters) + 2 + (r) * (sizeof(store_counters) + 2))
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  #define STORE_PROFILES       NK
+#else
+  #define STORE_PROFILES       0
+#endif
+#define STORE_PROFILE_ADDR(k)  (STORE_COUNTER_ADDR(STORE_RING) + (k) * (sizeof(cache_entry) + 2))
+#define STORE_END              STORE_PROFILE_ADDR(STORE_PROFILES)
+
+store_counters stored_counters;   // RAM copy of the current counter record
+uint8_t        store_ring;        // ring index of the current counter record
+bool           store_dirty;       // counted since the previous flush
+unsigned long  store_millis;      // time of the previous flush
+
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+bool same_profile (              //     returns true, if both entries have the same signature (cf. categorizer.cpp: same_signature)
+  const cache_entry &a,          // I   cache entry
+  const cache_entry &b           // I   stored profile
+) {
+  uint8_t level;                 // HIGH / LOW
+  uint8_t c_ind;                 // index of cluster
+
+  if (a.key != b.key) return (false);
+  for (level= LOW; level <= HIGH; level++) {
+    if (a.level[level].cluster_size != b.level[level].cluster_size) return (false);
+    for (c_ind= 0; c_ind < a.level[level].cluster_size; c_ind++) {
+      if ((a.level[level].cluster_center[c_ind] >> CACHE_ROUNDING) != (b.level[level].cluster_center[c_ind] >> CACHE_ROUNDING)) return (false);
+    }
+  }
+  return (true);
+}
+#endif
+
+uint8_t store_begin () {       // returns STORE_VALID, STORE_FORMATTED, or STORE_TOO_SMALL (nothing read or written)
+  // *********** //
+  // store_begin //   5.1 check the layout, load the counters and seed the category cache
+  // *********** //
+  store_header   h;            // layout header
+  store_counters c;            // counter record of the ring
+  uint16_t       address;
+  uint8_t        r_ind;        // index of the counter ring
+  bool           valid;        // the layout is valid
+  bool           found;        // a valid counter record was found
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  uint8_t        k_ind;        // index of category_cache
+#endif
+
+  memset(&stored_counters, 0, sizeof(stored_counters));
+  store_ring= STORE_RING - 1;
+  store_millis= millis();
+  if (STORE_END > EEPROM.length()) return (STORE_TOO_SMALL);
+
+  // header
+  valid= store_read(STORE_HEADER_ADDR, &h, sizeof(h));
+  valid= valid && (h.magic == STORE_MAGIC) && (h.format == STORE_FORMAT) && (h.size == STORE_END);
+  if (!valid) {
+    // format: invalidate all records (checksum 0xFFFF), then write the header
+    for (address= STORE_HEADER_ADDR + sizeof(store_header); address < STORE_PARAMETER_ADDR; address++) EEPROM.update(address, 0xFF);
+    for (address= STORE_PARAMETER_ADDR + sizeof(store_parameters); address < STORE_COUNTER_ADDR(0); address++) EEPROM.update(address, 0xFF);
+    for (r_ind= 0; r_ind < STORE_RING; r_ind++) {
+      for (address= STORE_COUNTER_ADDR(r_ind) + sizeof(store_counters); address < STORE_COUNTER_ADDR(r_ind + 1); address++) EEPROM.update(address, 0xFF);
+    }
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+    for (k_ind= 0; k_ind < STORE_PROFILES; k_ind++) {
+      for (address= STORE_PROFILE_ADDR(k_ind) + sizeof(cache_entry); address < STORE_PROFILE_ADDR(k_ind + 1); address++) EEPROM.update(address, 0xFF);
+    }
+#endif
+    h.magic=  STORE_MAGIC;
+    h.format= STORE_FORMAT;
+    h.size=   STORE_END;
+    store_write(STORE_HEADER_ADDR, &h, sizeof(h));
+  }
+
+  // counters: the valid record with the highest sequence (modulo 2 ** 16)
+  found= false;
+  for (r_ind= 0; valid && (r_ind < STORE_RING); r_ind++) {
+    if (!store_read(STORE_COUNTER_ADDR(r_ind), &c, sizeof(c))) continue;
+    if (found && ((int16_t)(c.sequence - stored_counters.sequence) <= 0)) continue;
+    stored_counters= c;
+    store_ring= r_ind;
+    found= true;
+  }
+  stored_counters.boot_count++;
+  store_dirty= true;
+
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  // profiles: seed the category cache
+  for (k_ind= 0; valid && (k_ind < STORE_PROFILES); k_ind++) {
+    if (store_read(STORE_PROFILE_ADDR(k_ind), &category_cache[k_ind], sizeof(cache_entry))) category_cache[k_ind].age= 0;
+    else memset(&category_cache[k_ind], 0, sizeof(cache_entry));
+  }
+#endif
+  return (valid ? STORE_VALID : STORE_FORMATTED);
+} // end store_begin
+
+// ********************************************************************************************************
+
+bool store_get_parameters (        // returns true, if the stored parameters are valid
+  store_parameters &p              // O   stored parameters
+) {
+  // ******************** //
+  // store_get_parameters //   5.2 the parameters entered at the previous boot
+  // ******************** //
+  if (STORE_END > EEPROM.length()) return (false);
+  return (store_read(STORE_PARAMETER_ADDR, &p, sizeof(p)));
+}
+
+void store_put_parameters (        //
+  const store_parameters &p        // I   parameters of this boot
+) {
+  // ******************** //
+  // store_put_parameters //   5.2 unchanged parameters are not written again (EEPROM.update)
+  // ******************** //
+  if (STORE_END > EEPROM.length()) return;
+  store_write(STORE_PARAMETER_ADDR, &p, sizeof(p));
+}
+
+// ********************************************************************************************************
+
+void store_count (                 //
+  long     frequency,              // I   channel of the processed reception (FRQ units)
+  bool     categorized,            // I   categorizer return code CRC_0
+  uint16_t noise                   // I   start triggers since the previous processed reception of the channel
+) {
+  // *********** //
+  // store_count //   5.3 count in the RAM copy (written by store_flush)
+  // *********** //
+  uint8_t ch_ind;                  // index of the channel
+  uint8_t e_ind;                   // index of the least received channel
+
+  e_ind= 0;
+  for (ch_ind= 0; ch_ind < STORE_CHANNELS; ch_ind++) {
+    if (stored_counters.channel[ch_ind].frequency == frequency) break;
+    if (stored_counters.channel[ch_ind].reception_count < stored_counters.channel[e_ind].reception_count) e_ind= ch_ind;
+  }
+  if (ch_ind == STORE_CHANNELS) {
+    // new channel: replace the least received one
+    ch_ind= e_ind;
+    memset(&stored_counters.channel[ch_ind], 0, sizeof(channel_counters));
+    stored_counters.channel[ch_ind].frequency= frequency;
+  }
+  stored_counters.channel[ch_ind].reception_count++;
+  if (categorized) stored_counters.channel[ch_ind].category_count++;
+  stored_counters.channel[ch_ind].noise_count+= noise;
+  store_dirty= true;
+}
+
+// ********************************************************************************************************
+
+void store_flush (                 //
+  bool force                       // I   flush without waiting for STORE_PERIOD (e.g. at boot)
+) {
+  // *********** //
+  // store_flush //   5.4 write the counters to the next record of the ring, and the changed profiles
+  // *********** //
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  cache_entry e;                   // stored profile
+  uint8_t     k_ind;               // index of category_cache
+#endif
+
+  if (STORE_END > EEPROM.length()) return;
+  if (!force && (millis() - store_millis < STORE_PERIOD)) return;
+  store_millis= millis();
+  if (store_dirty) {
+    stored_counters.sequence++;
+    store_ring= (store_ring + 1) % STORE_RING;
+    store_write(STORE_COUNTER_ADDR(store_ring), &stored_counters, sizeof(stored_counters));
+    store_dirty= false;
+  }
+#if (CATEGORY_CACHING == CATEGORY_CACHE)
+  for (k_ind= 0; k_ind < STORE_PROFILES; k_ind++) {
+    if (category_cache[k_ind].level[HIGH].cluster_size == 0) continue;
+    if (store_read(STORE_PROFILE_ADDR(k_ind), &e, sizeof(e)) && same_profile(category_cache[k_ind], e)) continue;
+    store_write(STORE_PROFILE_ADDR(k_ind), &category_cache[k_ind], sizeof(cache_entry));
+  }
+#endif
+}
+
+// ********************************************************************************************************
+
+bool store_read (                  // returns true, if the checksum of the record matches
+  uint16_t address,                // I   address of the record
+  void    *data,                   // O   record
+  uint16_t size                    // I   size of the record [bytes]
+) {
+  // ********** //
+  // store_read //   5.5.1 the record, then its checksum
+  // ********** //
+  uint8_t *d= (uint8_t *)data;
+  uint16_t sum1, sum2;             // Fletcher16 Checksum (cf. categorizer_lib.cpp)
+  uint16_t ind;
+
+  sum1= 0;
+  sum2= 0;
+  for (ind= 0; ind < size; ind++) {
+    d[ind]= EEPROM.read(address + ind);
+    sum1= (sum1 + d[ind]) % 255;
+    sum2= (sum2 + sum1) % 255;
+  }
+  return ((EEPROM.read(address + size) == sum1) && (EEPROM.read(address + size + 1) == sum2));
+}
+
+void store_write (                 //
+  uint16_t    address,             // I   address of the record
+  const void *data,                // I   record
+  uint16_t    size                 // I   size of the record [bytes]
+) {
+  // *********** //
+  // store_write //   5.5.2 the record, then its checksum: an interrupted write leaves an invalid record
+  // *********** //
+  const uint8_t *d= (const uint8_t *)data;
+  uint16_t sum1, sum2;             // Fletcher16 Checksum (cf. categorizer_lib.cpp)
+  uint16_t ind;
+
+  sum1= 0;
+  sum2= 0;
+  for (ind= 0; ind < size; ind++) {
+    EEPROM.update(address + ind, d[ind]);
+    sum1= (sum1 + d[ind]) % 255;
+    sum2= (sum2 + sum1) % 255;
+  }
+  EEPROM.update(address + size, sum1);
+  EEPROM.update(address + size + 1, sum2);
+}
+
+#endif
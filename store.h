@@ -0,0 +1,82 @@
+/*
+  Copyright Felix Baessler, felix.baessler@gmail.com
+  This software is released under CC-BY-NC 4.0.
+  The licensing TLDR; is: You are free to use, copy, distribute and transmit this Software for personal,
+  non-commercial purposes, as long as you give attribution and share any modifications under the same license.
+  Commercial or for-profit use requires a license.
+  SEE FULL LICENSE DETAILS HERE: https://creativecommons.org/licenses/by-nc/4.0/
+
+  OOK Raw Data Receiver
+  0. Radio Library
+  1. Recorder
+  2. Categorizer
+  3. Categorizer Library
+  4. Codec
+  5. Store
+
+  =====================
+  = Store (Interface) =  persistent receiver state in the EEPROM (cf. store.cpp)
+  =====================
+  (include radio_lib.h and categorizer.h first)
+
+  STORE_MODE == EEPROM_STORE: the receiver boots with the state of its previous run
+  - parameters: the last entered reception and categorizer parameters (setup skips the parameter wait)
+  - counters  : per channel the processed receptions, the categorized receptions and the noise
+                (the accumulated recorder return codes), since the store was formatted
+  - profiles  : the category cache entries (CATEGORY_CACHING == CATEGORY_CACHE), seeding the cache at boot
+  Each record carries a Fletcher16 checksum: an interrupted write invalidates this record only.
+*/
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// store
+#define NO_STORE           0    // the state is lost at each reboot (parameters: 3 s wait in setup)
+#define EEPROM_STORE       1    // the state is kept in the EEPROM (ATmega328P: 1024 bytes, ~ 100000 writes per byte)
+#define STORE_MODE         NO_STORE
+#define STORE_MAGIC   0x4F53    // layout header: "SO" (STORE_FORMAT: layout version)
+#define STORE_FORMAT       1
+#define STORE_CHANNELS     4    // counted channels (frequencies), the least received one is replaced
+#define STORE_RING         4    // counter records in rotation: the writes of a flush move to the next record
+#define STORE_PERIOD  900000UL  // minimal time between two flushes [ms] (15 min): ~ 100 writes per day
+// store_begin return codes
+#define STORE_VALID        0    // the layout is valid: counters and profiles loaded
+#define STORE_FORMATTED    1    // no valid layout (first boot, other layout): the EEPROM has been formatted
+#define STORE_TOO_SMALL    2    // the layout exceeds EEPROM.length(): the store is disabled, nothing written
+
+typedef struct {
+  // reception and categorizer parameters (cf. receiver.ino: setup)
+  uint8_t  output_option;
+  uint8_t  radio_module;
+  long     radio_frequency;       // FRQ units
+  long     radio_frequency_2;     // FRQ units
+  uint8_t  radio_sensitivity;
+  int      max_length;
+  int      min_length;            // rp_min_length
+  long     serial_baud;
+  categorizer_parameters cp;      // PARAMETER_MODE == TUNABLE_PARAMETERS (FIXED_PARAMETERS: stored, not read)
+} store_parameters;
+
+typedef struct {
+  // counters of one channel
+  long     frequency;             // FRQ units (0: empty entry)
+  uint32_t reception_count;       // processed receptions
+  uint32_t category_count;        // of which categorized (CRC_0)
+  uint32_t noise_count;           // start triggers that did not lead to a processed reception (acc_err)
+} channel_counters;
+
+typedef struct {
+  // counter record: the RAM copy is updated per processing, written every STORE_PERIOD (store_flush)
+  uint16_t sequence;              // number of the flush: the valid record with the highest sequence is the current one
+  uint16_t boot_count;            // number of boots
+  channel_counters channel[STORE_CHANNELS];
+} store_counters;
+
+extern store_counters stored_counters;   // RAM copy of the current counter record (cf. store_count)
+
+uint8_t store_begin       ();                                 // STORE_VALID, STORE_FORMATTED or STORE_TOO_SMALL
+bool store_get_parameters (store_parameters &p);              // true: valid stored parameters
+void store_put_parameters (const store_parameters &p);
+void store_count          (long frequency, bool categorized, uint16_t noise);
+void store_flush          (bool force);                       // counters and profiles, at most every STORE_PERIOD
+    bool store_read       (uint16_t address, void *data, uint16_t size);
+    void store_write      (uint16_t address, const void *data, uint16_t size);